@@ -0,0 +1,66 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ChangeFileGenerator.h"
+#include "config/ExitCode.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Generates a synthetic osm change file for benchmarks.
+//
+// Usage: olu-generate-changes <output> <number of objects> [seed] [mix]
+//
+// The output is compressed with gzip if it ends with `.gz`. The mix is given as comma separated
+// weights for node moves, tag edits, way rewires, multipolygon edits and deletes, for example
+// `0.35,0.25,0.2,0.05,0.15`.
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output> <number of objects> [seed] [mix]"
+                  << std::endl;
+        std::exit(olu::config::ExitCode::ARGUMENT_MISSING);
+    }
+
+    try {
+        const std::size_t numObjects = std::stoul(argv[2]);
+        const unsigned int seed = argc > 3 ? std::stoul(argv[3]) : 42;
+
+        olu::util::ChangeFileMix mix;
+        if (argc > 4) {
+            std::istringstream weights(argv[4]);
+            std::string weight;
+            for (double *value : {&mix.nodeMoves, &mix.tagEdits, &mix.wayRewires,
+                                  &mix.multipolygonEdits, &mix.deletes}) {
+                if (!std::getline(weights, weight, ',')) {
+                    std::cerr << "The mix needs five comma separated weights" << std::endl;
+                    std::exit(olu::config::ExitCode::INCORRECT_ARGUMENTS);
+                }
+                *value = std::stod(weight);
+            }
+        }
+
+        olu::util::ChangeFileGenerator generator(numObjects, mix, seed);
+        olu::util::ChangeFileGenerator::write(generator.generate(), argv[1]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        std::exit(olu::config::ExitCode::EXCEPTION);
+    }
+
+    std::exit(olu::config::ExitCode::SUCCESS);
+}
@@ -0,0 +1,70 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ReplayServer.h"
+#include "util/RequestRecording.h"
+#include "config/ExitCode.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+
+static std::atomic<bool> stopRequested = false;
+
+// _________________________________________________________________________________________________
+static void handleSignal(int) {
+    stopRequested = true;
+}
+
+// Replays a recording created with `olu --record-requests <file>` on the loopback interface, so
+// that `olu` and the benchmarks can be run against it instead of a live SPARQL endpoint.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <recording> [port] [latency in ms]" << std::endl;
+        std::exit(olu::config::ExitCode::ARGUMENT_MISSING);
+    }
+
+    try {
+        const unsigned short port = argc > 2 ? std::stoi(argv[2]) : 7007;
+        const std::chrono::milliseconds latency(argc > 3 ? std::stol(argv[3]) : 0);
+
+        const auto exchanges = olu::util::RequestRecording::load(argv[1]);
+        olu::util::ReplayServer server(exchanges, latency, port);
+        server.start();
+
+        std::cerr << "Replaying " << exchanges.size() << " recorded requests at "
+                  << server.getUri() << std::endl;
+
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+        while (!stopRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        server.stop();
+        std::cerr << "Answered " << server.getRequestCount() << " requests" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        std::exit(olu::config::ExitCode::EXCEPTION);
+    }
+
+    std::exit(olu::config::ExitCode::SUCCESS);
+}
@@ -0,0 +1,96 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_BENCHMARKDATA_H
+#define OSM_LIVE_UPDATES_BENCHMARKDATA_H
+
+#include "util/Types.h"
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace olu::benchmarks {
+
+    // Number of ids or triples in a single SPARQL query, see `MAX_VALUES_PER_QUERY`
+    static inline constexpr std::size_t BATCH_SIZE = 1024;
+
+    /**
+     * @return A set of `count` osm ids in the range of current osm ids
+     */
+    inline std::set<id_t> makeIdBatch(const std::size_t count = BATCH_SIZE) {
+        std::set<id_t> ids;
+        for (std::size_t i = 0; i < count; ++i) {
+            ids.insert(static_cast<id_t>(1000000000 + i * 7919));
+        }
+        return ids;
+    }
+
+    /**
+     * @return A WKT linestring with the given number of points, as osm2rdf writes it for the
+     * geometry of large ways and relations. Each point takes 19 characters, so 100000 points are
+     * about 1.9 MB.
+     */
+    inline std::string makeWktLineString(const std::size_t numPoints) {
+        std::string wkt = "\"LINESTRING(";
+        // "7.800000 48.000000," has 19 characters
+        wkt.reserve(numPoints * 19 + 32);
+        for (std::size_t i = 0; i < numPoints; ++i) {
+            if (i > 0) { wkt += ","; }
+            wkt += std::to_string(7.8 + static_cast<double>(i % 1000) / 1000.0);
+            wkt += " ";
+            wkt += std::to_string(48.0 + static_cast<double>(i / 1000) / 1000.0);
+        }
+        wkt += ")\"^^geo:wktLiteral";
+        return wkt;
+    }
+
+    /**
+     * @return `count` triples in the form they are passed to `QueryWriter::writeInsertQuery`
+     */
+    inline std::vector<std::string> makeInsertTriples(const std::size_t count = BATCH_SIZE) {
+        std::vector<std::string> triples;
+        triples.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto id = std::to_string(1000000000 + i * 7919);
+            switch (i % 4) {
+                case 0:
+                    triples.emplace_back("osmnode:" + id + " osmkey:name \"Caf\\u00e9 & Bar "
+                                         + id + "\"");
+                    break;
+                case 1:
+                    triples.emplace_back("osmnode:" + id + " osmmeta:timestamp "
+                                         "\"2024-08-02T10:00:33\"^^xsd:dateTime");
+                    break;
+                case 2:
+                    triples.emplace_back("osmnode:" + id + " geo:hasGeometry osm2rdfgeom:osm_node_"
+                                         + id);
+                    break;
+                default:
+                    triples.emplace_back("osm2rdfgeom:osm_node_" + id + " geo:asWKT "
+                                         "\"POINT(7.8412345 47.9912345)\"^^geo:wktLiteral");
+                    break;
+            }
+        }
+        return triples;
+    }
+
+} // namespace olu::benchmarks
+
+#endif //OSM_LIVE_UPDATES_BENCHMARKDATA_H
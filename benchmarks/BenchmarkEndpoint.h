@@ -0,0 +1,66 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_BENCHMARKENDPOINT_H
+#define OSM_LIVE_UPDATES_BENCHMARKENDPOINT_H
+
+#include "util/ReplayServer.h"
+#include "util/RequestRecording.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace olu::benchmarks {
+
+    /**
+     * Returns the uri of the SPARQL endpoint the benchmarks are run against.
+     *
+     * If the environment variable `OLU_BENCHMARK_ENDPOINT` is set, its value is used, so that the
+     * benchmarks can still be run against a live endpoint. Otherwise, a local `ReplayServer` is
+     * started that replays the recording given in `OLU_BENCHMARK_RECORDING` (or only answers with
+     * empty results if there is none) with a latency of `OLU_BENCHMARK_LATENCY_MS` milliseconds.
+     */
+    inline std::string getBenchmarkEndpoint() {
+        if (const char* endpoint = std::getenv("OLU_BENCHMARK_ENDPOINT")) {
+            return endpoint;
+        }
+
+        static const std::unique_ptr<util::ReplayServer> server = []() {
+            std::vector<util::RecordedExchange> exchanges;
+            if (const char* recording = std::getenv("OLU_BENCHMARK_RECORDING")) {
+                exchanges = util::RequestRecording::load(recording);
+            }
+
+            std::chrono::milliseconds latency(0);
+            if (const char* latencyMs = std::getenv("OLU_BENCHMARK_LATENCY_MS")) {
+                latency = std::chrono::milliseconds(std::stol(latencyMs));
+            }
+
+            auto replayServer = std::make_unique<util::ReplayServer>(exchanges, latency);
+            replayServer->start();
+            return replayServer;
+        }();
+
+        return server->getUri();
+    }
+
+} // namespace olu::benchmarks
+
+#endif //OSM_LIVE_UPDATES_BENCHMARKENDPOINT_H
@@ -16,14 +16,142 @@
 // You should have received a copy of the GNU General Public License
 // along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
 
-#include <iostream>
 #include "osm/Osm2ttl.h"
+#include "osm/OsmChangeHandler.h"
+#include "config/Constants.h"
 
 #include "benchmark/benchmark.h"
 
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+
+namespace cnst = olu::config::constants;
+
+// ---------------------------------------------------------------------------
+// Writes the temporary node, way and relation files with the given number of nodes. There is one
+// way for every ten nodes and one multipolygon relation for every ten ways. Returns the total
+// number of objects.
+static std::size_t Write_Input_Files(const std::size_t numNodes) {
+    std::filesystem::create_directories(cnst::PATH_TO_TEMP_DIR);
+    const std::string attributes =
+        R"(version="2" timestamp="2024-08-02T10:00:33Z" uid="1" user="olu" changeset="1")";
+
+    std::ofstream nodeFile(cnst::PATH_TO_NODE_FILE, std::ios::trunc);
+    nodeFile << "<osm version=\"0.6\">\n";
+    for (std::size_t id = 1; id <= numNodes; ++id) {
+        nodeFile << "<node id=\"" << id << "\" " << attributes
+                 << " lat=\"" << 48.0 + static_cast<double>(id % 1000) / 1000.0
+                 << "\" lon=\"" << 7.8 + static_cast<double>(id / 1000) / 1000.0 << "\">";
+        if (id % 5 == 0) {
+            nodeFile << "<tag k=\"amenity\" v=\"bench\"/>";
+        }
+        nodeFile << "</node>\n";
+    }
+    nodeFile << "</osm>\n";
+
+    // Each way is a closed ring over ten consecutive nodes
+    const std::size_t numWays = numNodes / 10;
+    std::ofstream wayFile(cnst::PATH_TO_WAY_FILE, std::ios::trunc);
+    wayFile << "<osm version=\"0.6\">\n";
+    for (std::size_t id = 1; id <= numWays; ++id) {
+        wayFile << "<way id=\"" << id << "\" " << attributes << ">";
+        for (std::size_t node = (id - 1) * 10 + 1; node <= id * 10; ++node) {
+            wayFile << "<nd ref=\"" << node << "\"/>";
+        }
+        wayFile << "<nd ref=\"" << (id - 1) * 10 + 1 << "\"/>";
+        wayFile << "<tag k=\"building\" v=\"yes\"/></way>\n";
+    }
+    wayFile << "</osm>\n";
+
+    const std::size_t numRelations = numWays / 10;
+    std::ofstream relationFile(cnst::PATH_TO_RELATION_FILE, std::ios::trunc);
+    relationFile << "<osm version=\"0.6\">\n";
+    for (std::size_t id = 1; id <= numRelations; ++id) {
+        relationFile << "<relation id=\"" << id << "\" " << attributes << ">"
+                     << "<member type=\"way\" ref=\"" << (id - 1) * 10 + 1
+                     << "\" role=\"outer\"/>"
+                     << "<tag k=\"type\" v=\"multipolygon\"/>"
+                     << "<tag k=\"landuse\" v=\"grass\"/></relation>\n";
+    }
+    relationFile << "</osm>\n";
+
+    return numNodes + numWays + numRelations;
+}
+
+// ---------------------------------------------------------------------------
+static std::set<olu::id_t> Ids_Up_To(const std::size_t count) {
+    std::set<olu::id_t> ids;
+    for (std::size_t id = 1; id <= count; ++id) {
+        ids.insert(static_cast<olu::id_t>(id));
+    }
+    return ids;
+}
+
+// ---------------------------------------------------------------------------
+static std::size_t Count_Triples(const std::string &path) {
+    std::ifstream file(path);
+    std::size_t triples = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && !line.starts_with("@")) {
+            ++triples;
+        }
+    }
+    return triples;
+}
+
+// ---------------------------------------------------------------------------
+static void Sort_Input_Files(benchmark::State& state) {
+    const auto objects = Write_Input_Files(state.range(0));
+
+    for (auto _ : state) {
+        olu::osm::Osm2ttl::writeToInputFile();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(objects));
+}
+BENCHMARK(Sort_Input_Files)->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
 // ---------------------------------------------------------------------------
 static void Convert(benchmark::State& state) {
+    const auto objects = Write_Input_Files(state.range(0));
+    olu::osm::Osm2ttl::writeToInputFile();
 
+    for (auto _ : state) {
+        olu::osm::Osm2ttl::convertInputFile();
+    }
+
+    const auto triples = Count_Triples(cnst::PATH_TO_OUTPUT_FILE);
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(objects));
+    state.counters["triples/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * triples), benchmark::Counter::kIsRate);
 }
-BENCHMARK(Convert);
+BENCHMARK(Convert)->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ---------------------------------------------------------------------------
+static void Filter_Relevant_Triples(benchmark::State& state) {
+    const auto numNodes = static_cast<std::size_t>(state.range(0));
+    Write_Input_Files(numNodes);
+    olu::osm::Osm2ttl::convert();
 
+    // Half of the objects are relevant, the others are only referenced
+    const auto nodes = Ids_Up_To(numNodes / 2);
+    const auto ways = Ids_Up_To(numNodes / 20);
+    const auto relations = Ids_Up_To(numNodes / 200);
+    const auto triples = Count_Triples(cnst::PATH_TO_OUTPUT_FILE);
+
+    for (auto _ : state) {
+        auto relevantTriples = olu::osm::OsmChangeHandler::filterRelevantTriples(
+            cnst::PATH_TO_OUTPUT_FILE, nodes, ways, relations);
+        benchmark::DoNotOptimize(relevantTriples);
+    }
+
+    state.counters["triples/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * triples), benchmark::Counter::kIsRate);
+}
+BENCHMARK(Filter_Relevant_Triples)->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -22,6 +22,15 @@
 #include "util/XmlReader.h"
 #include "config/Constants.h"
 #include "osm/OsmChangeHandler.h"
+#include "util/ChangeFileGenerator.h"
+#include "util/RunReport.h"
+#include "BenchmarkEndpoint.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+
+namespace cnst = olu::config::constants;
 
 
 //// ---------------------------------------------------------------------------
@@ -153,46 +162,94 @@
 //BENCHMARK(Get_Osm_Elements_For_Insert_Node);
 
 // ---------------------------------------------------------------------------
-static void Handle_Change_Delete_Node(benchmark::State& state) {
-    std::string path = "/src/tests/data/delete_node.osc";
+static std::string readFile(const std::string &path) {
+    std::ifstream file(path);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
 
-    auto config((olu::config::Config()));
-    config.sparqlEndpointUri = "http://host.docker.internal:7007/osm-planet/";
+// ---------------------------------------------------------------------------
+// Runs the change handler on the given change file content in each iteration and reports the
+// average wall time of each phase of the handler as counter.
+static void Run_Change_Handler(benchmark::State& state, const std::string &changeFileContent,
+                               std::size_t numObjects) {
+    std::filesystem::create_directories(cnst::PATH_TO_TEMP_DIR);
+    olu::util::ChangeFileGenerator::write(changeFileContent, cnst::PATH_TO_CHANGE_FILE);
 
-    auto och = olu::osm::OsmChangeHandler(config);
+    auto config((olu::config::Config()));
+    config.sparqlEndpointUri = olu::benchmarks::getBenchmarkEndpoint();
+    config.sparqlEndpointUriForUpdates = config.sparqlEndpointUri;
+    config.showProgress = false;
 
+    const auto phasesBefore = olu::util::RunReport::getPhases().size();
     for (auto _ : state) {
+        auto och = olu::osm::OsmChangeHandler(config);
         och.run();
     }
+
+    const auto phases = olu::util::RunReport::getPhases();
+    std::map<std::string, double> wallTimes;
+    for (auto it = phases.begin() + static_cast<long>(phasesBefore); it != phases.end(); ++it) {
+        wallTimes[it->name] += it->wallTime;
+    }
+    for (const auto &[name, wallTime] : wallTimes) {
+        state.counters[name] = benchmark::Counter(
+            wallTime / static_cast<double>(state.iterations()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(numObjects));
+}
+
+// ---------------------------------------------------------------------------
+static void Handle_Change_Delete_Node(benchmark::State& state) {
+    std::string path = "/src/tests/data/delete_node.osc";
+    Run_Change_Handler(state, readFile(path), 1);
 }
 BENCHMARK(Handle_Change_Delete_Node);
 
 // ---------------------------------------------------------------------------
 static void Handle_Change_Insert_Node(benchmark::State& state) {
     std::string path = "/src/tests/data/insert_node.osc";
-
-    auto config((olu::config::Config()));
-    config.sparqlEndpointUri = "http://host.docker.internal:7007/osm-planet/";
-
-    auto och = olu::osm::OsmChangeHandler(config);
-
-    for (auto _ : state) {
-        och.run();
-    }
+    Run_Change_Handler(state, readFile(path), 1);
 }
 BENCHMARK(Handle_Change_Insert_Node);
 
 // ---------------------------------------------------------------------------
 static void Handle_Change_Modify_Node(benchmark::State& state) {
     std::string path = "/src/tests/data/modify_node.osc";
+    Run_Change_Handler(state, readFile(path), 1);
+}
+BENCHMARK(Handle_Change_Modify_Node);
 
-    auto config((olu::config::Config()));
-    config.sparqlEndpointUri = "http://host.docker.internal:7007/osm-planet/";
-
-    auto och = olu::osm::OsmChangeHandler(config);
+// ---------------------------------------------------------------------------
+// Sweeps generated change files from 10^3 objects up to the number of objects given in the
+// environment variable `OLU_BENCHMARK_MAX_OBJECTS` (10^5 by default, up to 10^7).
+static void Generated_Change_Sizes(benchmark::internal::Benchmark* benchmark) {
+    long maxObjects = 100000;
+    if (const char* value = std::getenv("OLU_BENCHMARK_MAX_OBJECTS")) {
+        maxObjects = std::stol(value);
+    }
 
-    for (auto _ : state) {
-        och.run();
+    for (long objects = 1000; objects <= std::min(maxObjects, 10000000L); objects *= 10) {
+        benchmark->Arg(objects);
     }
 }
-BENCHMARK(Handle_Change_Modify_Node);
\ No newline at end of file
+
+// ---------------------------------------------------------------------------
+static void Handle_Generated_Changes(benchmark::State& state) {
+    const auto numObjects = static_cast<std::size_t>(state.range(0));
+    olu::util::ChangeFileGenerator generator(numObjects);
+    Run_Change_Handler(state, generator.generate(), numObjects);
+}
+BENCHMARK(Handle_Generated_Changes)->Apply(Generated_Change_Sizes)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ---------------------------------------------------------------------------
+// Same sweep with a change file that only contains node moves, which stresses the geometry
+// update of ways and relations
+static void Handle_Generated_Node_Moves(benchmark::State& state) {
+    const auto numObjects = static_cast<std::size_t>(state.range(0));
+    olu::util::ChangeFileGenerator generator(numObjects, {1, 0, 0, 0, 0});
+    Run_Change_Handler(state, generator.generate(), numObjects);
+}
+BENCHMARK(Handle_Generated_Node_Moves)->Apply(Generated_Change_Sizes)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
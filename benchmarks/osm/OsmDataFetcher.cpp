@@ -19,11 +19,12 @@
 #include "osm/OsmDataFetcher.h"
 #include "benchmark/benchmark.h"
 #include "config/Constants.h"
+#include "BenchmarkEndpoint.h"
 
 // ---------------------------------------------------------------------------
 static void Fetch_Latest_Timestamp_Of_Any_Node(benchmark::State& state) {
     auto config((olu::config::Config()));
-    config.sparqlEndpointUri = "http://host.docker.internal:7007/osm-planet/";
+    config.sparqlEndpointUri = olu::benchmarks::getBenchmarkEndpoint();
 
     auto odf = olu::osm::OsmDataFetcher(config);
 
@@ -0,0 +1,115 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "sparql/QueryWriter.h"
+#include "config/Config.h"
+#include "BenchmarkData.h"
+
+#include "benchmark/benchmark.h"
+
+// ---------------------------------------------------------------------------
+static void Write_Delete_Query(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const auto ids = olu::benchmarks::makeIdBatch(state.range(0));
+
+    for (auto _ : state) {
+        auto query = qw.writeDeleteQuery(ids, "osmway");
+        benchmark::DoNotOptimize(query);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Write_Delete_Query)->Arg(1)->Arg(olu::benchmarks::BATCH_SIZE);
+
+// ---------------------------------------------------------------------------
+static void Write_Insert_Query(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const auto triples = olu::benchmarks::makeInsertTriples(state.range(0));
+
+    for (auto _ : state) {
+        auto query = qw.writeInsertQuery(triples);
+        benchmark::DoNotOptimize(query);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Write_Insert_Query)->Arg(1)->Arg(olu::benchmarks::BATCH_SIZE);
+
+// ---------------------------------------------------------------------------
+static void Write_Insert_Query_Large_Geometry(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const std::vector<std::string> triples = {
+        "osm2rdfgeom:osm_wayarea_1 geo:asWKT " + olu::benchmarks::makeWktLineString(state.range(0))
+    };
+
+    for (auto _ : state) {
+        auto query = qw.writeInsertQuery(triples);
+        benchmark::DoNotOptimize(query);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(triples[0].size()));
+}
+BENCHMARK(Write_Insert_Query_Large_Geometry)->Arg(1000)->Arg(100000);
+
+// ---------------------------------------------------------------------------
+static void Write_Query_For_Node_Locations(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const auto ids = olu::benchmarks::makeIdBatch();
+
+    for (auto _ : state) {
+        auto query = qw.writeQueryForNodeLocations(ids);
+        benchmark::DoNotOptimize(query);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+BENCHMARK(Write_Query_For_Node_Locations);
+
+// ---------------------------------------------------------------------------
+static void Write_Query_For_Relations(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const auto ids = olu::benchmarks::makeIdBatch();
+
+    for (auto _ : state) {
+        auto query = qw.writeQueryForRelations(ids);
+        benchmark::DoNotOptimize(query);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+BENCHMARK(Write_Query_For_Relations);
+
+// ---------------------------------------------------------------------------
+static void Write_Query_For_Ways_Referencing_Nodes(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const auto ids = olu::benchmarks::makeIdBatch();
+
+    for (auto _ : state) {
+        auto query = qw.writeQueryForWaysReferencingNodes(ids);
+        benchmark::DoNotOptimize(query);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+BENCHMARK(Write_Query_For_Ways_Referencing_Nodes);
@@ -20,60 +20,31 @@
 
 #include "benchmark/benchmark.h"
 #include "config/Constants.h"
+#include "BenchmarkEndpoint.h"
 #include "sparql/QueryWriter.h"
 
 namespace cnst = olu::config::constants;
 
-// ---------------------------------------------------------------------------
-static void Set_Prefixes(benchmark::State& state) {
-    auto config((olu::config::Config()));
-    auto sparqlWrapper = olu::sparql::SparqlWrapper(config);
-
-    for (auto _ : state) {
-        sparqlWrapper.setPrefixes(olu::config::constants::PREFIXES_FOR_WAY_DELETE_QUERY);
-    }
-}
-BENCHMARK(Set_Prefixes);
-
 // ---------------------------------------------------------------------------
 static void Run_Query_For_Node_Location(benchmark::State& state) {
     auto config((olu::config::Config()));
-    config.sparqlEndpointUri = "http://host.docker.internal:7007/osm-planet/";
+    config.sparqlEndpointUri = olu::benchmarks::getBenchmarkEndpoint();
 
     auto sparqlWrapper = olu::sparql::SparqlWrapper(config);
     olu::sparql::QueryWriter qw{config};
     std::string query = qw.writeQueryForNodeLocations({1});
 
     for (auto _ : state) {
-        sparqlWrapper.setQuery(query);
-        sparqlWrapper.setPrefixes(olu::config::constants::PREFIXES_FOR_NODE_LOCATION);
-
-        auto response = sparqlWrapper.runQuery();
+        auto response = sparqlWrapper.runQuery(
+            {query, olu::config::constants::PREFIXES_FOR_NODE_LOCATION});
     }
 }
 BENCHMARK(Run_Query_For_Node_Location);
 
-// // ---------------------------------------------------------------------------
-// static void Run_Query_For_Node_Deletion(benchmark::State& state) {
-//     auto config((olu::config::Config()));
-//     config.sparqlEndpointUri = cnst::QLEVER_LOCAL_HOST_URI;
-//
-//     auto sparqlWrapper = olu::sparql::SparqlWrapper(config);
-//     // auto query = olu::sparql::QueryWriter::writeDeleteQuery({"osmnode:1"}, TODO);
-//
-//     for (auto _ : state) {
-//         sparqlWrapper.setPrefixes(cnst::PREFIXES_FOR_NODE_DELETE_QUERY);
-//         sparqlWrapper.setQuery(query);
-//
-//         auto response = sparqlWrapper.runQuery();
-//     }
-// }
-// BENCHMARK(Run_Query_For_Node_Deletion);
-
 // ---------------------------------------------------------------------------
 static void Clear_Cache(benchmark::State& state) {
     auto config((olu::config::Config()));
-    config.sparqlEndpointUri = "http://host.docker.internal:7007/osm-planet/";
+    config.sparqlEndpointUri = olu::benchmarks::getBenchmarkEndpoint();
 
     for (auto _ : state) {
         auto sparqlWrapper = olu::sparql::SparqlWrapper(config);
@@ -0,0 +1,64 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/OsmObjectHelper.h"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+static void Get_Id_From_Uri(benchmark::State& state) {
+    const std::vector<std::string> uris = {
+        "https://www.openstreetmap.org/node/1787",
+        "https://www.openstreetmap.org/way/98765432",
+        "https://www.openstreetmap.org/relation/1234567",
+        "https://www.openstreetmap.org/node/11234567890"
+    };
+
+    for (auto _ : state) {
+        for (const auto &uri : uris) {
+            auto id = olu::osm::OsmObjectHelper::getIdFromUri(uri);
+            benchmark::DoNotOptimize(id);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(uris.size()));
+}
+BENCHMARK(Get_Id_From_Uri);
+
+// ---------------------------------------------------------------------------
+static void Get_Ids_From_Uris(benchmark::State& state) {
+    boost::property_tree::ptree results;
+    for (long i = 0; i < state.range(0); ++i) {
+        boost::property_tree::ptree result;
+        result.put("binding.uri", "https://www.openstreetmap.org/way/" + std::to_string(i));
+        results.add_child("result", result);
+    }
+
+    std::vector<olu::id_t> ids;
+    for (auto _ : state) {
+        ids.clear();
+        olu::osm::OsmObjectHelper::getIdsFromUris(results, "binding.uri", ids);
+        benchmark::DoNotOptimize(ids.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Get_Ids_From_Uris)->Arg(1024);
@@ -0,0 +1,83 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/TtlHelper.h"
+#include "config/Constants.h"
+#include "BenchmarkData.h"
+
+#include "benchmark/benchmark.h"
+
+namespace cnst = olu::config::constants;
+
+// ---------------------------------------------------------------------------
+static void Get_Triple(benchmark::State& state) {
+    const std::string line = "osmnode:1787 osmkey:name \"Freiburg im Breisgau\" .";
+
+    for (auto _ : state) {
+        auto triple = olu::util::TtlHelper::getTriple(line);
+        benchmark::DoNotOptimize(triple);
+    }
+}
+BENCHMARK(Get_Triple);
+
+// ---------------------------------------------------------------------------
+static void Get_Triple_Large_Geometry(benchmark::State& state) {
+    const std::string line = "osm2rdfgeom:osm_wayarea_1 geo:asWKT "
+                             + olu::benchmarks::makeWktLineString(state.range(0)) + " .";
+
+    for (auto _ : state) {
+        auto triple = olu::util::TtlHelper::getTriple(line);
+        benchmark::DoNotOptimize(triple);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(line.size()));
+}
+BENCHMARK(Get_Triple_Large_Geometry)->Arg(1000)->Arg(100000);
+
+// ---------------------------------------------------------------------------
+static void Get_Id_From_Subject(benchmark::State& state) {
+    const std::vector<std::pair<std::string, std::string>> subjects = {
+        {"osmnode:1787", cnst::NODE_TAG},
+        {"osm2rdfgeom:osm_node_centroid_1787", cnst::NODE_TAG},
+        {"osmway:98765432", cnst::WAY_TAG},
+        {"osm2rdfgeom:osm_wayarea_98765432", cnst::WAY_TAG},
+        {"osmrel:1234567", cnst::RELATION_TAG},
+        {"osm2rdfgeom:osm_relarea_1234567", cnst::RELATION_TAG}
+    };
+
+    for (auto _ : state) {
+        for (const auto &[subject, osmTag] : subjects) {
+            auto id = olu::util::TtlHelper::getIdFromSubject(subject, osmTag);
+            benchmark::DoNotOptimize(id);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(subjects.size()));
+}
+BENCHMARK(Get_Id_From_Subject);
+
+// ---------------------------------------------------------------------------
+static void Is_Relevant_Namespace(benchmark::State& state) {
+    const std::string subject = "osmway:98765432";
+
+    for (auto _ : state) {
+        auto relevant = olu::util::TtlHelper::isRelevantNamespace(subject, cnst::WAY_TAG);
+        benchmark::DoNotOptimize(relevant);
+    }
+}
+BENCHMARK(Is_Relevant_Namespace);
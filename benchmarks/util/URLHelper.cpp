@@ -0,0 +1,77 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/URLHelper.h"
+#include "sparql/QueryWriter.h"
+#include "config/Config.h"
+#include "BenchmarkData.h"
+
+#include "benchmark/benchmark.h"
+
+// ---------------------------------------------------------------------------
+static void Encode_For_Url_Query_Delete(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const auto query = qw.writeDeleteQuery(olu::benchmarks::makeIdBatch(), "osmnode");
+
+    for (auto _ : state) {
+        auto encoded = olu::util::URLHelper::encodeForUrlQuery(query);
+        benchmark::DoNotOptimize(encoded);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(query.size()));
+}
+BENCHMARK(Encode_For_Url_Query_Delete);
+
+// ---------------------------------------------------------------------------
+static void Encode_For_Url_Query_Insert(benchmark::State& state) {
+    auto config((olu::config::Config()));
+    olu::sparql::QueryWriter qw{config};
+    const auto query = qw.writeInsertQuery(olu::benchmarks::makeInsertTriples());
+
+    for (auto _ : state) {
+        auto encoded = olu::util::URLHelper::encodeForUrlQuery(query);
+        benchmark::DoNotOptimize(encoded);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(query.size()));
+}
+BENCHMARK(Encode_For_Url_Query_Insert);
+
+// ---------------------------------------------------------------------------
+static void Encode_For_Url_Query_Large_Geometry(benchmark::State& state) {
+    const auto wkt = olu::benchmarks::makeWktLineString(state.range(0));
+
+    for (auto _ : state) {
+        auto encoded = olu::util::URLHelper::encodeForUrlQuery(wkt);
+        benchmark::DoNotOptimize(encoded);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(wkt.size()));
+}
+BENCHMARK(Encode_For_Url_Query_Large_Geometry)->Arg(1000)->Arg(100000);
+
+// ---------------------------------------------------------------------------
+static void Format_Sequence_Number_For_Url(benchmark::State& state) {
+    for (auto _ : state) {
+        int sequenceNumber = 6177383;
+        auto formatted = olu::util::URLHelper::formatSequenceNumberForUrl(sequenceNumber);
+        benchmark::DoNotOptimize(formatted);
+    }
+}
+BENCHMARK(Format_Sequence_Number_For_Url);
@@ -0,0 +1,34 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "util/WktHelper.h"
+
+#include "benchmark/benchmark.h"
+
+// ---------------------------------------------------------------------------
+static void Parse_Point(benchmark::State& state) {
+    const std::string wkt = "POINT(13.5690032 42.7957187)";
+
+    for (auto _ : state) {
+        osmium::Location location;
+        benchmark::DoNotOptimize(olu::util::WktHelper::parsePoint(wkt, location));
+        benchmark::DoNotOptimize(location);
+    }
+}
+BENCHMARK(Parse_Point);
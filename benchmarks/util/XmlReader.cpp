@@ -22,6 +22,7 @@
 #include "config/Config.h"
 #include "util/XmlReader.h"
 #include "config/Constants.h"
+#include "BenchmarkData.h"
 
 // ---------------------------------------------------------------------------
 static void Read_Attribute(benchmark::State& state) {
@@ -88,5 +89,59 @@ static void Read_Tag_Of_Children(benchmark::State& state) {
 }
 BENCHMARK(Read_Tag_Of_Children);
 
+// ---------------------------------------------------------------------------
+static void Xml_Encode(benchmark::State& state) {
+    const std::string value = "Café \"Zum Löwen\" & <Bar>\n" + std::string(state.range(0), 'a');
+
+    for (auto _ : state) {
+        auto encoded = olu::util::XmlReader::xmlEncode(value);
+        benchmark::DoNotOptimize(encoded);
+    }
 
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(value.size()));
+}
+BENCHMARK(Xml_Encode)->Arg(16)->Arg(1 << 20);
+
+// ---------------------------------------------------------------------------
+static void Xml_Decode(benchmark::State& state) {
+    const std::string value = olu::util::XmlReader::xmlEncode(
+        "Café \"Zum Löwen\" & <Bar>\n" + std::string(state.range(0), 'a'));
 
+    for (auto _ : state) {
+        auto decoded = olu::util::XmlReader::xmlDecode(value);
+        benchmark::DoNotOptimize(decoded);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(value.size()));
+}
+BENCHMARK(Xml_Decode)->Arg(16)->Arg(1 << 20);
+
+// ---------------------------------------------------------------------------
+static void Xml_Decode_Large_Geometry(benchmark::State& state) {
+    const auto wkt = olu::benchmarks::makeWktLineString(state.range(0));
+
+    for (auto _ : state) {
+        auto decoded = olu::util::XmlReader::xmlDecode(wkt);
+        benchmark::DoNotOptimize(decoded);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(wkt.size()));
+}
+BENCHMARK(Xml_Decode_Large_Geometry)->Arg(100000);
+
+// ---------------------------------------------------------------------------
+static void Is_Xml_Encoded(benchmark::State& state) {
+    const std::string encoded = "Café &quot;Zum Löwen&quot; &amp; Bar";
+    const std::string plain = std::string(state.range(0), 'a');
+
+    for (auto _ : state) {
+        auto first = olu::util::XmlReader::isXmlEncoded(encoded);
+        auto second = olu::util::XmlReader::isXmlEncoded(plain);
+        benchmark::DoNotOptimize(first);
+        benchmark::DoNotOptimize(second);
+    }
+
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<long>(encoded.size() + plain.size()));
+}
+BENCHMARK(Is_Xml_Encoded)->Arg(16)->Arg(1 << 20);
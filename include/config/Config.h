@@ -21,6 +21,10 @@
 
 #include <string>
 #include <filesystem>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 namespace olu::config {
 
@@ -30,9 +34,25 @@ enum SparqlOutput {
     DEBUG_FILE = 2,
 };
 
+// A further SPARQL endpoint the updates are applied to
+struct UpdateTarget {
+    std::string endpointUri;
+    // Uri of the SPARQL graph. Optional.
+    std::string graphUri;
+    // Access token for the endpoint. Optional.
+    std::string accessToken;
+};
+
 struct Config {
     // The uri of the SPARQL endpoint for queries
     std::string sparqlEndpointUri;
+    // Uris of further SPARQL endpoints that serve the same data as `sparqlEndpointUri`. Queries
+    // are balanced across all of them, updates are only sent to `sparqlEndpointUriForUpdates`.
+    std::vector<std::string> sparqlReadReplicaUris;
+    // Specifies whether a query is sent to a second read endpoint as well if it takes longer than
+    // the 95th percentile of the recent queries
+    bool hedgeReadQueries = false;
+
     // The uri to the SPARQL endpoint to update. If not specified by user, this will be the same as
     // the endpoint for queries
     std::string sparqlEndpointUriForUpdates;
@@ -44,6 +64,11 @@ struct Config {
 
     // Uri of the SPARQL graph. Optional.
     std::string graphUri;
+    // Further endpoints that hold the same data as the main endpoint. The update is computed once
+    // and applied to the endpoint for updates and all of these targets concurrently.
+    std::vector<UpdateTarget> updateTargets;
+    // Number of times a failed update query is retried before the update of a target is aborted
+    std::size_t updateRetries = 0;
     // Access token for the SPARQL endpoint. Optional.
     std::string accessToken;
 
@@ -52,6 +77,9 @@ struct Config {
     // User specified timestamp from command line
     std::string timestamp;
 
+    // Specifies whether objects whose version is already stored in the database are skipped
+    bool skipAppliedObjects = false;
+
     // Specifies whether a progress bar should be shown
     bool showProgress = true;
 
@@ -62,9 +90,47 @@ struct Config {
     SparqlOutput sparqlOutput = ENDPOINT;
     std::filesystem::path sparqlOutputFile;
 
+    // Region to which the change files are clipped, either as a bounding box of the form
+    // `MIN_LON,MIN_LAT,MAX_LON,MAX_LAT` or as a polygon file. At most one of them is set.
+    std::string clipBbox;
+    std::filesystem::path clipPolygonFile;
+
+    // Path to the file in which ways and relations whose geometry has to be updated are queued
+    // across runs. If empty, geometries are updated in the same run in which they are detected.
+    std::filesystem::path geometryQueueFile;
+    // The queue is drained as soon as it contains at least this many objects
+    std::size_t geometryQueueMaxSize = 100000;
+    // The queue is drained if the last drain is at least this many seconds ago
+    long geometryQueueMaxAge = 3600;
+
+    // Path to the directory in which the update of a run is journaled, so that it can be resumed
+    // after a crash. If empty, no journal is written.
+    std::filesystem::path journalDir;
+
+    // Path to the file the JSON run report is written to. If empty, no report is written.
+    std::filesystem::path runReportFile;
+
+    // Path to the NDJSON file each HTTP request is traced to. If empty, requests are not traced.
+    std::filesystem::path requestTraceFile;
+
+    // Path to the file the SPARQL requests and responses are recorded to. If empty, nothing is
+    // recorded.
+    std::filesystem::path requestRecordingFile;
+
+    // Port of the metrics endpoint. If 0, no metrics are served.
+    int metricsPort = 0;
+
+    // Path to the file the timeline of the run is written to in the Chrome Trace Event format.
+    // If empty, no timeline is written.
+    std::filesystem::path chromeTraceFile;
+
     // Generate the information string containing the current settings.
     [[nodiscard]] std::string getInfo(std::string_view prefix) const;
 
+    // Parse an update target of the form `URI[,GRAPH_URI[,ACCESS_TOKEN]]`. Returns nothing if
+    // one of the uris is not valid.
+    static std::optional<UpdateTarget> parseUpdateTarget(std::string_view value);
+
     // Parse provided commandline arguments into config object.
     void fromArgs(int argc, char** argv);
 };
@@ -170,6 +170,13 @@ namespace olu::config::constants {
             "PREFIX osmrel: <https://www.openstreetmap.org/relation/>",
     };
 
+    const static inline std::vector<std::string> PREFIXES_FOR_VERSIONS {
+            "PREFIX osmnode: <https://www.openstreetmap.org/node/>",
+            "PREFIX osmway: <https://www.openstreetmap.org/way/>",
+            "PREFIX osmrel: <https://www.openstreetmap.org/relation/>",
+            "PREFIX osmmeta: <https://www.openstreetmap.org/meta/>"
+    };
+
     // Qlever
     const static inline std::string HEADER = "Configuration for OLU";
 
@@ -197,6 +204,38 @@ namespace olu::config::constants {
     const static inline std::string SPARQL_UPDATE_PATH_OPTION_HELP =
          "Specify a different URI for SPARQL updates.";
 
+    const static inline std::string READ_REPLICA_INFO = "SPARQL read replica URI:";
+    const static inline std::string READ_REPLICA_OPTION_SHORT = "";
+    const static inline std::string READ_REPLICA_OPTION_LONG = "read-replica";
+    const static inline std::string READ_REPLICA_OPTION_HELP =
+            "URI of a further SPARQL endpoint that serves the same data as the main endpoint. Can "
+            "be given multiple times. Queries are sent to the endpoint with the fewest outstanding "
+            "requests, updates are only sent to the main endpoint or the endpoint for updates.";
+
+    const static inline std::string HEDGE_READS_INFO = "Hedging queries at the 95th percentile";
+    const static inline std::string HEDGE_READS_OPTION_SHORT = "";
+    const static inline std::string HEDGE_READS_OPTION_LONG = "hedge-reads";
+    const static inline std::string HEDGE_READS_OPTION_HELP =
+            "Send a query to a second read endpoint as well if it takes longer than the 95th "
+            "percentile of the recent queries, and use the response that arrives first. Requires "
+            "at least one --read-replica.";
+
+    const static inline std::string UPDATE_TARGET_INFO = "Additional update target:";
+    const static inline std::string UPDATE_TARGET_OPTION_SHORT = "";
+    const static inline std::string UPDATE_TARGET_OPTION_LONG = "update-target";
+    const static inline std::string UPDATE_TARGET_OPTION_HELP =
+            "A further SPARQL endpoint that holds the same data as the main endpoint, given as "
+            "URI[,GRAPH_URI[,ACCESS_TOKEN]]. Can be given multiple times. The update is computed "
+            "once and applied to all targets concurrently. Can not be combined with an output "
+            "file.";
+
+    const static inline std::string UPDATE_RETRIES_INFO = "Retries per update query:";
+    const static inline std::string UPDATE_RETRIES_OPTION_SHORT = "";
+    const static inline std::string UPDATE_RETRIES_OPTION_LONG = "update-retries";
+    const static inline std::string UPDATE_RETRIES_OPTION_HELP =
+            "Number of times a failed update query is retried on a target before the update of "
+            "that target is aborted.";
+
     const static inline std::string SPARQL_OUTPUT_INFO = "Update Output:";
     const static inline std::string SPARQL_OUTPUT_OPTION_SHORT = "o";
     const static inline std::string SPARQL_OUTPUT_OPTION_LONG = "sparql-output";
@@ -234,6 +273,97 @@ namespace olu::config::constants {
     const static inline std::string TIME_STAMP_OPTION_HELP =
             "The time stamp to start the update process from.";
 
+    const static inline std::string SKIP_APPLIED_INFO =
+            "Skipping objects whose version is already in the database";
+    const static inline std::string SKIP_APPLIED_OPTION_SHORT = "";
+    const static inline std::string SKIP_APPLIED_OPTION_LONG = "skip-applied";
+    const static inline std::string SKIP_APPLIED_OPTION_HELP =
+            "Look up the versions stored in the database for all objects in the change files and "
+            "skip the objects that are already up to date. Use this to restart the update from "
+            "an older sequence number or timestamp without processing the same changes again. "
+            "If a run crashed after an object was inserted but before the update was complete, "
+            "the object is skipped as well, and the ways and relations that reference it can "
+            "keep an outdated geometry.";
+
+    const static inline std::string CLIP_BBOX_INFO = "Clipping changes to bounding box:";
+    const static inline std::string CLIP_BBOX_OPTION_SHORT = "";
+    const static inline std::string CLIP_BBOX_OPTION_LONG = "bbox";
+    const static inline std::string CLIP_BBOX_OPTION_HELP =
+            "Only process the changes inside the bounding box MIN_LON,MIN_LAT,MAX_LON,MAX_LAT. "
+            "Use this to update a database that was built from an extract with the change files "
+            "of the whole planet.";
+
+    const static inline std::string CLIP_POLYGON_INFO = "Clipping changes to polygon:";
+    const static inline std::string CLIP_POLYGON_OPTION_SHORT = "";
+    const static inline std::string CLIP_POLYGON_OPTION_LONG = "clip-polygon";
+    const static inline std::string CLIP_POLYGON_OPTION_HELP =
+            "Only process the changes inside the polygon in the given file. The file has to be in "
+            "the Osmosis polygon filter format (.poly), in which the boundaries of the Geofabrik "
+            "extracts are published.";
+
+    const static inline std::string GEOMETRY_QUEUE_INFO = "Geometry update queue:";
+    const static inline std::string GEOMETRY_QUEUE_OPTION_SHORT = "";
+    const static inline std::string GEOMETRY_QUEUE_OPTION_LONG = "geometry-queue";
+    const static inline std::string GEOMETRY_QUEUE_OPTION_HELP =
+            "Path to a file in which geometry updates of ways and relations are queued across runs "
+            "instead of being applied immediately.";
+
+    const static inline std::string GEOMETRY_QUEUE_SIZE_OPTION_SHORT = "";
+    const static inline std::string GEOMETRY_QUEUE_SIZE_OPTION_LONG = "geometry-queue-size";
+    const static inline std::string GEOMETRY_QUEUE_SIZE_OPTION_HELP =
+            "Number of queued objects after which the geometry update queue is drained.";
+
+    const static inline std::string GEOMETRY_QUEUE_INTERVAL_OPTION_SHORT = "";
+    const static inline std::string GEOMETRY_QUEUE_INTERVAL_OPTION_LONG = "geometry-queue-interval";
+    const static inline std::string GEOMETRY_QUEUE_INTERVAL_OPTION_HELP =
+            "Time in seconds after which the geometry update queue is drained.";
+
+    const static inline std::string JOURNAL_INFO = "Update journal:";
+    const static inline std::string JOURNAL_OPTION_SHORT = "";
+    const static inline std::string JOURNAL_OPTION_LONG = "journal";
+    const static inline std::string JOURNAL_OPTION_HELP =
+            "Path to a directory in which the computed update and each batch that an endpoint "
+            "acknowledged are recorded. If the update is interrupted, the next run resumes it "
+            "from the first batch that was not acknowledged.";
+
+    const static inline std::string RUN_REPORT_INFO = "Run report:";
+    const static inline std::string RUN_REPORT_OPTION_SHORT = "";
+    const static inline std::string RUN_REPORT_OPTION_LONG = "report";
+    const static inline std::string RUN_REPORT_OPTION_HELP =
+            "Path to a file to which a JSON report with timings, memory usage and SPARQL traffic "
+            "of each phase of the run is written.";
+
+    const static inline std::string REQUEST_TRACE_INFO = "Request trace:";
+    const static inline std::string REQUEST_TRACE_OPTION_SHORT = "";
+    const static inline std::string REQUEST_TRACE_OPTION_LONG = "trace-requests";
+    const static inline std::string REQUEST_TRACE_OPTION_HELP =
+            "Path to a file to which one JSON record with sizes and timings is written for each "
+            "HTTP request (NDJSON). The field serverMs, the time QLever reports for computing the "
+            "result, is only set for responses in JSON, which are updates and errors. It is null "
+            "for successful queries, because their results are requested as XML.";
+
+    const static inline std::string REQUEST_RECORDING_INFO = "Recording SPARQL requests to:";
+    const static inline std::string REQUEST_RECORDING_OPTION_SHORT = "";
+    const static inline std::string REQUEST_RECORDING_OPTION_LONG = "record-requests";
+    const static inline std::string REQUEST_RECORDING_OPTION_HELP =
+            "Path to a file to which all requests to the SPARQL endpoint and their responses are "
+            "appended. The file can be replayed with olu-replay-server.";
+
+    const static inline std::string METRICS_PORT_INFO = "Serving metrics on port:";
+    const static inline std::string METRICS_PORT_OPTION_SHORT = "";
+    const static inline std::string METRICS_PORT_OPTION_LONG = "metrics-port";
+    const static inline std::string METRICS_PORT_OPTION_HELP =
+            "Port on which the replication lag, throughput and queue depths are served in the "
+            "Prometheus text format. The port is bound to the loopback interface only.";
+
+    const static inline std::string CHROME_TRACE_INFO = "Chrome trace:";
+    const static inline std::string CHROME_TRACE_OPTION_SHORT = "";
+    const static inline std::string CHROME_TRACE_OPTION_LONG = "chrome-trace";
+    const static inline std::string CHROME_TRACE_OPTION_HELP =
+            "Path to a file to which a timeline of all phases, SPARQL requests, HTTP requests and "
+            "conversion steps is written in the Chrome Trace Event format. The file can be opened "
+            "in Perfetto.";
+
 } // namespace olu::config::constants
 
 #endif //OSM_LIVE_UPDATES_CONSTANTS_H
@@ -0,0 +1,75 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_APPLIEDCHANGEFILTER_H
+#define OSM_LIVE_UPDATES_APPLIEDCHANGEFILTER_H
+
+#include "util/Types.h"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <osmium/osm/object.hpp>
+
+namespace olu::osm {
+
+    /**
+     * Removes the objects from a change file that the database already contains in the same or a
+     * newer version. This is the case if a run is restarted after a crash or from an older
+     * sequence number or timestamp, so that change files overlap with the ones that were
+     * already applied.
+     *
+     * The versions that are stored in the database are looked up for all objects in the change
+     * file, in batches. Deleted objects and objects without a stored version are always kept.
+     *
+     * An object whose update was interrupted after it was inserted is skipped as well, even if
+     * the geometries of the ways and relations that reference it were not updated yet.
+     */
+    class AppliedChangeFilter {
+    public:
+        // Returns the versions stored in the database for the objects with the given type and
+        // ids. Objects without a stored version are left out.
+        using VersionLookup = std::function<std::map<id_t, std::size_t>(
+            osmium::item_type type, const std::set<id_t> &ids)>;
+
+        explicit AppliedChangeFilter(VersionLookup lookup) : _lookup(std::move(lookup)) {}
+
+        /**
+         * @param objects The newest version of each object in the change file
+         * @return The objects that are newer than the stored version, in the same order as in
+         * `objects`
+         */
+        [[nodiscard]] std::vector<const osmium::OSMObject*>
+        filter(const std::vector<const osmium::OSMObject*> &objects);
+
+        [[nodiscard]] std::size_t getNumberOfSkippedObjects() const { return _skippedObjects; }
+
+        // Maximum number of objects whose versions are looked up with a single request
+        static constexpr std::size_t MAX_OBJECTS_PER_LOOKUP = 1024;
+    private:
+        VersionLookup _lookup;
+        std::size_t _skippedObjects = 0;
+    };
+
+} // namespace olu::osm
+
+#endif //OSM_LIVE_UPDATES_APPLIEDCHANGEFILTER_H
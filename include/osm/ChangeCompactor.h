@@ -0,0 +1,131 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_CHANGECOMPACTOR_H
+#define OSM_LIVE_UPDATES_CHANGECOMPACTOR_H
+
+#include "util/Types.h"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <vector>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+
+namespace olu::osm {
+
+    // We need to create a new ordering because we have to take the deleted status into account for
+    // the objects. This is the order `ChangeCompactor::compact` expects the versions in.
+    struct object_order_type_id_reverse_version_delete {
+
+        bool operator()(const osmium::OSMObject& lhs, const osmium::OSMObject& rhs) const noexcept {
+            return const_tie(lhs.type(), lhs.id() > 0, lhs.positive_id(), rhs.version(), rhs.deleted(),
+                        ((lhs.timestamp().valid() && rhs.timestamp().valid()) ? rhs.timestamp() : osmium::Timestamp())) <
+                   const_tie(rhs.type(), rhs.id() > 0, rhs.positive_id(), lhs.version(), lhs.deleted(),
+                        ((lhs.timestamp().valid() && rhs.timestamp().valid()) ? lhs.timestamp() : osmium::Timestamp()));
+        }
+
+        /// @pre lhs and rhs must not be nullptr
+        bool operator()(const osmium::OSMObject* lhs, const osmium::OSMObject* rhs) const noexcept {
+            assert(lhs && rhs);
+            return operator()(*lhs, *rhs);
+        }
+
+    };
+
+    /**
+     * The ids of the objects that did not exist before the change window, whatever their newest
+     * version in the window is.
+     */
+    struct CreatedObjects {
+        std::set<id_t> nodes;
+        std::set<id_t> ways;
+        std::set<id_t> relations;
+
+        [[nodiscard]] bool contains(osmium::item_type type, id_t id) const;
+    };
+
+    /**
+     * Reduces all versions an object has inside a change window to their net effect on the
+     * database. Only the first and the last change of the object matter:
+     *
+     * | first change | last change      | net effect |
+     * |--------------|------------------|------------|
+     * | create       | delete           | none       |
+     * | create       | create or modify | create     |
+     * | modify       | modify           | modify     |
+     * | modify       | delete           | delete     |
+     *
+     * An object is created by the first change if its oldest version in the window is the first
+     * version of the object. This is the same rule osmium uses to put objects into the `create`
+     * section of a change file. If the window also contains later versions of the object, it is
+     * only treated as created if the database is known not to contain it. Otherwise the window
+     * could be a replay of changes that were already applied, for example after a restart from an
+     * older sequence number, and the stored object has to be deleted or replaced.
+     */
+    class ChangeCompactor {
+    public:
+        enum class NetEffect { NONE, CREATE, MODIFY, DELETE };
+
+        // Returns the ids of the objects with the given type and ids that the database contains
+        using StoredLookup = std::function<std::set<id_t>(osmium::item_type type,
+                                                          const std::set<id_t> &ids)>;
+
+        struct Result {
+            // The newest version of each object with an effect, in the order of the versions
+            std::vector<const osmium::OSMObject*> objects;
+            CreatedObjects created;
+            // Number of objects that were created and deleted inside the window
+            std::size_t noOps = 0;
+            // Number of objects that were created and modified inside the window, which would
+            // be treated as modified without the compaction
+            std::size_t modifiesToCreates = 0;
+            // Number of objects whose first version is in the window that are treated as
+            // modified or deleted, because the database contains them or could not be asked
+            std::size_t unconfirmedCreates = 0;
+        };
+
+        /**
+         * @param absentBefore True if the object is known not to be in the database before the
+         * window
+         * @return The net effect of an object whose oldest version in the window is `first` and
+         * whose newest version is `last`
+         */
+        static NetEffect getNetEffect(const osmium::OSMObject &first,
+                                      const osmium::OSMObject &last, bool absentBefore);
+
+        /**
+         * @param versions All versions of the objects in the change window, sorted with
+         * `object_order_type_id_reverse_version_delete`
+         * @param lookup Used to check whether objects that were created and changed again in the
+         * window are already in the database. Without a lookup, they are treated as modified or
+         * deleted.
+         */
+        static Result compact(const std::vector<const osmium::OSMObject*> &versions,
+                              const StoredLookup &lookup = {});
+
+        // Maximum number of objects that are looked up with a single request
+        static constexpr std::size_t MAX_OBJECTS_PER_LOOKUP = 1024;
+    };
+
+} // namespace olu::osm
+
+#endif //OSM_LIVE_UPDATES_CHANGECOMPACTOR_H
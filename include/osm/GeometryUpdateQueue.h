@@ -0,0 +1,104 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_GEOMETRYUPDATEQUEUE_H
+#define OSM_LIVE_UPDATES_GEOMETRYUPDATEQUEUE_H
+
+#include "util/Types.h"
+
+#include <ctime>
+#include <filesystem>
+#include <set>
+
+namespace olu::osm {
+
+    /**
+     * Persistent, de-duplicated queue of ways and relations whose geometry has to be recomputed.
+     *
+     * Instead of recomputing the geometry of a way or relation every time one of its members is
+     * changed, the objects can be queued across multiple runs and then be updated together once
+     * the queue is drained. The queue is stored in a plain text file with one object per line.
+     */
+    class GeometryUpdateQueue {
+    public:
+        explicit GeometryUpdateQueue(std::filesystem::path path) : _path(std::move(path)) { }
+
+        /**
+         * Reads the queue from its file. If the file does not exist yet, the queue is empty and
+         * the time of the last drain is set to the current time.
+         */
+        void load();
+
+        /**
+         * Writes the queue to its file, replacing the previous content.
+         */
+        void save() const { saveTo(_path); }
+
+        /**
+         * Writes the queue to the given file instead of its own, for example to keep a snapshot
+         * of the queue.
+         */
+        void saveTo(const std::filesystem::path &path) const;
+
+        void addWays(const std::set<id_t> &wayIds);
+        void addRelations(const std::set<id_t> &relationIds);
+
+        /**
+         * Removes the given ways from the queue, for example because they are contained in the
+         * change file and are therefore updated anyway.
+         */
+        void removeWays(const std::set<id_t> &wayIds);
+        void removeRelations(const std::set<id_t> &relationIds);
+
+        /**
+         * @return True if the queue holds at least `maxSize` objects or if the last drain is at
+         * least `maxAge` seconds ago
+         */
+        [[nodiscard]] bool shouldDrain(std::size_t maxSize, long maxAge) const;
+
+        /**
+         * Moves all queued ways and relations into the given sets and empties the queue.
+         */
+        void drain(std::set<id_t> &wayIds, std::set<id_t> &relationIds);
+
+        [[nodiscard]] std::size_t size() const { return _ways.size() + _relations.size(); }
+        [[nodiscard]] const std::set<id_t>& getWays() const { return _ways; }
+        [[nodiscard]] const std::set<id_t>& getRelations() const { return _relations; }
+    private:
+        std::filesystem::path _path;
+        std::set<id_t> _ways;
+        std::set<id_t> _relations;
+        std::time_t _lastDrain = 0;
+    };
+
+    /**
+     * Exception that can appear inside the `GeometryUpdateQueue` class.
+     */
+    class GeometryUpdateQueueException final : public std::exception {
+        std::string message;
+    public:
+        explicit GeometryUpdateQueueException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::osm
+
+#endif //OSM_LIVE_UPDATES_GEOMETRYUPDATEQUEUE_H
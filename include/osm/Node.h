@@ -38,6 +38,12 @@ namespace olu::osm {
          */
         [[nodiscard]] std::string getXml() const;
 
+        /**
+         * Appends the node as a xml osm object to `output`, so that the buffer can be reused for
+         * many objects.
+         */
+        void writeXml(std::string &output) const;
+
         [[nodiscard]] osmium::Location getLocation() const { return loc; };
         [[nodiscard]] id_t getId() const { return id; };
     protected:
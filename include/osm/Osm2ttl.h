@@ -28,10 +28,16 @@ namespace olu::osm {
     public:
         // Converts osm data to ttl triplets
         static std::filesystem::path convert() ;
+
+        // Sorts the temporary node, way and relation files and merges them into the input file
+        // for osm2rdf
+        static void writeToInputFile();
+
+        // Converts the already sorted input file to ttl triplets
+        static std::filesystem::path convertInputFile();
     private:
         template <typename T>
         static void run(const osm2rdf::config::Config& config);
-        static void writeToInputFile();
         static void clearInputFile();
     };
 
@@ -19,12 +19,17 @@
 #ifndef OSM_LIVE_UPDATES_OSMCHANGEHANDLER_H
 #define OSM_LIVE_UPDATES_OSMCHANGEHANDLER_H
 
+#include "osm/ChangeCompactor.h"
+#include "osm/GeometryUpdateQueue.h"
 #include "osm/Osm2ttl.h"
 #include "osm/OsmDataFetcher.h"
+#include "osm/UpdateJournal.h"
 #include "sparql/SparqlWrapper.h"
 #include "config/Config.h"
 #include "osm2rdf/util/ProgressBar.h"
+#include <functional>
 #include <set>
+#include <vector>
 #include <boost/property_tree/ptree.hpp>
 
 
@@ -41,16 +46,66 @@ namespace olu::osm {
      */
     class OsmChangeHandler {
     public:
-        explicit OsmChangeHandler(const config::Config &config);
+        /**
+         * @param createdObjects Objects that did not exist before the change file. They are
+         * treated as created even if they are in the `modify` section of the change file, which
+         * is the case for objects that were created and modified in the merged change files.
+         */
+        explicit OsmChangeHandler(const config::Config &config,
+                                  CreatedObjects createdObjects = {});
         void run();
+
+        /**
+         * Applies the pending update in the journal directory of the config to all targets,
+         * starting for each target with the first batch it has not acknowledged, and saves the
+         * geometry update queue of that update.
+         *
+         * @throw OsmChangeHandlerException if the journal can not be read or was written for
+         * other update targets
+         */
+        void resume();
+
+        /**
+         * Filters the triples in the given ttl file that osm2rdf generated. Only triples whose
+         * subject is one of the given nodes, ways or relations are kept, together with the
+         * triples of the objects they link to, like their geometry or members.
+         */
+        static std::vector<Triple> filterRelevantTriples(const std::filesystem::path &ttlFile,
+                                                         const std::set<id_t> &nodesToInsert,
+                                                         const std::set<id_t> &waysToInsert,
+                                                         const std::set<id_t> &relationsToInsert);
     private:
+        /**
+         * An endpoint the update is applied to. Each target writes its own queries, because the
+         * graph can differ between the targets, and keeps track of its own progress.
+         */
+        struct EndpointTarget {
+            explicit EndpointTarget(const config::Config &config)
+                : endpointUri(config.sparqlEndpointUriForUpdates), sparql(config),
+                  queryWriter(config) { }
+
+            std::string endpointUri;
+            sparql::SparqlWrapper sparql;
+            sparql::QueryWriter queryWriter;
+            // Number of update queries that were applied to the target
+            std::size_t appliedQueries = 0;
+            // Number of times an update query had to be retried
+            std::size_t retries = 0;
+            // Message of the exception that stopped the update of the target, empty if none
+            std::string error;
+        };
+
         config::Config _config;
-        sparql::SparqlWrapper _sparql;
-        sparql::QueryWriter _queryWriter;
+        // The first target is the endpoint for updates of the config, followed by the
+        // additional update targets
+        std::vector<EndpointTarget> _targets;
         OsmDataFetcher _odf;
+        GeometryUpdateQueue _geometryQueue;
 
         // The xml element of the change file is stored here while processing the change file
         boost::property_tree::ptree _osmChangeElement;
+        // Objects in the modify section of the change file that are treated as created
+        CreatedObjects _createdObjects;
 
         // Nodes that are in a delete-changeset in the change file.
         std::set<id_t> _deletedNodes;
@@ -88,6 +143,14 @@ namespace olu::osm {
         // meaning they have to be fetched from the database
         std::set<id_t> _referencedRelations;
 
+        // Number of ways and relations whose geometry update was deferred to the geometry queue
+        // in this run
+        std::size_t _deferredWays = 0;
+        std::size_t _deferredRelations = 0;
+
+        // Number of triples that were inserted into the database in this run
+        std::size_t _insertedTriples = 0;
+
         /**
         * @Returns TRUE if the node with the given ID is contained in a `create`, `modify` or
          * 'delete' changeset in the changeFile.
@@ -155,6 +218,17 @@ namespace olu::osm {
         void getIdsOfRelationsToUpdateGeo();
         void getIdsOfWaysToUpdateGeo();
 
+        /**
+         * Moves the ways and relations of which the geometry needs to be updated onto the
+         * geometry update queue. If the queue is due to be drained, all queued objects are moved
+         * back into `_waysToUpdateGeometry` and `_relationsToUpdateGeometry` instead, so that
+         * their geometry is updated in this run.
+         *
+         * Objects that are contained in the change file are removed from the queue, because they
+         * are updated anyway.
+         */
+        void deferGeometryUpdates();
+
         /**
          * Fetches the ids of relations that are referenced in relations which geometry will be
          * changed in this update process and stores them in the corresponding set
@@ -181,7 +255,8 @@ namespace olu::osm {
         static void finalizeTmpFile(const std::string& filepath) ;
 
         /**
-         * Writes the given osm element to its corresponding temporary file
+         * Writes the given osm element to its corresponding temporary file. `element` can also
+         * hold several elements that are separated by newlines.
          */
         static void addToTmpFile(const std::string& element, const std::string& elementTag) ;
 
@@ -212,35 +287,71 @@ namespace olu::osm {
         void createDummyRelations(osm2rdf::util::ProgressBar &progress, size_t &counter);
 
         /**
-         * Send a SPARQL update query to the endpoint
+         * Send a SPARQL update query to the endpoint of the target. A failed query is retried
+         * `updateRetries` times, which is safe because deleting or inserting the same triples
+         * twice has no further effect.
+         *
+         * @param kind The name of the `QueryWriter` method that created the query, used for the
+         * request trace
+         * @param batchSize The number of elements or triples the query was written for
+         */
+        void runUpdateQuery(EndpointTarget &target, const std::string& query,
+                            const std::vector<std::string> &prefixes,
+                            const std::string &kind, std::size_t batchSize) const;
+
+        /**
+         * Calls `apply` for every target that has not failed yet, concurrently if there is more
+         * than one target. If `apply` throws, the target is marked as failed and the other
+         * targets carry on.
+         *
+         * @param count The number of elements or triples each target has to process, used for
+         * the progress bar
          */
-        void runUpdateQuery(const std::string& query, const std::vector<std::string> &prefixes);
+        void applyToTargets(std::size_t count,
+                            const std::function<void(EndpointTarget &target,
+                                                     osm2rdf::util::ProgressBar &progress,
+                                                     size_t &counter)> &apply);
 
         /**
-         * Delete all relevant triples from the database, while showing a progress bar on std::cout
+         * Writes the progress of each target to the run report and throws if the update of a
+         * target failed.
          */
-        void deleteTriplesFromDatabase();
+        void checkTargets() const;
 
         /**
-         * Send SPARQL queries to delete all triples that belong to the nodes in _deletedNodes
+         * Reads the change file into `_osmChangeElement`
          */
-        void deleteNodesFromDatabase(osm2rdf::util::ProgressBar &progress, size_t &counter);
+        void readChangeFile();
 
         /**
-         * Send SPARQL queries to delete all triples that belong to the ways in _deletedWays
+         * Splits all objects whose triples have to be deleted from the databases into batches
          */
-        void deleteWaysFromDatabase(osm2rdf::util::ProgressBar &progress, size_t &counter);
+        [[nodiscard]] std::vector<UpdatePlan::DeleteBatch> getDeleteBatches() const;
 
         /**
-         * Send SPARQL queries to delete all triples that belong to the relations in
-         * _deletedRelations
-        */
-        void deleteRelationsFromDatabase(osm2rdf::util::ProgressBar &progress, size_t &counter);
+         * Filters the relevant triples and splits them into batches that are inserted into the
+         * databases. Triples with a blank node as object are combined with the triples of the
+         * blank node.
+         */
+        std::vector<UpdatePlan::InsertBatch> getInsertBatches();
+
+        /**
+         * Sends the batches of the plan to all targets, while showing a progress bar on
+         * std::cout. If a journal is given, batches that a target already acknowledged are
+         * skipped and each applied batch is acknowledged.
+         */
+        void applyPlan(const UpdatePlan &plan, UpdateJournal *journal);
+
+        /**
+         * Clears the cache of all targets that applied the update and throws if one of them
+         * failed.
+         */
+        void finishTargets();
 
         /**
-         * Send SPARQL queries to insert all relevant triples
+         * @return The endpoint uris of all targets, in the order in which they are journaled
          */
-        void insertTriplesToDatabase();
+        [[nodiscard]] std::vector<std::string> getTargetUris() const;
 
         /**
          * Filters the triples that where generated by osm2rdf. Relevant triples are triples for osm
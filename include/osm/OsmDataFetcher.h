@@ -27,8 +27,10 @@
 #include "util/Types.h"
 #include "sparql/QueryWriter.h"
 
+#include <map>
 #include <set>
 #include <string>
+#include <string_view>
 
 namespace olu::osm {
 
@@ -157,6 +159,35 @@ namespace olu::osm {
          */
         std::vector<id_t> fetchRelationsReferencingRelations(const std::set<id_t> &relationIds);
 
+        /**
+         * Fetches the versions that are stored for the given objects. `osmTag` is the prefix of
+         * the objects, for example `osmnode`.
+         *
+         * @return The stored version of each object. Objects that are not in the database or
+         * have no version are left out.
+         */
+        std::map<id_t, std::size_t> fetchVersions(const std::set<id_t> &ids,
+                                                  const std::string &osmTag);
+
+        /**
+         * Decodes the `GROUP_CONCAT` lists of node uris and positions of a way. The lists are
+         * separated by ';' and are split without copying their elements.
+         *
+         * @return The node ids ordered by their position. If a position occurs more than once, only
+         * the first node with that position is kept.
+         * @throw OsmDataFetcherException if a position is missing or not a number
+         */
+        static std::vector<id_t> decodeWayMembers(std::string_view nodeUris,
+                                                  std::string_view nodePositions);
+
+        /**
+         * Decodes the `GROUP_CONCAT` lists of member uris, roles and positions of a relation, like
+         * `decodeWayMembers`.
+         */
+        static std::vector<RelationMember> decodeRelationMembers(std::string_view memberUris,
+                                                                 std::string_view memberRoles,
+                                                                 std::string_view memberPositions);
+
     private:
         config::Config _config;
         sparql::SparqlWrapper _sparqlWrapper;
@@ -171,8 +202,17 @@ namespace olu::osm {
          */
         static OsmDatabaseState extractStateFromStateFile(const std::string& stateFile);
 
-        boost::property_tree::ptree runQuery(const std::string &query,
-                                             const std::vector<std::string> &prefixes);
+        /**
+         * Sends the query to the SPARQL endpoint.
+         *
+         * @param kind The name of the `QueryWriter` method that created the query, used for the
+         * request trace
+         * @param batchSize The number of elements the query was written for
+         */
+        boost::property_tree::ptree runQuery(std::string query,
+                                             const std::vector<std::string> &prefixes,
+                                             const std::string &kind,
+                                             std::size_t batchSize);
     };
 
     /**
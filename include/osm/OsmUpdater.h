@@ -8,8 +8,14 @@
 #include <iostream>
 
 #include "config/Config.h"
+#include "osm/ChangeCompactor.h"
 #include "osm/OsmDatabaseState.h"
 #include "osm/OsmDataFetcher.h"
+#include "util/MetricsServer.h"
+#include "util/Region.h"
+
+#include <memory>
+#include <optional>
 
 namespace olu::osm {
 
@@ -23,6 +29,9 @@ namespace olu::osm {
     class OsmUpdater {
     public:
         explicit OsmUpdater(const config::Config &config);
+        ~OsmUpdater();
+        OsmUpdater(const OsmUpdater&) = delete;
+        OsmUpdater& operator=(const OsmUpdater&) = delete;
 
         /// Starts the update process.
         void run();
@@ -30,6 +39,9 @@ namespace olu::osm {
         config::Config _config;
         OsmDataFetcher _odf;
         OsmDatabaseState _latestState;
+        std::unique_ptr<util::MetricsServer> _metricsServer;
+        // The region the change files are clipped to, if the user specified one
+        std::optional<util::Region> _region;
 
         /**
          * Decides which sequence number to start from.
@@ -56,9 +68,13 @@ namespace olu::osm {
         void fetchChangeFiles(int sequenceNumber);
 
         /**
-        * Uses osmium to merge all change files in the /changes directory into a single one.
+        * Uses osmium to merge all change files in the /changes directory into a single one. Only
+        * the net effect of each object is written, see `ChangeCompactor`. If a region is given,
+        * only the objects inside the region are written to the merged file.
+        *
+        * @return The objects that did not exist before the merged change files
         */
-        static void mergeChangeFiles(const std::string &pathToChangeFileDir);
+        CreatedObjects mergeChangeFiles(const std::string &pathToChangeFileDir);
 
         /**
         * Delete all files in the /changes dir
@@ -69,6 +85,17 @@ namespace olu::osm {
         * Delete /tmp dir
         */
         static void deleteTmpDir();
+
+        /**
+        * Writes the run report to the file given in the config, if there is one
+        */
+        void writeRunReport() const;
+
+        /**
+        * Publishes the sequence number and timestamp of the latest state the database was updated
+        * to on the metrics endpoint
+        */
+        void publishReplicationState() const;
     };
 
     /**
@@ -0,0 +1,105 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_REGIONCLIPPER_H
+#define OSM_LIVE_UPDATES_REGIONCLIPPER_H
+
+#include "osm/Node.h"
+#include "util/Region.h"
+#include "util/Types.h"
+
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <osmium/osm/object.hpp>
+
+namespace olu::osm {
+
+    /**
+     * Removes the objects that lie outside of a region from a change file, so that a database
+     * that only holds an extract can be updated with the change files of the whole planet.
+     *
+     * - Nodes are kept if their location lies inside the region.
+     * - Ways are kept if one of their nodes lies inside the region. Nodes that are not part of
+     *   the change file are looked up in the database. Nodes that are not in the database are
+     *   treated as outside of the region.
+     * - Relations are kept if one of their members is kept. As the location of a way or
+     *   relation that is not part of the change file is not known, relations with such members
+     *   are kept as well.
+     * - Deleted objects are always kept, because they do not have a location. Deleting an object
+     *   that is not in the database does not change it.
+     * - Changed objects that would be dropped are kept if the database contains them, because
+     *   their stored version can lie inside the region, for example if a node was moved out of
+     *   the region. Only objects with a version greater than one are looked up.
+     *
+     * Additionally, all members of the kept objects that are part of the change file are kept,
+     * so that the change file stays complete for the objects that are processed.
+     */
+    class RegionClipper {
+    public:
+        // Returns the nodes with the given ids that are in the database
+        using NodeLookup = std::function<std::vector<Node>(const std::set<id_t> &nodeIds)>;
+        // Returns the ids of the objects with the given type and ids that the database contains
+        using StoredLookup = std::function<std::set<id_t>(osmium::item_type type,
+                                                          const std::set<id_t> &ids)>;
+
+        RegionClipper(const util::Region &region, NodeLookup lookup, StoredLookup storedLookup)
+            : _region(region), _lookup(std::move(lookup)),
+              _storedLookup(std::move(storedLookup)) {}
+
+        /**
+         * @param objects The objects of the change file. Each object must appear only once.
+         * @return The objects that are kept, in the same order as in `objects`
+         */
+        [[nodiscard]] std::vector<const osmium::OSMObject*>
+        clip(const std::vector<const osmium::OSMObject*> &objects);
+
+        [[nodiscard]] std::size_t getNumberOfLookedUpNodes() const { return _lookedUpNodes; }
+
+        /**
+         * @return The number of objects outside the region that were kept because the database
+         * contains them
+         */
+        [[nodiscard]] std::size_t getNumberOfKeptStoredObjects() const {
+            return _keptStoredObjects;
+        }
+
+        // Maximum number of nodes or objects that are looked up with a single request
+        static constexpr std::size_t MAX_NODES_PER_LOOKUP = 1024;
+        static constexpr std::size_t MAX_OBJECTS_PER_LOOKUP = 1024;
+    private:
+        const util::Region &_region;
+        NodeLookup _lookup;
+        StoredLookup _storedLookup;
+        std::size_t _lookedUpNodes = 0;
+        std::size_t _keptStoredObjects = 0;
+
+        /**
+         * Adds the objects with the given type and ids that the database contains to `kept`
+         */
+        void keepStoredObjects(osmium::item_type type, const std::set<id_t> &ids,
+                               std::unordered_set<id_t> &kept);
+    };
+
+} // namespace olu::osm
+
+#endif //OSM_LIVE_UPDATES_REGIONCLIPPER_H
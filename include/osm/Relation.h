@@ -22,19 +22,27 @@
 #include "util/Types.h"
 
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <set>
 
 namespace olu::osm {
 
+    enum class OsmObjectType { NODE, WAY, RELATION };
+
+    /**
+     * @return The osm xml tag for the given type, for example `node` for `OsmObjectType::NODE`
+     */
+    std::string_view getOsmTag(OsmObjectType type);
+
     struct RelationMember {
         id_t id;
-        std::string osmTag;
+        OsmObjectType type;
         std::string role;
 
-        RelationMember(const id_t id, const std::string &osmTag, const std::string &role) :
-        id(id), osmTag(osmTag), role(role) {}
+        RelationMember(const id_t id, const OsmObjectType type, std::string role) :
+        id(id), type(type), role(std::move(role)) {}
     };
 
     class Relation {
@@ -45,6 +53,7 @@ namespace olu::osm {
         void setTimestamp(std::string const& timestamp);
 
         void addMember(const RelationMember& member);
+        void setMembers(std::vector<RelationMember> members);
         void addTag(const std::string& key, const std::string& value);
 
         /**
@@ -62,6 +71,12 @@ namespace olu::osm {
          */
         [[nodiscard]] std::string getXml() const;
 
+        /**
+         * Appends the relation as a xml osm object to `output`, so that the buffer can be reused
+         * for many objects.
+         */
+        void writeXml(std::string &output) const;
+
         std::vector<RelationMember> getMembers() { return members; }
         [[nodiscard]] id_t getId() const { return id; }
         std::vector<KeyValue> getTags() { return tags; }
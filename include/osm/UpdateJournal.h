@@ -0,0 +1,170 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_UPDATEJOURNAL_H
+#define OSM_LIVE_UPDATES_UPDATEJOURNAL_H
+
+#include "util/Types.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace olu::osm {
+
+    /**
+     * The SPARQL updates of a run, split into the batches that are sent to the endpoints. The
+     * delete batches are sent before the insert batches. Batches are numbered across both lists,
+     * so the first insert batch has the number `deleteBatches.size()`.
+     */
+    struct UpdatePlan {
+        struct DeleteBatch {
+            // Prefix of the uris of the objects, one of `osmnode`, `osmway` and `osmrel`
+            std::string osmTag;
+            std::set<id_t> ids;
+        };
+
+        struct InsertBatch {
+            std::vector<std::string> triples;
+            // Number of triples osm2rdf generated for this and all previous batches, which can
+            // be more than the number of entries in `triples` because triples with blank nodes
+            // are combined into one entry
+            std::size_t processedTriples = 0;
+        };
+
+        std::vector<DeleteBatch> deleteBatches;
+        std::vector<InsertBatch> insertBatches;
+
+        [[nodiscard]] std::size_t getNumberOfBatches() const {
+            return deleteBatches.size() + insertBatches.size();
+        }
+
+        [[nodiscard]] std::size_t getNumberOfDeletedObjects() const;
+
+        [[nodiscard]] std::size_t getNumberOfInsertedTriples() const {
+            return insertBatches.empty() ? 0 : insertBatches.back().processedTriples;
+        }
+    };
+
+    /**
+     * Durable record of the update of a run, so that an update that was interrupted by a crash
+     * can be resumed instead of leaving the database half updated.
+     *
+     * The journal directory contains the plan of the update, which lists the update targets and
+     * all batches, and a log with one line `TARGET BATCH` for each batch that a target
+     * acknowledged. Both are synced to disk before the next batch is sent. Because a batch can be
+     * applied by the endpoint without being acknowledged in the log, a resumed update sends that
+     * batch again. This is harmless for the delete batches and the plain triples, but the triples
+     * of a blank node in that batch are inserted twice.
+     *
+     * The plan is only considered pending once it is completely written, and the journal is
+     * removed with `complete()` after all targets applied the update.
+     */
+    class UpdateJournal {
+    public:
+        explicit UpdateJournal(std::filesystem::path directory);
+        ~UpdateJournal();
+
+        UpdateJournal(const UpdateJournal &) = delete;
+        UpdateJournal& operator=(const UpdateJournal &) = delete;
+
+        /**
+         * @return True if the directory contains the plan of an update that was not completed
+         */
+        [[nodiscard]] static bool hasPendingPlan(const std::filesystem::path &directory);
+
+        /**
+         * Durably writes the plan for the given targets and starts recording the acknowledged
+         * batches. An earlier plan in the directory is replaced.
+         */
+        void begin(const UpdatePlan &plan, const std::vector<std::string> &targets);
+
+        /**
+         * Reads the pending plan and the batches that were already acknowledged.
+         *
+         * @throw UpdateJournalException if the plan was written for other targets or can not be
+         * read
+         */
+        [[nodiscard]] UpdatePlan resume(const std::vector<std::string> &targets);
+
+        /**
+         * @return The number of the first batch the target with the given index has not
+         * acknowledged yet
+         */
+        [[nodiscard]] std::size_t getFirstPendingBatch(std::size_t target) const;
+
+        /**
+         * Durably records that the target with the given index applied the batch. Can be called
+         * from several threads at the same time.
+         */
+        void acknowledge(std::size_t target, std::size_t batch);
+
+        /**
+         * Removes the plan and the log after the update was applied to all targets.
+         */
+        void complete();
+
+        /**
+         * Path to the snapshot of the geometry update queue that has to be saved once the
+         * update is completed. The snapshot is written by the caller before `begin()`.
+         */
+        [[nodiscard]] std::filesystem::path getGeometryQueuePath() const {
+            return _directory / GEOMETRY_QUEUE_FILE;
+        }
+    private:
+        static inline const std::string PLAN_FILE = "plan";
+        static inline const std::string ACK_FILE = "acks";
+        static inline const std::string GEOMETRY_QUEUE_FILE = "geometryQueue";
+
+        std::filesystem::path _directory;
+        // File descriptor of the log of acknowledged batches, -1 if it is not open
+        int _ackFile = -1;
+        std::vector<std::size_t> _firstPendingBatches;
+        mutable std::mutex _mutex;
+
+        void openAckFile();
+        void closeAckFile();
+        /**
+         * Reads the acknowledged batches of each target from the log.
+         *
+         * @return The length of the log up to the end of its last complete line
+         * @throw UpdateJournalException if a line does not name a target and a batch of the plan
+         */
+        std::size_t readAckFile(std::size_t numberOfBatches);
+    };
+
+    /**
+     * Exception that can appear inside the `UpdateJournal` class.
+     */
+    class UpdateJournalException final : public std::exception {
+        std::string message;
+    public:
+        explicit UpdateJournalException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::osm
+
+#endif //OSM_LIVE_UPDATES_UPDATEJOURNAL_H
@@ -33,6 +33,7 @@ namespace olu::osm {
         void setTimestamp(std::string const& timestamp);
 
         void addMember(id_t nodeId);
+        void setMembers(std::vector<id_t> nodeIds);
         void addTag(const std::string& key, const std::string& value);
 
         /**
@@ -43,6 +44,12 @@ namespace olu::osm {
         */
         [[nodiscard]] std::string getXml() const;
 
+        /**
+         * Appends the way as a xml osm object to `output`, so that the buffer can be reused for
+         * many objects.
+         */
+        void writeXml(std::string &output) const;
+
         std::vector<id_t> getMembers() { return members; }
         [[nodiscard]] id_t getId() const { return id; }
         std::vector<KeyValue> getTags() { return tags; }
@@ -23,6 +23,7 @@
 #include "config/Config.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 
@@ -33,7 +34,7 @@ namespace olu::sparql {
      */
     class QueryWriter {
     public:
-        explicit QueryWriter(config::Config  config): _config(std::move(config)) { }
+        explicit QueryWriter(config::Config config);
 
         /**
          * @returns A SPARQL query that inserts a list of triples in to the database
@@ -96,14 +97,61 @@ namespace olu::sparql {
         */
         [[nodiscard]] std::string writeQueryForRelationsReferencingRelations(const std::set<id_t> &relationIds) const;
 
+        /**
+        * @returns A SPARQL query for the versions that are stored for the objects with the given
+        * ids. `osmTag` is the prefix of the objects, for example `osmnode`.
+        */
+        [[nodiscard]] std::string writeQueryForVersions(const std::set<id_t> &ids,
+                                                        const std::string &osmTag) const;
+
         /**
         * @returns A SPARQL query for tags and timestamp of the given subject
         */
         [[nodiscard]] std::string writeQueryForTagsAndTimestamp(const std::string &subject) const;
 
         private:
+        /**
+         * The static parts of a query before and after its list of values. They include the
+         * graph from the config and are computed once when the writer is created.
+         */
+        struct QueryTemplate {
+            std::string head;
+            std::string tail;
+        };
+
+        /**
+         * The static parts of a query that contains the same subject twice.
+         */
+        struct SubjectTemplate {
+            std::string head;
+            std::string middle;
+            std::string tail;
+        };
+
         config::Config _config;
 
+        QueryTemplate _insertTemplate;
+        QueryTemplate _deleteTemplate;
+        QueryTemplate _nodeLocationsTemplate;
+        QueryTemplate _relationsTemplate;
+        QueryTemplate _waysMembersTemplate;
+        QueryTemplate _referencedNodesTemplate;
+        QueryTemplate _relationMembersTemplate;
+        QueryTemplate _waysReferencingNodesTemplate;
+        QueryTemplate _relationsReferencingNodesTemplate;
+        QueryTemplate _relationsReferencingWaysTemplate;
+        QueryTemplate _relationsReferencingRelationsTemplate;
+        QueryTemplate _versionsTemplate;
+        SubjectTemplate _tagsAndTimestampTemplate;
+
+        /**
+         * @returns The query of the template with `valuePrefix` and the id for each of the ids,
+         * separated by spaces, between its head and tail
+         */
+        static std::string fillTemplate(const QueryTemplate &queryTemplate,
+                                        std::string_view valuePrefix,
+                                        const std::set<id_t> &ids);
+
         [[nodiscard]] std::string getFromClauseOptional() const;
 
         [[nodiscard]] std::string wrapWithGraphOptional(const std::string& clause) const;
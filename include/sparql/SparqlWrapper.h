@@ -20,7 +20,16 @@
 #define OSM_LIVE_UPDATES_SPARQLWRAPPER_H
 
 #include "config/Config.h"
-
+#include "util/HttpRequest.h"
+#include "util/ReplicaPool.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <vector>
 #include <boost/property_tree/ptree.hpp>
@@ -28,9 +37,30 @@
 namespace olu::sparql {
 
     /**
-     * Wrapper class that handles communication with a SPARQL endpoint. In order to successfully
-     * send a request to the SPARQL endpoint, the prefixes, query and method must be set with the
-     * corresponding functions. Then the request can be sent with `runQuery`.
+     * A single request to the SPARQL endpoint. The request owns its query, so that it can be
+     * moved into the request without copying it.
+     */
+    struct SparqlRequest {
+        std::string query;
+
+        // The prefixes are not copied and have to outlive the request. They are usually one of
+        // the prefix lists in `config/Constants.h`.
+        std::span<const std::string> prefixes;
+
+        // The name of the `QueryWriter` method that created the query and the number of elements
+        // the query was written for. Both are only used for the request trace.
+        std::string kind;
+        std::size_t batchSize = 0;
+    };
+
+    /**
+     * Wrapper class that handles communication with a SPARQL endpoint. Requests are described by
+     * a `SparqlRequest` and sent with `runQuery` or `runUpdate`. The wrapper does not keep any
+     * state between requests, so a single instance can send requests from several threads at
+     * the same time.
+     *
+     * Queries are balanced across the main endpoint and the read replicas of the config, and can
+     * be hedged. Updates are always sent to the endpoint for updates.
      *
      * This class will currently only work with QLever SPARQL endpoints.
      *
@@ -40,18 +70,7 @@ namespace olu::sparql {
      */
     class SparqlWrapper {
     public:
-        explicit SparqlWrapper(config::Config  config): _config(std::move(config)) { }
-
-        /**
-         * Sets the query to send to the SPARQL endpoint. The prefixes must be set
-         * with `setPrefixes`.
-         */
-        void setQuery(const std::string& query);
-
-        /**
-         * Sets the prefixes for the query to send to the SPARQL endpoint.
-         */
-        void setPrefixes(const std::vector<std::string> &prefixes);
+        explicit SparqlWrapper(config::Config config);
 
         /**
          * Sends a request to clear the cache of the SPARQL endpoint.
@@ -63,26 +82,74 @@ namespace olu::sparql {
          *
          * @return The response from the SPARQL endpoint.
          */
-        boost::property_tree::ptree runQuery();
+        [[nodiscard]] boost::property_tree::ptree runQuery(const SparqlRequest &request) const;
 
         /**
          * Sends a POST request with the encoded prefixes and the update query as body to the SPARQL
          * endpoint.
+         */
+        void runUpdate(const SparqlRequest &request) const;
+
+        /**
+         * Extracts the time the QLever endpoint needed to compute the result from a JSON
+         * response. QLever reports the time as a string like "12ms" or as a number of
+         * milliseconds.
          *
-         * @return The response from the SPARQL endpoint.
+         * @return The time in milliseconds or nothing if the response does not contain one
          */
-        void runUpdate();
+        static std::optional<double> getServerTime(const std::string &response);
     private:
         config::Config _config;
-        std::string _query;
-        std::string _prefixes;
+        // Queries are balanced across the main endpoint and the read replicas. The pools are
+        // shared between copies of the wrapper so that they see the same outstanding requests.
+        std::shared_ptr<util::ReplicaPool> _readReplicas;
+        std::shared_ptr<util::ReplicaPool> _updateEndpoint;
+
+        // Serializes the appends to the query output file
+        static inline std::mutex _outputFileMutex;
+
+        /**
+         * A prefix list and its URL encoding, which is appended to the body of each request.
+         */
+        struct EncodedPrefixes {
+            std::vector<std::string> prefixes;
+            std::string encoded;
+        };
+
+        // The prefix lists that were encoded before, by their address. The prefixes are usually
+        // one of the constant lists, so each list is only encoded once.
+        static inline std::shared_mutex _encodedPrefixesMutex;
+        static inline std::map<const std::string*, EncodedPrefixes> _encodedPrefixes;
+        // Maximum number of prefix lists whose encoding is kept
+        static constexpr std::size_t MAX_ENCODED_PREFIX_LISTS = 64;
+
+        /**
+         * Appends the URL encoded prefixes, each followed by an encoded space, to `body`.
+         */
+        static void appendEncodedPrefixes(std::span<const std::string> prefixes,
+                                          std::string &body);
 
-        void writeQueryToFileOutput() const;
+        void writeQueryToFileOutput(const SparqlRequest &request) const;
 
         /**
          * Sends a HTTP request to the sparql endpoint.
          */
-        std::string send(const std::string& acceptValue, bool isUpdate);
+        [[nodiscard]] std::string send(const SparqlRequest &request,
+                                       const std::string& acceptValue, bool isUpdate) const;
+
+        /**
+         * Sends the body to the replica with the fewest outstanding requests. If `hedge` is set,
+         * the body is also sent to a second replica once the request takes longer than the
+         * hedge delay of the pool.
+         */
+        [[nodiscard]] static std::string sendToReplica(util::ReplicaPool &replicas, bool hedge,
+                                                       const std::string &acceptValue,
+                                                       const std::string &body,
+                                                       const std::string &traceKind,
+                                                       std::size_t batchSize);
+
+        static void setupRequest(util::HttpRequest &request, const std::string &acceptValue,
+                                 const std::string &body);
     };
 
     /**
@@ -0,0 +1,114 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_CHANGEFILEGENERATOR_H
+#define OSM_LIVE_UPDATES_CHANGEFILEGENERATOR_H
+
+#include "util/Types.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Relative weights of the kinds of edits in a generated change file. The weights do not need
+     * to sum up to one.
+     */
+    struct ChangeFileMix {
+        // Modified nodes with a new location
+        double nodeMoves = 0.35;
+        // Modified nodes and ways where only the tags changed
+        double tagEdits = 0.25;
+        // Modified ways with a new list of nodes
+        double wayRewires = 0.2;
+        // Modified relations of type multipolygon
+        double multipolygonEdits = 0.05;
+        // Deleted nodes, ways and relations
+        double deletes = 0.15;
+    };
+
+    /**
+     * Generates synthetic files in osm change format for tests and benchmarks.
+     *
+     * The generated files are self-contained: Ways only reference nodes and multipolygons only
+     * reference ways that are modified in the same file, so that no references have to be fetched
+     * from the SPARQL endpoint. The output is deterministic for the same seed.
+     */
+    class ChangeFileGenerator {
+    public:
+        /**
+         * @param numObjects Number of osm objects the change file should contain
+         * @param mix Relative weights of the kinds of edits
+         * @param seed Seed for the random number generator
+         */
+        explicit ChangeFileGenerator(std::size_t numObjects, ChangeFileMix mix = {},
+                                     unsigned int seed = 42);
+
+        /**
+         * @return The content of the generated change file
+         */
+        std::string generate();
+
+        /**
+         * Writes the content to the given path. The content is compressed with gzip if the path
+         * ends with `.gz`.
+         */
+        static void write(const std::string &content, const std::filesystem::path &path);
+    private:
+        std::size_t _numObjects;
+        ChangeFileMix _mix;
+        std::mt19937 _random;
+
+        id_t _nextNodeId = 1;
+        id_t _nextWayId = 1;
+        id_t _nextRelationId = 1;
+
+        // Ids of nodes and ways that are modified in the generated file and can be referenced
+        std::vector<id_t> _nodePool;
+        std::vector<id_t> _wayPool;
+        std::vector<id_t> _closedWayPool;
+
+        std::string _modifiedNodes;
+        std::string _deletedNodes;
+        std::string _modifiedWays;
+        std::string _deletedWays;
+        std::string _modifiedRelations;
+        std::string _deletedRelations;
+
+        std::size_t writeNodeMove();
+        std::size_t writeTagEdit();
+        std::size_t writeWayRewire();
+        std::size_t writeMultipolygonEdit();
+        std::size_t writeDelete();
+
+        void writeNode(std::string &out, id_t id, bool withTags);
+        void writeWay(std::string &out, id_t id, const std::vector<id_t> &nodeIds,
+                      bool withTags);
+
+        std::string getAttributes(id_t id);
+        std::string getRandomLocation();
+        std::size_t getRandomIndex(std::size_t size);
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_CHANGEFILEGENERATOR_H
@@ -0,0 +1,118 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_CHROMETRACE_H
+#define OSM_LIVE_UPDATES_CHROMETRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace olu::util {
+
+    /**
+     * Writes a timeline of an update run in the Chrome Trace Event format, which can be opened in
+     * Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+     *
+     * Each `ChromeTrace::Span` becomes a complete event with the id of the thread it was created
+     * on, so that waiting and serial sections of the run become visible. Events are appended to
+     * the file as soon as their span ends, so the trace of an aborted run can still be opened.
+     *
+     * The trace is process wide and disabled until `open()` is called. Spans that are created
+     * while it is disabled cost a single atomic load.
+     */
+    class ChromeTrace {
+    public:
+        /**
+         * Records the time from its construction until its destruction as one event.
+         */
+        class Span {
+        public:
+            /**
+             * @param name Name of the event, for example the phase or query kind
+             * @param category Category of the event, for example `phase` or `http`
+             */
+            Span(std::string name, std::string category);
+            ~Span();
+            Span(const Span&) = delete;
+            Span& operator=(const Span&) = delete;
+
+            /**
+             * Adds an argument that is shown with the event.
+             */
+            void addArg(const std::string &key, const std::string &value);
+            void addArg(const std::string &key, std::size_t value);
+        private:
+            bool _enabled;
+            std::string _name;
+            std::string _category;
+            std::string _args;
+            long _start = 0;
+        };
+
+        /**
+         * Opens the trace file at the given path. Existing content of the file is discarded.
+         */
+        static void open(const std::filesystem::path &path);
+
+        /**
+         * Terminates the event array and closes the trace file.
+         */
+        static void close();
+
+        /**
+         * @return TRUE if the trace file has been opened.
+         */
+        static bool isEnabled();
+    private:
+        static inline std::mutex _mutex;
+        static inline std::ofstream _file;
+        static inline std::atomic<bool> _enabled = false;
+        static inline std::atomic<std::size_t> _nextThreadId = 1;
+        static inline const std::chrono::steady_clock::time_point _startTime =
+            std::chrono::steady_clock::now();
+
+        // Microseconds since the process started
+        static long now();
+
+        // Small sequential id of the calling thread, which is easier to read than the native one
+        static std::size_t getThreadId();
+
+        static void writeEvent(const std::string &event);
+    };
+
+    /**
+     * Exception that can appear inside the `ChromeTrace` class.
+     */
+    class ChromeTraceException final : public std::exception {
+        std::string message;
+    public:
+        explicit ChromeTraceException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_CHROMETRACE_H
@@ -21,21 +21,99 @@
 
 #include "util/HttpMethod.h"
 
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <curl/curl.h>
 
 namespace olu::util {
 
+    /**
+     * Timing breakdown of a performed request in milliseconds, as reported by libcurl.
+     */
+    struct RequestTimings {
+        // Time for the name lookup
+        double nameLookup = 0;
+        // Time for the TCP connect after the name lookup
+        double connect = 0;
+        // Time for the TLS handshake after the TCP connect, zero for plain HTTP
+        double tls = 0;
+        // Time from the start until the first byte of the response was received
+        double firstByte = 0;
+        // Total time of the request
+        double total = 0;
+    };
+
+    /**
+     * Receives the chunks of a response in the order they arrive. A chunk is only valid during
+     * the call.
+     */
+    using ResponseSink = std::function<void(std::string_view chunk)>;
+
     class HttpRequest {
     public:
         explicit HttpRequest(
                 const HttpMethod& method,
                 const std::string& url);
         ~HttpRequest();
+        // The curl handle writes into the request itself, so it can not be copied or moved
+        HttpRequest(const HttpRequest&) = delete;
+        HttpRequest& operator=(const HttpRequest&) = delete;
+
         void addHeader(const std::string& key, const std::string& value);
         void addBody(std::string body);
+
+        /**
+         * Passes the response to `sink` chunk by chunk instead of collecting it, for example to
+         * write it to a file or to feed it into an incremental parser. If the sink throws, the
+         * transfer is aborted and `perform()` rethrows the exception.
+         */
+        void setResponseSink(ResponseSink sink);
+
+        /**
+         * Sends the request.
+         *
+         * @return The response body, or an empty string if a response sink is set
+         */
         std::string perform();
+
+        /**
+         * Sends `primary` and, if it has not finished after `hedgeDelay`, sends a hedge request as
+         * well. Both requests usually ask different replicas the same query. The request that
+         * finishes successfully first wins, and the other one is aborted. A request fails if the
+         * transfer fails or the server answers with a status other than 2xx. A failed request
+         * only wins if the other one has also failed or was never started.
+         *
+         * @param makeHedge Called when the hedge is sent, returns the hedge request. The request
+         * has to stay alive until `performHedged` returns.
+         * @return The request that won. Its response is returned by `finish()`
+         */
+        static HttpRequest& performHedged(HttpRequest &primary,
+                                          std::chrono::milliseconds hedgeDelay,
+                                          const std::function<HttpRequest&()> &makeHedge);
+
+        /**
+         * Counts the transferred bytes and checks the result of a request that was sent with
+         * `performHedged`.
+         *
+         * @return The response body, or an empty string if a response sink is set
+         */
+        std::string finish();
+
+        /**
+         * @return The timing breakdown of the request. Only valid after `perform()` was called.
+         */
+        [[nodiscard]] RequestTimings getTimings() const;
+        [[nodiscard]] long getResponseCode() const;
+        [[nodiscard]] HttpMethod getMethod() const { return _method; }
+        [[nodiscard]] const std::string& getUrl() const { return _url; }
+        [[nodiscard]] std::size_t getRequestSize() const {
+            return _method == POST ? _body.size() : 0;
+        }
+        [[nodiscard]] std::size_t getResponseSize() const { return _responseSize; }
     private:
         CURL *_curl;
         HttpMethod _method;
@@ -43,6 +121,15 @@ namespace olu::util {
         std::string _url;
         std::string _data;
         std::string _body;
+        std::size_t _responseSize = 0;
+        ResponseSink _sink;
+        // Exception thrown while the response was received, rethrown after the transfer
+        std::exception_ptr _callbackException;
+
+        // Sets the options that depend on the headers and the body before the request is sent
+        void prepare();
+
+        static size_t writeCallback(char* contents, size_t size, size_t nmemb, void* userp);
 
         curl_slist *_chunk = nullptr;
     };
@@ -0,0 +1,36 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_JSONHELPER_H
+#define OSM_LIVE_UPDATES_JSONHELPER_H
+
+#include <string>
+#include <string_view>
+
+namespace olu::util {
+
+class JsonHelper {
+public:
+    // Escapes the given string so that it can be written between the quotes of a JSON string.
+    // Quotes, backslashes and control characters are escaped, all other bytes are kept.
+    static std::string escape(std::string_view value);
+};
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_JSONHELPER_H
@@ -0,0 +1,100 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_METRICS_H
+#define OSM_LIVE_UPDATES_METRICS_H
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace olu::util {
+
+    /**
+     * Process wide registry of gauges and counters that describe the progress of the update
+     * process. The values are rendered in the Prometheus text format and served by the
+     * `MetricsServer`.
+     *
+     * Series are identified by their name and an optional label string, for example
+     * `stage="delete"`.
+     */
+    class Metrics {
+    public:
+        /**
+         * Sets the gauge with the given name and labels to the value.
+         */
+        static void set(const std::string &name, double value, const std::string &labels = "");
+
+        /**
+         * Adds the value to the gauge or counter with the given name and labels.
+         */
+        static void add(const std::string &name, double value, const std::string &labels = "");
+
+        /**
+         * @return The current value of the series or zero if it was never set
+         */
+        static double get(const std::string &name, const std::string &labels = "");
+
+        /**
+         * Sets the timestamp of the last replication state that was applied to the database.
+         * The replication lag is computed from it each time the metrics are rendered.
+         *
+         * @param timestamp Timestamp in the format of the osm state files, for example
+         * `2024-08-02T10:00:33Z`
+         */
+        static void setReplicationTimestamp(const std::string &timestamp);
+
+        /**
+         * @return All series in the Prometheus text exposition format
+         */
+        static std::string render();
+
+        /**
+         * Increases the gauge with the given name while the object exists.
+         */
+        class InFlight {
+        public:
+            explicit InFlight(std::string name);
+            ~InFlight();
+            InFlight(const InFlight&) = delete;
+            InFlight& operator=(const InFlight&) = delete;
+        private:
+            std::string _name;
+        };
+
+        static inline const std::string SEQUENCE_NUMBER = "olu_sequence_number";
+        static inline const std::string REPLICATION_TIMESTAMP = "olu_replication_timestamp_seconds";
+        static inline const std::string REPLICATION_LAG = "olu_replication_lag_seconds";
+        static inline const std::string OBJECTS_PER_SECOND = "olu_objects_per_second";
+        static inline const std::string TRIPLES_PER_SECOND = "olu_triples_per_second";
+        static inline const std::string OBJECTS_TOTAL = "olu_objects_processed_total";
+        static inline const std::string TRIPLES_TOTAL = "olu_triples_inserted_total";
+        static inline const std::string SPARQL_IN_FLIGHT = "olu_sparql_requests_in_flight";
+        static inline const std::string SPARQL_REQUESTS_TOTAL = "olu_sparql_requests_total";
+        static inline const std::string SPARQL_HEDGED_REQUESTS_TOTAL =
+            "olu_sparql_hedged_requests_total";
+        static inline const std::string STAGE_QUEUE_DEPTH = "olu_stage_queue_depth";
+    private:
+        static inline std::mutex _mutex;
+        // Maps the name of each series to its labels and values
+        static inline std::map<std::string, std::map<std::string, double>> _series;
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_METRICS_H
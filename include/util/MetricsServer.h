@@ -0,0 +1,81 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_METRICSSERVER_H
+#define OSM_LIVE_UPDATES_METRICSSERVER_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+namespace olu::util {
+
+    /**
+     * Small HTTP server on the loopback interface that answers every request with the current
+     * `Metrics` in the Prometheus text format, so that a running update process can be scraped.
+     */
+    class MetricsServer {
+    public:
+        /**
+         * @param port Port to listen on, an unused port is chosen if zero
+         */
+        explicit MetricsServer(unsigned short port);
+        ~MetricsServer();
+        MetricsServer(const MetricsServer&) = delete;
+        MetricsServer& operator=(const MetricsServer&) = delete;
+
+        /**
+         * Starts answering requests in a background thread.
+         */
+        void start();
+
+        /**
+         * Stops the server.
+         */
+        void stop();
+
+        [[nodiscard]] unsigned short getPort() const;
+    private:
+        boost::asio::io_context _ioContext;
+        boost::asio::ip::tcp::acceptor _acceptor;
+        std::thread _thread;
+        std::atomic<bool> _running = false;
+
+        void accept();
+    };
+
+    /**
+     * Exception that can appear inside the `MetricsServer` class.
+     */
+    class MetricsServerException final : public std::exception {
+        std::string message;
+    public:
+        explicit MetricsServerException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_METRICSSERVER_H
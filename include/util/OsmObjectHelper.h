@@ -8,7 +8,9 @@
 #include "util/Types.h"
 
 #include <string>
+#include <string_view>
 #include <set>
+#include <vector>
 #include <boost/property_tree/ptree.hpp>
 
 namespace olu::osm {
@@ -20,7 +22,23 @@ namespace olu::osm {
          */
         static bool isMultipolygon(const boost::property_tree::ptree &relation);
 
-        static id_t getIdFromUri(const std::string& uri);
+        /**
+         * Returns the id at the end of an osm uri, for example `1787` for
+         * `https://www.openstreetmap.org/node/1787`. The uri is not copied.
+         *
+         * @throw OsmObjectHelperException if the uri does not end with an id
+         */
+        static id_t getIdFromUri(std::string_view uri);
+
+        /**
+         * Appends the ids of the uris in the column `path` of all rows in the given SPARQL
+         * results to `ids`.
+         *
+         * @example For the results of a query with the single variable `?member`, `path` would be
+         * `binding.uri`
+         */
+        static void getIdsFromUris(const boost::property_tree::ptree &results,
+                                   const std::string &path, std::vector<id_t> &ids);
     };
 
     /**
@@ -0,0 +1,114 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_REGION_H
+#define OSM_LIVE_UPDATES_REGION_H
+
+#include "osmium/osm/location.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Geographic region to which the change files are clipped. A region is either a bounding box
+     * or a polygon in the Osmosis polygon filter format, the format in which Geofabrik publishes
+     * the boundaries of its extracts.
+     *
+     * The edges of all rings are indexed by latitude bands, so that a point in polygon test only
+     * has to look at the few edges that cross the band of the point instead of all edges.
+     */
+    class Region {
+    public:
+        /**
+         * Creates a region from a bounding box of the form `MIN_LON,MIN_LAT,MAX_LON,MAX_LAT`.
+         *
+         * @throw RegionException if the bounding box is not valid
+         */
+        static Region fromBbox(std::string_view bbox);
+
+        /**
+         * Creates a region from the content of a polygon file. The file starts with a name,
+         * followed by one section per ring. Each section starts with a name, contains one
+         * `LON LAT` pair per line and is closed with `END`. Sections whose name starts with `!`
+         * are holes. The file itself is closed with another `END`.
+         *
+         * @throw RegionException if the polygon is not valid
+         */
+        static Region fromPolygon(std::string_view polygon);
+
+        /**
+         * Reads a polygon file, see `fromPolygon`.
+         *
+         * @throw RegionException if the file cannot be read or the polygon is not valid
+         */
+        static Region fromPolygonFile(const std::filesystem::path &path);
+
+        /**
+         * @return True if the location lies inside the region. Invalid locations are never
+         * inside. Points that lie inside a hole are outside of the region.
+         */
+        [[nodiscard]] bool contains(const osmium::Location &location) const;
+
+        [[nodiscard]] std::size_t getNumberOfEdges() const { return _edges.size(); }
+    private:
+        struct Edge {
+            double lon1, lat1, lon2, lat2;
+        };
+
+        explicit Region(std::vector<std::vector<Edge>> rings);
+
+        [[nodiscard]] std::size_t getBand(double lat) const;
+
+        std::vector<Edge> _edges;
+        double _minLon, _minLat, _maxLon, _maxLat;
+        // A bounding box does not need the point in polygon test
+        bool _isBox = false;
+
+        // The indices of the edges that cross each latitude band. Band `i` covers the latitudes
+        // from `_minLat + i * _bandHeight` up to the next band.
+        std::vector<std::vector<std::size_t>> _bands;
+        double _bandHeight;
+
+        // Roughly the number of edges per latitude band
+        static constexpr std::size_t EDGES_PER_BAND = 4;
+        static constexpr std::size_t MAX_BANDS = 4096;
+    };
+
+    /**
+     * Exception that can appear inside the `Region` class.
+     */
+    class RegionException final : public std::exception {
+        std::string message;
+
+    public:
+        explicit RegionException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_REGION_H
@@ -0,0 +1,148 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_REPLAYSERVER_H
+#define OSM_LIVE_UPDATES_REPLAYSERVER_H
+
+#include "util/RequestRecording.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+namespace olu::util {
+
+    /**
+     * Minimal HTTP server on the loopback interface that stands in for a SPARQL endpoint. It
+     * answers each request with the response that was recorded for the same request body, so that
+     * runs of the update process can be benchmarked without a live endpoint.
+     *
+     * If the same body was recorded multiple times, the recorded responses are returned in order
+     * and the last one is repeated. Requests without a recording are answered with an empty
+     * SPARQL result for queries and "Update successful" for updates.
+     */
+    class ReplayServer {
+    public:
+        /**
+         * @param exchanges The recorded request/response pairs to replay
+         * @param latency Time the server waits before answering each request
+         * @param port Port to listen on, an unused port is chosen if zero
+         */
+        explicit ReplayServer(const std::vector<RecordedExchange> &exchanges,
+                              std::chrono::milliseconds latency = std::chrono::milliseconds(0),
+                              unsigned short port = 0);
+        ~ReplayServer();
+        ReplayServer(const ReplayServer&) = delete;
+        ReplayServer& operator=(const ReplayServer&) = delete;
+
+        /**
+         * Starts accepting connections in a background thread.
+         */
+        void start();
+
+        /**
+         * Stops the server and waits until all open connections are closed.
+         */
+        void stop();
+
+        [[nodiscard]] unsigned short getPort() const;
+
+        /**
+         * @return The uri of the server that can be used as SPARQL endpoint uri
+         */
+        [[nodiscard]] std::string getUri() const;
+
+        /**
+         * @return The number of requests the server has answered
+         */
+        [[nodiscard]] std::size_t getRequestCount() const { return _requestCount; }
+
+        /**
+         * @return The number of connections that are currently open
+         */
+        [[nodiscard]] std::size_t getOpenConnections();
+
+        /**
+         * Answers the following requests with the given status instead of "200 OK", for example
+         * to simulate a failing endpoint.
+         */
+        void setStatus(const std::string &status);
+
+        /**
+         * @return The response for the given request body, either the recorded one or a fallback
+         */
+        std::string getResponse(const std::string &requestBody);
+
+        static inline const std::string EMPTY_QUERY_RESPONSE =
+            "<?xml version=\"1.0\"?>"
+            "<sparql xmlns=\"http://www.w3.org/2005/sparql-results#\">"
+            "<head></head><results></results></sparql>";
+        static inline const std::string UPDATE_RESPONSE = "Update successful";
+    private:
+        struct RecordedResponses {
+            std::vector<std::string> responses;
+            std::size_t next = 0;
+        };
+
+        std::chrono::milliseconds _latency;
+        std::mutex _mutex;
+        std::map<std::string, RecordedResponses> _responses;
+        std::string _status = "200 OK";
+        std::atomic<std::size_t> _requestCount = 0;
+
+        boost::asio::io_context _ioContext;
+        boost::asio::ip::tcp::acceptor _acceptor;
+        std::thread _acceptThread;
+        // The sockets of the open connections. Each connection is handled by a detached thread,
+        // which removes its socket when the connection is closed.
+        std::map<std::size_t, std::shared_ptr<boost::asio::ip::tcp::socket>> _connections;
+        std::size_t _nextConnection = 0;
+        std::condition_variable _connectionClosed;
+        std::atomic<bool> _running = false;
+
+        void accept();
+        void handleConnection(const std::shared_ptr<boost::asio::ip::tcp::socket> &socket);
+    };
+
+    /**
+     * Exception that can appear inside the `ReplayServer` class.
+     */
+    class ReplayServerException final : public std::exception {
+        std::string message;
+    public:
+        explicit ReplayServerException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_REPLAYSERVER_H
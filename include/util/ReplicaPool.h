@@ -0,0 +1,94 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_REPLICAPOOL_H
+#define OSM_LIVE_UPDATES_REPLICAPOOL_H
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Set of SPARQL endpoints that serve the same data, for example several read replicas of one
+     * QLever index. The pool chooses the replica with the fewest outstanding requests for each
+     * query. It also tracks the latency of recent requests so that a query can be hedged at the
+     * 95th percentile.
+     *
+     * All methods can be called from several threads.
+     */
+    class ReplicaPool {
+    public:
+        explicit ReplicaPool(std::vector<std::string> uris);
+
+        /**
+         * @return The replica with the fewest outstanding requests. Ties are broken in favor of
+         * the replica that was chosen least recently. The replica `exclude` is not chosen unless
+         * it is the only one.
+         */
+        [[nodiscard]] std::size_t select(std::optional<std::size_t> exclude = std::nullopt);
+
+        /**
+         * Marks a request to the replica as outstanding.
+         */
+        void begin(std::size_t replica);
+
+        /**
+         * Marks a request to the replica as finished.
+         *
+         * @param latency The time the request took, or nothing if it failed or was aborted. Only
+         * successful requests count towards the hedge delay.
+         */
+        void end(std::size_t replica, std::optional<double> latency);
+
+        /**
+         * @return The 95th percentile of the latency of the last requests, or nothing if too few
+         * requests finished so far
+         */
+        [[nodiscard]] std::optional<std::chrono::milliseconds> getHedgeDelay() const;
+
+        [[nodiscard]] const std::string& getUri(std::size_t replica) const {
+            return _uris[replica];
+        }
+        [[nodiscard]] std::size_t size() const { return _uris.size(); }
+        [[nodiscard]] std::size_t getOutstanding(std::size_t replica) const;
+
+        // Number of latencies that are kept to compute the hedge delay
+        static constexpr std::size_t LATENCY_WINDOW = 512;
+        // Number of latencies that are needed before requests are hedged
+        static constexpr std::size_t MIN_LATENCY_SAMPLES = 20;
+    private:
+        std::vector<std::string> _uris;
+
+        mutable std::mutex _mutex;
+        std::vector<std::size_t> _outstanding;
+        std::vector<std::size_t> _lastSelected;
+        std::size_t _selections = 0;
+        // Ring buffer with the latencies of the last successful requests in milliseconds
+        std::vector<double> _latencies;
+        std::size_t _nextLatency = 0;
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_REPLICAPOOL_H
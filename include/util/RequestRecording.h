@@ -0,0 +1,78 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_REQUESTRECORDING_H
+#define OSM_LIVE_UPDATES_REQUESTRECORDING_H
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * A request body that was sent to the SPARQL endpoint and the response it returned.
+     */
+    struct RecordedExchange {
+        std::string request;
+        std::string response;
+    };
+
+    /**
+     * Reads and writes files with recorded request/response pairs, which can be replayed by the
+     * `ReplayServer`.
+     *
+     * Each exchange is stored as a `request <length>` line followed by the request body and a
+     * `response <length>` line followed by the response, each terminated by a newline. The
+     * lengths are given in bytes, so that bodies can contain arbitrary content.
+     */
+    class RequestRecording {
+    public:
+        /**
+         * Appends an exchange to the recording at the given path. Safe to call from multiple
+         * threads.
+         */
+        static void append(const std::filesystem::path &path, const std::string &request,
+                           const std::string &response);
+
+        /**
+         * @return All exchanges in the recording at the given path in the order they were
+         * recorded
+         */
+        static std::vector<RecordedExchange> load(const std::filesystem::path &path);
+    private:
+        static inline std::mutex _mutex;
+    };
+
+    /**
+     * Exception that can appear inside the `RequestRecording` class.
+     */
+    class RequestRecordingException final : public std::exception {
+        std::string message;
+    public:
+        explicit RequestRecordingException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_REQUESTRECORDING_H
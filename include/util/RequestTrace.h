@@ -0,0 +1,92 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_REQUESTTRACE_H
+#define OSM_LIVE_UPDATES_REQUESTTRACE_H
+
+#include "util/HttpRequest.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace olu::util {
+
+    /**
+     * Writes one JSON record per HTTP request to a newline delimited JSON (NDJSON) file.
+     *
+     * Each record contains the kind of the request (for SPARQL requests the `QueryWriter` method
+     * that created the query), the number of elements in the batch, the request and response size,
+     * the timing breakdown reported by libcurl and, if the SPARQL endpoint reports one, the time
+     * the endpoint needed to compute the result.
+     *
+     * The trace is process wide and disabled until `open()` is called.
+     */
+    class RequestTrace {
+    public:
+        /**
+         * Opens the trace file at the given path. Existing content of the file is discarded.
+         */
+        static void open(const std::filesystem::path &path);
+
+        /**
+         * Closes the trace file. Following requests are no longer traced.
+         */
+        static void close();
+
+        /**
+         * @return TRUE if the trace file has been opened.
+         */
+        static bool isEnabled();
+
+        /**
+         * Writes a record for the given request, which must already have been performed.
+         *
+         * @param kind The kind of the request, for example `writeQueryForNodeLocations`
+         * @param batchSize Number of osm elements or triples the request was sent for
+         * @param request The performed request
+         * @param serverTime Time in milliseconds the endpoint needed to answer the request, if
+         * it reported one
+         */
+        static void write(const std::string &kind, std::size_t batchSize,
+                          const HttpRequest &request,
+                          std::optional<double> serverTime = std::nullopt);
+    private:
+        static inline std::mutex _mutex;
+        static inline std::ofstream _file;
+    };
+
+    /**
+     * Exception that can appear inside the `RequestTrace` class.
+     */
+    class RequestTraceException final : public std::exception {
+        std::string message;
+    public:
+        explicit RequestTraceException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_REQUESTTRACE_H
@@ -0,0 +1,138 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_RUNREPORT_H
+#define OSM_LIVE_UPDATES_RUNREPORT_H
+
+#include "util/ChromeTrace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Resource usage and SPARQL traffic of a single phase of the update process.
+     */
+    struct PhaseStats {
+        std::string name;
+        // Elapsed wall clock time in seconds
+        double wallTime = 0;
+        // CPU time (user and system) of the whole process in seconds
+        double cpuTime = 0;
+        // High-water mark of the resident set size in kilobytes at the end of the phase
+        long peakRss = 0;
+        std::size_t sparqlRequests = 0;
+        std::size_t bytesSent = 0;
+        std::size_t bytesReceived = 0;
+        std::size_t rowsReturned = 0;
+    };
+
+    /**
+     * Collects timings, counters and the memory high-water mark for every phase of an update run
+     * and writes them as a JSON report.
+     *
+     * The counters are process wide, so that they can be increased from `HttpRequest` and
+     * `SparqlWrapper` without passing the report around. A phase is measured by creating a
+     * `RunReport::Phase` object, which records the phase when it goes out of scope.
+     */
+    class RunReport {
+    public:
+        /**
+         * Measures the phase with the given name from its construction until its destruction.
+         */
+        class Phase {
+        public:
+            explicit Phase(std::string name);
+            ~Phase();
+            Phase(const Phase&) = delete;
+            Phase& operator=(const Phase&) = delete;
+        private:
+            PhaseStats _start;
+            std::chrono::steady_clock::time_point _startTime;
+            // Every phase is also shown on the timeline of the chrome trace
+            ChromeTrace::Span _span;
+        };
+
+        static void countSparqlRequest();
+        static void countBytes(std::size_t sent, std::size_t received);
+        static void countRows(std::size_t rows);
+
+        /**
+         * Sets a named counter, for example the number of created nodes, that is written to the
+         * report.
+         */
+        static void setCounter(const std::string &name, std::size_t value);
+
+        /**
+         * @return The stats of all phases that have been finished so far, in the order in which
+         * they finished.
+         */
+        static std::vector<PhaseStats> getPhases();
+
+        /**
+         * @return The resource usage and traffic of the process since it was started.
+         */
+        static PhaseStats getTotal();
+
+        /**
+         * @return The report as a JSON object
+         */
+        static std::string toJson();
+
+        /**
+         * Writes the report as JSON to the given file.
+         */
+        static void write(const std::filesystem::path &path);
+    private:
+        static inline std::atomic<std::size_t> _sparqlRequests = 0;
+        static inline std::atomic<std::size_t> _bytesSent = 0;
+        static inline std::atomic<std::size_t> _bytesReceived = 0;
+        static inline std::atomic<std::size_t> _rowsReturned = 0;
+        static inline const std::chrono::steady_clock::time_point _startTime =
+            std::chrono::steady_clock::now();
+
+        static inline std::mutex _mutex;
+        static inline std::vector<PhaseStats> _phases;
+        static inline std::map<std::string, std::size_t> _counters;
+
+        static void addPhase(PhaseStats phase);
+    };
+
+    /**
+     * Exception that can appear inside the `RunReport` class.
+     */
+    class RunReportException final : public std::exception {
+        std::string message;
+    public:
+        explicit RunReportException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_RUNREPORT_H
@@ -0,0 +1,53 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_TRACEPOINTS_H
+#define OSM_LIVE_UPDATES_TRACEPOINTS_H
+
+// Static tracepoints (USDT) at the phase and request boundaries of the update process. A probe
+// compiles to a single `nop` and only does something while a tracer like `perf` or `bpftrace`
+// is attached, for example:
+//
+//     bpftrace -e 'usdt:./olu:olu:phase_end { printf("%s %d ms\n", str(arg0), arg1); }' -p <pid>
+//
+// The probes are listed with `readelf -n olu`. Without `sys/sdt.h` or if the build option
+// `OLU_USDT` is turned off, the macros expand to nothing and their arguments are not evaluated.
+//
+// Probes of the provider `olu`:
+//  - phase_start(name), phase_end(name, wall time in ms)
+//  - osm2ttl_start(), osm2ttl_end(wall time in ms)
+//  - http_start(method, url, request bytes), http_end(method, url, response code,
+//    request bytes, response bytes)
+//  - sparql_start(kind, batch size), sparql_end(kind, batch size, response bytes)
+//  - batch_start(kind, batch size), batch_end(kind, batch size)
+#if defined(OLU_USDT) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define OLU_TRACE0(name) DTRACE_PROBE(olu, name)
+#define OLU_TRACE1(name, a) DTRACE_PROBE1(olu, name, a)
+#define OLU_TRACE2(name, a, b) DTRACE_PROBE2(olu, name, a, b)
+#define OLU_TRACE3(name, a, b, c) DTRACE_PROBE3(olu, name, a, b, c)
+#define OLU_TRACE5(name, a, b, c, d, e) DTRACE_PROBE5(olu, name, a, b, c, d, e)
+#else
+#define OLU_TRACE0(name) do { } while (false)
+#define OLU_TRACE1(name, a) do { } while (false)
+#define OLU_TRACE2(name, a, b) do { } while (false)
+#define OLU_TRACE3(name, a, b, c) do { } while (false)
+#define OLU_TRACE5(name, a, b, c, d, e) do { } while (false)
+#endif
+
+#endif //OSM_LIVE_UPDATES_TRACEPOINTS_H
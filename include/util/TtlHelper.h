@@ -8,13 +8,14 @@
 #include "Types.h"
 
 #include <string>
+#include <string_view>
 
 namespace olu::util {
 
     class TtlHelper {
     public:
         static Triple getTriple(const std::string& tripleString);
-        static id_t getIdFromSubject(const std::string& subject, const std::string &osmTag);
+        static id_t getIdFromSubject(std::string_view subject, const std::string &osmTag);
         static bool isRelevantNamespace(const std::string& subject, const std::string &osmTag);
         static bool hasRelevantObject(const std::string& predicate, const std::string &osmTag);
     };
@@ -20,6 +20,7 @@
 #define OSM_LIVE_UPDATES_URLHELPER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace olu::util {
@@ -34,8 +35,13 @@ public:
     // @throw 'std::invalid_argument' if sequence number is empty or too long
     static std::string formatSequenceNumberForUrl(int &sequenceNumber);
 
-    // Url encodes the given string
-    static std::string encodeForUrlQuery(const std::string& value);
+    // Url encodes the given string. Everything except alphanumeric characters and '-', '_', '.'
+    // and '~' is percent-encoded with lowercase hex digits.
+    static std::string encodeForUrlQuery(std::string_view value);
+
+    // Appends the url encoded string to `output`, so that the encoded query can be written
+    // directly behind the request body's parameter name
+    static void encodeForUrlQuery(std::string_view value, std::string& output);
 
     static bool isValidUri(const std::string& uri);
 };
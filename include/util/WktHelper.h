@@ -0,0 +1,50 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_WKTHELPER_H
+#define OSM_LIVE_UPDATES_WKTHELPER_H
+
+#include "osmium/osm/location.hpp"
+
+#include <string_view>
+
+namespace olu::util {
+
+    /**
+     * Parser for the WKT literals that the SPARQL endpoint returns for node locations. Only
+     * `POINT` is supported. Coordinates are read with `std::from_chars` straight from the
+     * literal, so that nothing is allocated.
+     */
+    class WktHelper {
+    public:
+        /**
+         * Parses a WKT point into `location`.
+         *
+         * @example For `POINT(13.5690032 42.7957187)` the location would be set to lon 13.5690032
+         * and lat 42.7957187
+         *
+         * @return False, if the literal is not a valid WKT point. `location` is left unchanged in
+         * that case.
+         */
+        static bool parsePoint(std::string_view wkt, osmium::Location &location);
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_WKTHELPER_H
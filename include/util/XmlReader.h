@@ -20,6 +20,7 @@
 #define OSM_LIVE_UPDATES_XMLREADER_H
 
 #include <boost/property_tree/ptree.hpp>
+#include <string_view>
 #include <vector>
 
 namespace pt = boost::property_tree;
@@ -66,12 +67,13 @@ namespace olu::util {
         static void populatePTreeFromFile(const std::string& pathToFile, pt::ptree& tree);
 
         /**
-         * Populates the given property tree with the contents of the given string.
+         * Populates the given property tree with the contents of the given string. The string is
+         * parsed in place without copying it into a stream.
          *
          * @param string the string that contains the xml element
          * @param tree The property tree that should be populated
          */
-        static void populatePTreeFromString(const std::string& xml, pt::ptree& tree);
+        static void populatePTreeFromString(std::string_view xml, pt::ptree& tree);
 
         /**
          * @param tree The tree that contains the elements that should be printed
@@ -93,17 +95,35 @@ namespace olu::util {
         /**
          * @return True, if the given string has a xml encoded character in it
          */
-        static bool isXmlEncoded(const std::string &input);
+        static bool isXmlEncoded(std::string_view input);
 
         /**
          * Encodes string for xml format.
          */
-        static std::string xmlEncode(const std::string &input);
+        static std::string xmlEncode(std::string_view input);
+
+        /**
+         * Appends the xml encoded string to `output`, so that a buffer can be reused for many
+         * strings.
+         */
+        static void xmlEncode(std::string_view input, std::string &output);
 
         /**
          * Decodes string for xml format.
          */
-        static std::string xmlDecode(const std::string &input);
+        static std::string xmlDecode(std::string_view input);
+
+        /**
+         * Appends the decoded string to `output`, so that a buffer can be reused for many
+         * strings.
+         */
+        static void xmlDecode(std::string_view input, std::string &output);
+
+        /**
+         * Decodes the given string in place. A decoded entity is never longer than the entity
+         * itself, so no memory is allocated, and strings without an entity are not touched.
+         */
+        static void xmlDecodeInPlace(std::string &value);
     };
 
     /**
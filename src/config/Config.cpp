@@ -24,8 +24,10 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
 #include <popl.hpp>
 #include <util/HttpRequest.h>
+#include <util/Region.h>
 #include <util/URLHelper.h>
 
 // ____________________________________________________________________________
@@ -52,6 +54,27 @@ void olu::config::Config::fromArgs(int argc, char **argv) {
             olu::config::constants::SPARQL_UPDATE_PATH_OPTION_LONG,
             olu::config::constants::SPARQL_UPDATE_PATH_OPTION_HELP);
 
+    auto readReplicaOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::READ_REPLICA_OPTION_SHORT,
+            olu::config::constants::READ_REPLICA_OPTION_LONG,
+            olu::config::constants::READ_REPLICA_OPTION_HELP);
+
+    auto hedgeReadsOp = parser.add<popl::Switch, popl::Attribute::advanced>(
+            olu::config::constants::HEDGE_READS_OPTION_SHORT,
+            olu::config::constants::HEDGE_READS_OPTION_LONG,
+            olu::config::constants::HEDGE_READS_OPTION_HELP);
+
+    auto updateTargetOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::UPDATE_TARGET_OPTION_SHORT,
+            olu::config::constants::UPDATE_TARGET_OPTION_LONG,
+            olu::config::constants::UPDATE_TARGET_OPTION_HELP);
+
+    auto updateRetriesOp = parser.add<popl::Value<std::size_t>, popl::Attribute::advanced>(
+            olu::config::constants::UPDATE_RETRIES_OPTION_SHORT,
+            olu::config::constants::UPDATE_RETRIES_OPTION_LONG,
+            olu::config::constants::UPDATE_RETRIES_OPTION_HELP,
+            updateRetries);
+
     auto pathToOsmChangeFileInputDirOp = parser.add<popl::Value<std::string>, popl::Attribute::optional>(
             olu::config::constants::PATH_TO_INPUT_OPTION_SHORT,
             olu::config::constants::PATH_TO_INPUT_OPTION_LONG,
@@ -82,6 +105,68 @@ void olu::config::Config::fromArgs(int argc, char **argv) {
             olu::config::constants::SEQUENCE_NUMBER_OPTION_LONG,
             olu::config::constants::SEQUENCE_NUMBER_OPTION_HELP);
 
+    auto skipAppliedOp = parser.add<popl::Switch, popl::Attribute::advanced>(
+            olu::config::constants::SKIP_APPLIED_OPTION_SHORT,
+            olu::config::constants::SKIP_APPLIED_OPTION_LONG,
+            olu::config::constants::SKIP_APPLIED_OPTION_HELP);
+
+    auto clipBboxOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::CLIP_BBOX_OPTION_SHORT,
+            olu::config::constants::CLIP_BBOX_OPTION_LONG,
+            olu::config::constants::CLIP_BBOX_OPTION_HELP);
+
+    auto clipPolygonOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::CLIP_POLYGON_OPTION_SHORT,
+            olu::config::constants::CLIP_POLYGON_OPTION_LONG,
+            olu::config::constants::CLIP_POLYGON_OPTION_HELP);
+
+    auto geometryQueueOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::GEOMETRY_QUEUE_OPTION_SHORT,
+            olu::config::constants::GEOMETRY_QUEUE_OPTION_LONG,
+            olu::config::constants::GEOMETRY_QUEUE_OPTION_HELP);
+
+    auto geometryQueueSizeOp = parser.add<popl::Value<std::size_t>, popl::Attribute::advanced>(
+            olu::config::constants::GEOMETRY_QUEUE_SIZE_OPTION_SHORT,
+            olu::config::constants::GEOMETRY_QUEUE_SIZE_OPTION_LONG,
+            olu::config::constants::GEOMETRY_QUEUE_SIZE_OPTION_HELP,
+            geometryQueueMaxSize);
+
+    auto geometryQueueIntervalOp = parser.add<popl::Value<long>, popl::Attribute::advanced>(
+            olu::config::constants::GEOMETRY_QUEUE_INTERVAL_OPTION_SHORT,
+            olu::config::constants::GEOMETRY_QUEUE_INTERVAL_OPTION_LONG,
+            olu::config::constants::GEOMETRY_QUEUE_INTERVAL_OPTION_HELP,
+            geometryQueueMaxAge);
+
+    auto journalOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::JOURNAL_OPTION_SHORT,
+            olu::config::constants::JOURNAL_OPTION_LONG,
+            olu::config::constants::JOURNAL_OPTION_HELP);
+
+    auto runReportOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::RUN_REPORT_OPTION_SHORT,
+            olu::config::constants::RUN_REPORT_OPTION_LONG,
+            olu::config::constants::RUN_REPORT_OPTION_HELP);
+
+    auto requestTraceOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::REQUEST_TRACE_OPTION_SHORT,
+            olu::config::constants::REQUEST_TRACE_OPTION_LONG,
+            olu::config::constants::REQUEST_TRACE_OPTION_HELP);
+
+    auto requestRecordingOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::REQUEST_RECORDING_OPTION_SHORT,
+            olu::config::constants::REQUEST_RECORDING_OPTION_LONG,
+            olu::config::constants::REQUEST_RECORDING_OPTION_HELP);
+
+    auto metricsPortOp = parser.add<popl::Value<int>, popl::Attribute::advanced>(
+            olu::config::constants::METRICS_PORT_OPTION_SHORT,
+            olu::config::constants::METRICS_PORT_OPTION_LONG,
+            olu::config::constants::METRICS_PORT_OPTION_HELP);
+
+    auto chromeTraceOp = parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+            olu::config::constants::CHROME_TRACE_OPTION_SHORT,
+            olu::config::constants::CHROME_TRACE_OPTION_LONG,
+            olu::config::constants::CHROME_TRACE_OPTION_HELP);
+
     try {
         parser.parse(argc, argv);
 
@@ -172,6 +257,36 @@ void olu::config::Config::fromArgs(int argc, char **argv) {
             sparqlEndpointUriForUpdates = sparqlEndpointUri;
         }
 
+        for (std::size_t i = 0; i < readReplicaOp->count(); ++i) {
+            const auto &replicaUri = readReplicaOp->value(i);
+            if (!olu::util::URLHelper::isValidUri(replicaUri)) {
+                std::cerr << "URI for SPARQL read replica is not valid: " << replicaUri << "\n"
+                          << parser.help() << "\n";
+                exit(config::ExitCode::ENDPOINT_URI_INVALID);
+            }
+            sparqlReadReplicaUris.emplace_back(replicaUri);
+        }
+
+        if (hedgeReadsOp->is_set()) {
+            if (sparqlReadReplicaUris.empty()) {
+                std::cerr << "Hedging queries requires at least one read replica (--read-replica)\n"
+                          << parser.help() << "\n";
+                exit(config::ExitCode::INCORRECT_ARGUMENTS);
+            }
+            hedgeReadQueries = true;
+        }
+
+        for (std::size_t i = 0; i < updateTargetOp->count(); ++i) {
+            const auto target = parseUpdateTarget(updateTargetOp->value(i));
+            if (!target) {
+                std::cerr << "Update target is not valid: " << updateTargetOp->value(i) << "\n"
+                          << parser.help() << "\n";
+                exit(config::ExitCode::ENDPOINT_UPDATE_URI_INVALID);
+            }
+            updateTargets.emplace_back(*target);
+        }
+        updateRetries = updateRetriesOp->value();
+
         if (timestampOp->is_set()) {
             timestamp = timestampOp->value();
         }
@@ -180,12 +295,83 @@ void olu::config::Config::fromArgs(int argc, char **argv) {
             sequenceNumber = sequenceNumberOp->value();
         }
 
+        if (skipAppliedOp->is_set()) {
+            skipAppliedObjects = true;
+        }
+
+        if (clipBboxOp->is_set() && clipPolygonOp->is_set()) {
+            std::cerr << "Only one of --bbox and --clip-polygon can be used\n"
+                      << parser.help() << "\n";
+            exit(config::ExitCode::INCORRECT_ARGUMENTS);
+        }
+
+        if (clipBboxOp->is_set()) {
+            try {
+                olu::util::Region::fromBbox(clipBboxOp->value());
+            } catch (const olu::util::RegionException &e) {
+                std::cerr << e.what() << ": " << clipBboxOp->value() << "\n"
+                          << parser.help() << "\n";
+                exit(config::ExitCode::INCORRECT_ARGUMENTS);
+            }
+            clipBbox = clipBboxOp->value();
+        }
+
+        if (clipPolygonOp->is_set()) {
+            clipPolygonFile = clipPolygonOp->value();
+            if (!std::filesystem::exists(clipPolygonFile)) {
+                std::cerr << "Polygon file does not exist: " << clipPolygonFile << "\n"
+                          << parser.help() << "\n";
+                exit(config::ExitCode::INPUT_NOT_EXISTS);
+            }
+        }
+
         if (sparqlOutputOp->is_set()) {
             sparqlOutputFile = sparqlOutputOp->value();
             sparqlOutput = sparqlOutputFormatOp->is_set() ? DEBUG_FILE : FILE;
         } else {
             sparqlOutput = ENDPOINT;
         }
+
+        if (sparqlOutput != ENDPOINT && !updateTargets.empty()) {
+            std::cerr << "Update targets (--update-target) can not be used together with an "
+                         "output file (--sparql-output), because the queries are only sent to "
+                         "them\n" << parser.help() << "\n";
+            exit(config::ExitCode::INCORRECT_ARGUMENTS);
+        }
+
+        if (geometryQueueOp->is_set()) {
+            geometryQueueFile = geometryQueueOp->value();
+        }
+        geometryQueueMaxSize = geometryQueueSizeOp->value();
+        geometryQueueMaxAge = geometryQueueIntervalOp->value();
+
+        if (journalOp->is_set()) {
+            journalDir = journalOp->value();
+        }
+
+        if (runReportOp->is_set()) {
+            runReportFile = runReportOp->value();
+        }
+
+        if (requestTraceOp->is_set()) {
+            requestTraceFile = requestTraceOp->value();
+        }
+
+        if (requestRecordingOp->is_set()) {
+            requestRecordingFile = requestRecordingOp->value();
+        }
+
+        if (metricsPortOp->is_set()) {
+            if (metricsPortOp->value() <= 0 || metricsPortOp->value() > 65535) {
+                std::cerr << "Metrics port has to be between 1 and 65535\n" << parser.help() << "\n";
+                exit(config::ExitCode::INCORRECT_ARGUMENTS);
+            }
+            metricsPort = metricsPortOp->value();
+        }
+
+        if (chromeTraceOp->is_set()) {
+            chromeTraceFile = chromeTraceOp->value();
+        }
     } catch (const popl::invalid_option& e) {
         std::cerr << "Invalid Option Exception: " << e.what() << "\n";
         std::cerr << "error:  ";
@@ -215,6 +401,37 @@ void olu::config::Config::fromArgs(int argc, char **argv) {
     }
 }
 
+// ____________________________________________________________________________
+std::optional<olu::config::UpdateTarget>
+olu::config::Config::parseUpdateTarget(const std::string_view value) {
+    std::vector<std::string> parts;
+    std::size_t start = 0;
+    while (true) {
+        const auto end = value.find(',', start);
+        parts.emplace_back(value.substr(start, end - start));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+
+    if (parts.size() > 3) {
+        return std::nullopt;
+    }
+
+    UpdateTarget target;
+    target.endpointUri = parts[0];
+    target.graphUri = parts.size() > 1 ? parts[1] : "";
+    target.accessToken = parts.size() > 2 ? parts[2] : "";
+
+    if (!olu::util::URLHelper::isValidUri(target.endpointUri) ||
+        (!target.graphUri.empty() && !olu::util::URLHelper::isValidUri(target.graphUri))) {
+        return std::nullopt;
+    }
+
+    return target;
+}
+
 std::string olu::config::Config::getInfo(std::string_view prefix) const {
     std::ostringstream oss;
 
@@ -232,6 +449,47 @@ std::string olu::config::Config::getInfo(std::string_view prefix) const {
     << sparqlEndpointUri
     << std::endl;
 
+    for (const auto &replicaUri : sparqlReadReplicaUris) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::READ_REPLICA_INFO
+        << " "
+        << replicaUri
+        << std::endl;
+    }
+
+    if (hedgeReadQueries) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::HEDGE_READS_INFO
+        << std::endl;
+    }
+
+    for (const auto &target : updateTargets) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::UPDATE_TARGET_INFO
+        << " "
+        << target.endpointUri;
+        if (!target.graphUri.empty()) {
+            oss << " (graph " << target.graphUri << ")";
+        }
+        oss << std::endl;
+    }
+
+    if (updateRetries > 0) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::UPDATE_RETRIES_INFO
+        << " "
+        << updateRetries
+        << std::endl;
+    }
+
     if (!graphUri.empty()) {
         oss
         << prefix
@@ -280,6 +538,109 @@ std::string olu::config::Config::getInfo(std::string_view prefix) const {
         }
     }
 
+    if (skipAppliedObjects) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::SKIP_APPLIED_INFO
+        << std::endl;
+    }
+
+    if (!clipBbox.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::CLIP_BBOX_INFO
+        << " "
+        << clipBbox
+        << std::endl;
+    }
+
+    if (!clipPolygonFile.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::CLIP_POLYGON_INFO
+        << " "
+        << clipPolygonFile
+        << std::endl;
+    }
+
+    if (!geometryQueueFile.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::GEOMETRY_QUEUE_INFO
+        << " "
+        << geometryQueueFile
+        << " (drained at "
+        << geometryQueueMaxSize
+        << " objects or after "
+        << geometryQueueMaxAge
+        << "s)"
+        << std::endl;
+    }
+
+    if (!journalDir.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::JOURNAL_INFO
+        << " "
+        << journalDir
+        << std::endl;
+    }
+
+    if (!runReportFile.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::RUN_REPORT_INFO
+        << " "
+        << runReportFile
+        << std::endl;
+    }
+
+    if (!requestTraceFile.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::REQUEST_TRACE_INFO
+        << " "
+        << requestTraceFile
+        << std::endl;
+    }
+
+    if (!requestRecordingFile.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::REQUEST_RECORDING_INFO
+        << " "
+        << requestRecordingFile
+        << std::endl;
+    }
+
+    if (metricsPort > 0) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::METRICS_PORT_INFO
+        << " "
+        << metricsPort
+        << std::endl;
+    }
+
+    if (!chromeTraceFile.empty()) {
+        oss
+        << prefix
+        << osm2rdf::util::currentTimeFormatted()
+        << olu::config::constants::CHROME_TRACE_INFO
+        << " "
+        << chromeTraceFile
+        << std::endl;
+    }
+
     return oss.str();
 }
 
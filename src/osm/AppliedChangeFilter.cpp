@@ -0,0 +1,68 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "osm/AppliedChangeFilter.h"
+
+namespace olu::osm {
+
+    // _____________________________________________________________________________________________
+    std::vector<const osmium::OSMObject*>
+    AppliedChangeFilter::filter(const std::vector<const osmium::OSMObject*> &objects) {
+        // The versions of nodes, ways and relations are looked up separately, because their ids
+        // overlap
+        std::map<osmium::item_type, std::set<id_t>> ids;
+        for (const auto *object : objects) {
+            // A deleted object is newer than any version in the database
+            if (!object->deleted()) {
+                ids[object->type()].insert(object->id());
+            }
+        }
+
+        std::map<osmium::item_type, std::map<id_t, std::size_t>> storedVersions;
+        for (const auto &[type, typeIds] : ids) {
+            auto &versions = storedVersions[type];
+            std::set<id_t> batch;
+            for (auto it = typeIds.begin(); it != typeIds.end();) {
+                batch.insert(*it);
+                if (++it == typeIds.end() || batch.size() == MAX_OBJECTS_PER_LOOKUP) {
+                    versions.merge(_lookup(type, batch));
+                    batch.clear();
+                }
+            }
+        }
+
+        std::vector<const osmium::OSMObject*> kept;
+        kept.reserve(objects.size());
+        for (const auto *object : objects) {
+            if (!object->deleted()) {
+                const auto &versions = storedVersions[object->type()];
+                const auto it = versions.find(object->id());
+                if (it != versions.end() && it->second >= object->version()) {
+                    ++_skippedObjects;
+                    continue;
+                }
+            }
+
+            kept.push_back(object);
+        }
+
+        return kept;
+    }
+
+} // namespace olu::osm
@@ -0,0 +1,144 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "osm/ChangeCompactor.h"
+
+#include <map>
+#include <utility>
+
+namespace olu::osm {
+
+    // _____________________________________________________________________________________________
+    bool CreatedObjects::contains(const osmium::item_type type, const id_t id) const {
+        switch (type) {
+            case osmium::item_type::node:
+                return nodes.contains(id);
+            case osmium::item_type::way:
+                return ways.contains(id);
+            case osmium::item_type::relation:
+                return relations.contains(id);
+            default:
+                return false;
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    ChangeCompactor::NetEffect ChangeCompactor::getNetEffect(const osmium::OSMObject &first,
+                                                             const osmium::OSMObject &last,
+                                                             const bool absentBefore) {
+        const bool createdInWindow = absentBefore && first.visible() && first.version() == 1;
+        if (last.deleted()) {
+            return createdInWindow ? NetEffect::NONE : NetEffect::DELETE;
+        }
+
+        return createdInWindow ? NetEffect::CREATE : NetEffect::MODIFY;
+    }
+
+    // _____________________________________________________________________________________________
+    ChangeCompactor::Result
+    ChangeCompactor::compact(const std::vector<const osmium::OSMObject*> &versions,
+                             const StoredLookup &lookup) {
+        // The oldest and the newest version of each object
+        std::vector<std::pair<const osmium::OSMObject*, const osmium::OSMObject*>> changes;
+        for (auto newest = versions.begin(), next = newest; newest != versions.end();
+             newest = next) {
+            // Find the oldest version of the object, which is the last one with its type and id
+            next = newest + 1;
+            while (next != versions.end() && (*next)->type() == (*newest)->type() &&
+                   (*next)->id() == (*newest)->id()) {
+                ++next;
+            }
+            changes.emplace_back(*(next - 1), *newest);
+        }
+
+        // An object that only has its first version in the window is created like in the
+        // `create` section of the change file. If it was changed again, the net effect depends on
+        // whether the database already contains it.
+        auto isUnconfirmed = [](const osmium::OSMObject &first, const osmium::OSMObject &last) {
+            return first.visible() && first.version() == 1 &&
+                   (last.deleted() || last.version() > 1);
+        };
+
+        std::map<osmium::item_type, std::set<id_t>> unconfirmed;
+        for (const auto &[first, last] : changes) {
+            if (isUnconfirmed(*first, *last)) {
+                unconfirmed[last->type()].insert(last->id());
+            }
+        }
+
+        std::map<osmium::item_type, std::set<id_t>> stored;
+        if (lookup) {
+            for (const auto &[type, ids] : unconfirmed) {
+                std::set<id_t> batch;
+                for (auto it = ids.begin(); it != ids.end();) {
+                    batch.insert(*it);
+                    if (++it == ids.end() || batch.size() == MAX_OBJECTS_PER_LOOKUP) {
+                        stored[type].merge(lookup(type, batch));
+                        batch.clear();
+                    }
+                }
+            }
+        }
+
+        Result result;
+        result.objects.reserve(changes.size());
+        for (const auto &[first, last] : changes) {
+            bool absentBefore = true;
+            if (isUnconfirmed(*first, *last)) {
+                absentBefore = lookup && !stored[last->type()].contains(last->id());
+                if (!absentBefore) {
+                    ++result.unconfirmedCreates;
+                }
+            }
+
+            switch (getNetEffect(*first, *last, absentBefore)) {
+                case NetEffect::NONE:
+                    ++result.noOps;
+                    break;
+                case NetEffect::CREATE:
+                    if (last->version() > 1) {
+                        ++result.modifiesToCreates;
+                    }
+
+                    switch (last->type()) {
+                        case osmium::item_type::node:
+                            result.created.nodes.insert(last->id());
+                            break;
+                        case osmium::item_type::way:
+                            result.created.ways.insert(last->id());
+                            break;
+                        case osmium::item_type::relation:
+                            result.created.relations.insert(last->id());
+                            break;
+                        default:
+                            break;
+                    }
+                    result.objects.push_back(last);
+                    break;
+                case NetEffect::MODIFY:
+                case NetEffect::DELETE:
+                    result.objects.push_back(last);
+                    break;
+            }
+        }
+
+        return result;
+    }
+
+} // namespace olu::osm
@@ -0,0 +1,140 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/GeometryUpdateQueue.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Marks a line in the queue file that contains the time of the last drain
+static inline const std::string LAST_DRAIN_KEY = "lastDrain";
+static inline constexpr char WAY_KEY = 'w';
+static inline constexpr char RELATION_KEY = 'r';
+
+namespace olu::osm {
+    // _____________________________________________________________________________________________
+    void GeometryUpdateQueue::load() {
+        _ways.clear();
+        _relations.clear();
+        _lastDrain = std::time(nullptr);
+
+        if (!std::filesystem::exists(_path)) {
+            return;
+        }
+
+        std::ifstream file(_path);
+        if (!file) {
+            const std::string msg = "Can not open geometry update queue: " + _path.string();
+            throw GeometryUpdateQueueException(msg.c_str());
+        }
+
+        std::string key;
+        long long value;
+        while (file >> key >> value) {
+            if (key == LAST_DRAIN_KEY) {
+                _lastDrain = static_cast<std::time_t>(value);
+            } else if (key.size() == 1 && key[0] == WAY_KEY) {
+                _ways.insert(value);
+            } else if (key.size() == 1 && key[0] == RELATION_KEY) {
+                _relations.insert(value);
+            } else {
+                const std::string msg = "Invalid entry in geometry update queue: " + key;
+                throw GeometryUpdateQueueException(msg.c_str());
+            }
+        }
+
+        if (!file.eof()) {
+            const std::string msg = "Could not read geometry update queue: " + _path.string();
+            throw GeometryUpdateQueueException(msg.c_str());
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    void GeometryUpdateQueue::saveTo(const std::filesystem::path &path) const {
+        // Write to a temporary file first, so that the queue is not lost if we crash while writing
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream file(tmpPath, std::ios::trunc);
+            if (!file) {
+                const std::string msg = "Can not write geometry update queue: " + tmpPath.string();
+                throw GeometryUpdateQueueException(msg.c_str());
+            }
+
+            file << LAST_DRAIN_KEY << " " << static_cast<long long>(_lastDrain) << "\n";
+            for (const auto &wayId : _ways) {
+                file << WAY_KEY << " " << wayId << "\n";
+            }
+            for (const auto &relationId : _relations) {
+                file << RELATION_KEY << " " << relationId << "\n";
+            }
+        }
+
+        try {
+            std::filesystem::rename(tmpPath, path);
+        } catch (const std::filesystem::filesystem_error &e) {
+            std::cerr << e.what() << std::endl;
+            throw GeometryUpdateQueueException("Could not replace geometry update queue");
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    void GeometryUpdateQueue::addWays(const std::set<id_t> &wayIds) {
+        _ways.insert(wayIds.begin(), wayIds.end());
+    }
+
+    // _____________________________________________________________________________________________
+    void GeometryUpdateQueue::addRelations(const std::set<id_t> &relationIds) {
+        _relations.insert(relationIds.begin(), relationIds.end());
+    }
+
+    // _____________________________________________________________________________________________
+    void GeometryUpdateQueue::removeWays(const std::set<id_t> &wayIds) {
+        for (const auto &wayId : wayIds) {
+            _ways.erase(wayId);
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    void GeometryUpdateQueue::removeRelations(const std::set<id_t> &relationIds) {
+        for (const auto &relationId : relationIds) {
+            _relations.erase(relationId);
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    bool GeometryUpdateQueue::shouldDrain(const std::size_t maxSize, const long maxAge) const {
+        if (size() >= maxSize) {
+            return true;
+        }
+
+        return std::difftime(std::time(nullptr), _lastDrain) >= static_cast<double>(maxAge);
+    }
+
+    // _____________________________________________________________________________________________
+    void GeometryUpdateQueue::drain(std::set<id_t> &wayIds, std::set<id_t> &relationIds) {
+        wayIds.merge(_ways);
+        relationIds.merge(_relations);
+        _ways.clear();
+        _relations.clear();
+        _lastDrain = std::time(nullptr);
+    }
+
+} // namespace olu::osm
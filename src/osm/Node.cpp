@@ -17,10 +17,9 @@
 // along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "osm/Node.h"
-#include "spatialjoin/WKTParse.h"
+#include "util/WktHelper.h"
 
-#include <iostream>
-#include <sstream>
+#include <charconv>
 #include <string>
 
 /// The maximum number of decimals for the location in a node
@@ -30,11 +29,7 @@ namespace olu::osm {
     Node::Node(const id_t id, const WKTPoint& locationAsWkt) {
         this->id = id;
 
-        try {
-            const auto point = util::geo::pointFromWKT<double>(locationAsWkt);
-            this->loc = osmium::Location( point.getX(), point.getY() );
-        } catch (const std::exception& e) {
-            std::cerr << e.what() << std::endl;
+        if (!util::WktHelper::parsePoint(locationAsWkt, this->loc)) {
             const std::string message = "Location can not be inferred from WKT point: "
                                             + locationAsWkt;
             throw NodeException(message.c_str());
@@ -42,11 +37,29 @@ namespace olu::osm {
     }
 
     std::string Node::getXml() const {
-        std::ostringstream oss;
-        oss.precision(MAX_NODE_LOC_PRECISION);
-        oss << std::fixed << "<node id=\"" << this->getId() << "\" lat=\"" << this->loc.lat()
-            << "\" lon=\"" << this->loc.lon() << "\"/>";
+        std::string xml;
+        writeXml(xml);
+        return xml;
+    }
+
+    void Node::writeXml(std::string &output) const {
+        // Large enough for an id and a coordinate with MAX_NODE_LOC_PRECISION decimals
+        char buffer[32];
+
+        output.append("<node id=\"");
+        auto end = std::to_chars(buffer, buffer + sizeof(buffer), this->id).ptr;
+        output.append(buffer, end);
+
+        output.append("\" lat=\"");
+        end = std::to_chars(buffer, buffer + sizeof(buffer), this->loc.lat(),
+                            std::chars_format::fixed, MAX_NODE_LOC_PRECISION).ptr;
+        output.append(buffer, end);
+
+        output.append("\" lon=\"");
+        end = std::to_chars(buffer, buffer + sizeof(buffer), this->loc.lon(),
+                            std::chars_format::fixed, MAX_NODE_LOC_PRECISION).ptr;
+        output.append(buffer, end);
 
-        return oss.str();
+        output.append("\"/>");
     }
 }
\ No newline at end of file
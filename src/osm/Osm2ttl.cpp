@@ -21,12 +21,15 @@
 #include "osm2rdf/config/ExitCode.h"
 #include "config/Constants.h"
 #include "osm2rdf/Version.h"
+#include "util/Tracepoints.h"
+#include "util/ChromeTrace.h"
 
 #include <osm2rdf/config/Config.h>
 #include <osm2rdf/util/Output.h>
 #include <osm2rdf/ttl/Writer.h>
 #include <osm2rdf/osm/OsmiumHandler.h>
 #include <osm2rdf/ttl/Format.h>
+#include <chrono>
 #include <iostream>
 #include <omp.h>
 
@@ -36,7 +39,20 @@ namespace olu::osm {
 
     // _____________________________________________________________________________________________
     std::filesystem::path Osm2ttl::convert() {
+        OLU_TRACE0(osm2ttl_start);
+        [[maybe_unused]] const auto start = std::chrono::steady_clock::now();
+
         writeToInputFile();
+        auto ttlFile = convertInputFile();
+
+        OLU_TRACE1(osm2ttl_end, std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        return ttlFile;
+    }
+
+    // _____________________________________________________________________________________________
+    std::filesystem::path Osm2ttl::convertInputFile() {
+        util::ChromeTrace::Span span("osm2rdf", "conversion");
 
         // Create a directory for scratch, if not already existent
         if (!std::filesystem::exists(cnst::PATH_TO_SCRATCH_DIRECTORY)) {
@@ -92,6 +108,8 @@ namespace olu::osm {
 
     // _____________________________________________________________________________________________
     void Osm2ttl::writeToInputFile() {
+        util::ChromeTrace::Span span("osmium sort", "conversion");
+
         const std::string command = "osmium sort " + cnst::PATH_TO_NODE_FILE + " " +
                                     cnst::PATH_TO_WAY_FILE + " " + cnst::PATH_TO_RELATION_FILE +
                                     " -o " + cnst::PATH_TO_INPUT_FILE + " --overwrite > /dev/null";
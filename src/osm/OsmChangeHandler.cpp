@@ -23,12 +23,20 @@
 #include "sparql/QueryWriter.h"
 #include "util/OsmObjectHelper.h"
 #include "util/TtlHelper.h"
+#include "util/RunReport.h"
+#include "util/Metrics.h"
+#include "util/Tracepoints.h"
+#include "util/ChromeTrace.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <string>
 #include <iostream>
 #include <set>
 #include <regex>
+#include <chrono>
+#include <future>
+#include <optional>
+#include <thread>
 #include <sys/stat.h>
 
 #include "osm2rdf/util/ProgressBar.h"
@@ -38,8 +46,18 @@ static inline constexpr int MAX_VALUES_PER_QUERY = 1024;
 
 namespace cnst = olu::config::constants;
 
-void doInBatches(std::set<olu::id_t>& set, const long elementsPerBatch,
-                 std::function<void(std::set<olu::id_t>)> func) {
+// Time to wait before a failed update query is retried. The time doubles with each retry.
+static inline constexpr std::chrono::milliseconds UPDATE_RETRY_DELAY{500};
+
+// Publishes the number of objects or triples that are still waiting in the given stage
+static void setQueueDepth(const std::string &stage, const std::size_t depth) {
+    olu::util::Metrics::set(olu::util::Metrics::STAGE_QUEUE_DEPTH, static_cast<double>(depth),
+                            "stage=\"" + stage + "\"");
+}
+
+// Splits the set into batches with at most `elementsPerBatch` elements
+std::vector<std::set<olu::id_t>> toBatches(const std::set<olu::id_t>& set,
+                                           const long elementsPerBatch) {
     std::vector vector(set.begin(), set.end());
     std::vector<std::set<olu::id_t> > vectorBatches;
     for (auto it = vector.cbegin(), e = vector.cend(); it != vector.cend(); it = e) {
@@ -47,16 +65,52 @@ void doInBatches(std::set<olu::id_t>& set, const long elementsPerBatch,
         vectorBatches.emplace_back(it, e);
     }
 
-    for (const auto &vectorBatch: vectorBatches) {
+    return vectorBatches;
+}
+
+// Returns the prefixes of the delete query for objects whose uris have the given prefix
+static const std::vector<std::string>& getDeletePrefixes(const std::string &osmTag) {
+    if (osmTag == "osmnode") {
+        return cnst::PREFIXES_FOR_NODE_DELETE_QUERY;
+    }
+    if (osmTag == "osmway") {
+        return cnst::PREFIXES_FOR_WAY_DELETE_QUERY;
+    }
+    return cnst::PREFIXES_FOR_RELATION_DELETE_QUERY;
+}
+
+void doInBatches(std::set<olu::id_t>& set, const long elementsPerBatch,
+                 std::function<void(std::set<olu::id_t>)> func) {
+    for (const auto &vectorBatch: toBatches(set, elementsPerBatch)) {
         func(vectorBatch);
     }
 }
 
 namespace olu::osm {
-    OsmChangeHandler::OsmChangeHandler(const config::Config &config) : _config(config),
-                                                                       _sparql(config),
-                                                                       _queryWriter(config),
-                                                                       _odf(config) {
+    OsmChangeHandler::OsmChangeHandler(const config::Config &config,
+                                       CreatedObjects createdObjects)
+        : _config(config), _odf(config), _geometryQueue(config.geometryQueueFile),
+          _createdObjects(std::move(createdObjects)) {
+        _targets.emplace_back(config);
+
+        // The additional targets only receive updates, so the queries would be written to the
+        // output file once per target if the updates are not sent to the endpoints. The command
+        // line rejects this combination.
+        if (config.sparqlOutput == config::SparqlOutput::ENDPOINT) {
+            for (const auto &target : config.updateTargets) {
+                auto targetConfig = config;
+                targetConfig.sparqlEndpointUri = target.endpointUri;
+                targetConfig.sparqlEndpointUriForUpdates = target.endpointUri;
+                targetConfig.sparqlReadReplicaUris.clear();
+                targetConfig.hedgeReadQueries = false;
+                targetConfig.graphUri = target.graphUri;
+                targetConfig.accessToken = target.accessToken;
+                _targets.emplace_back(targetConfig);
+            }
+        }
+    }
+
+    void OsmChangeHandler::readChangeFile() {
         try {
             std::cout << "Process change file..." << std::endl;
             const auto decompressed = util::Decompressor::readGzip(cnst::PATH_TO_CHANGE_FILE);
@@ -72,25 +126,44 @@ namespace olu::osm {
     }
 
     void OsmChangeHandler::run() {
+        util::ChromeTrace::Span span("OsmChangeHandler::run", "run");
+        const auto start = std::chrono::steady_clock::now();
+
         // Store the ids of all elements that where deleted, modified or created and the ids of
         // objects where the geometry needs to be updated
-        storeIdsOfElementsInChangeFile();
-        processElementsInChangeFile();
-        getIdsOfWaysToUpdateGeo();
-        getIdsOfRelationsToUpdateGeo();
-
-        std::cout << "Fetch references..." << std::endl;
-        // Get the ids of all referenced objects
-//        getReferencedRelations(); Skipped atm because osm2rdf does not calculate the geometry for
-//                                  relations that reference other relations
-        getReferencesForRelations();
-        getReferencesForWays();
+        {
+            util::RunReport::Phase phase("parse");
+            readChangeFile();
+            storeIdsOfElementsInChangeFile();
+            processElementsInChangeFile();
+        }
+
+        {
+            util::RunReport::Phase phase("resolveReferences");
+            getIdsOfWaysToUpdateGeo();
+            getIdsOfRelationsToUpdateGeo();
+
+            if (!_config.geometryQueueFile.empty()) {
+                deferGeometryUpdates();
+            }
+
+            std::cout << "Fetch references..." << std::endl;
+            // Get the ids of all referenced objects
+//            getReferencedRelations(); Skipped atm because osm2rdf does not calculate the geometry
+//                                      for relations that reference other relations
+            getReferencesForRelations();
+            getReferencesForWays();
+        }
 
         // Create dummy objects for the referenced osm objects
-        createDummyElements();
+        {
+            util::RunReport::Phase phase("createDummies");
+            createDummyElements();
+        }
 
         // Convert osm objects to triples
         try {
+            util::RunReport::Phase phase("osm2rdf");
             Osm2ttl::convert();
         } catch (std::exception &e) {
             std::cerr << e.what() << std::endl;
@@ -98,12 +171,75 @@ namespace olu::osm {
                 "Exception while trying to convert osm element to ttl");
         }
 
+        UpdatePlan plan;
+        plan.deleteBatches = getDeleteBatches();
+        plan.insertBatches = getInsertBatches();
+        _insertedTriples = plan.getNumberOfInsertedTriples();
+
+        // The plan is journaled before the first batch is sent, so that the update can be resumed
+        // if it is interrupted
+        std::optional<UpdateJournal> journal;
+        if (!_config.journalDir.empty()) {
+            util::RunReport::Phase phase("journal");
+            try {
+                journal.emplace(_config.journalDir);
+                if (!_config.geometryQueueFile.empty()) {
+                    _geometryQueue.saveTo(journal->getGeometryQueuePath());
+                }
+                journal->begin(plan, getTargetUris());
+            } catch (std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                throw OsmChangeHandlerException(
+                    "Exception while trying to write the update journal");
+            }
+        }
+
         // Delete and insert elements from database
-        deleteTriplesFromDatabase();
-        insertTriplesToDatabase();
+        applyPlan(plan, journal ? &*journal : nullptr);
+        finishTargets();
 
-        // Cache of sparql endpoint has to be cleared after the completion`
-        _sparql.clearCache();
+        // The queue is only persisted after the update was successful, so that drained objects
+        // are not lost if the update fails
+        if (!_config.geometryQueueFile.empty()) {
+            _geometryQueue.save();
+        }
+
+        if (journal) {
+            journal->complete();
+        }
+
+        // Publish the throughput of this run
+        const std::size_t objects = _createdNodes.size() + _modifiedNodes.size()
+            + _deletedNodes.size() + _createdWays.size() + _modifiedWays.size()
+            + _deletedWays.size() + _createdRelations.size() + _modifiedRelations.size()
+            + _deletedRelations.size() + _waysToUpdateGeometry.size()
+            + _relationsToUpdateGeometry.size();
+        const double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        util::Metrics::add(util::Metrics::OBJECTS_TOTAL, static_cast<double>(objects));
+        util::Metrics::add(util::Metrics::TRIPLES_TOTAL, static_cast<double>(_insertedTriples));
+        util::Metrics::set(util::Metrics::OBJECTS_PER_SECOND,
+                           seconds > 0 ? static_cast<double>(objects) / seconds : 0);
+        util::Metrics::set(util::Metrics::TRIPLES_PER_SECOND,
+                           seconds > 0 ? static_cast<double>(_insertedTriples) / seconds : 0);
+        if (!_config.geometryQueueFile.empty()) {
+            setQueueDepth("geometryQueue", _geometryQueue.size());
+        }
+
+        util::RunReport::setCounter("nodesCreated", _createdNodes.size());
+        util::RunReport::setCounter("nodesModified", _modifiedNodes.size());
+        util::RunReport::setCounter("nodesDeleted", _deletedNodes.size());
+        util::RunReport::setCounter("waysCreated", _createdWays.size());
+        util::RunReport::setCounter("waysModified", _modifiedWays.size());
+        util::RunReport::setCounter("waysDeleted", _deletedWays.size());
+        util::RunReport::setCounter("relationsCreated", _createdRelations.size());
+        util::RunReport::setCounter("relationsModified", _modifiedRelations.size());
+        util::RunReport::setCounter("relationsDeleted", _deletedRelations.size());
+        util::RunReport::setCounter("waysGeometryUpdated", _waysToUpdateGeometry.size());
+        util::RunReport::setCounter("relationsGeometryUpdated", _relationsToUpdateGeometry.size());
+        util::RunReport::setCounter("referencedNodes", _referencedNodes.size());
+        util::RunReport::setCounter("referencedWays", _referencedWays.size());
+        util::RunReport::setCounter("referencedRelations", _referencedRelations.size());
 
         std::cout << "nodes created: " << _createdNodes.size() << " modified: "
                 << _modifiedNodes.size() << " deleted: " << _deletedNodes.size() << std::endl;
@@ -114,6 +250,59 @@ namespace olu::osm {
                 std::endl;
         std::cout << "updated geometries for " << _waysToUpdateGeometry.size() << " ways "
                 << _relationsToUpdateGeometry.size() << " relations" << std::endl;
+        if (!_config.geometryQueueFile.empty()) {
+            std::cout << "deferred geometries for " << _deferredWays << " ways "
+                    << _deferredRelations << " relations in this run, " << _geometryQueue.size()
+                    << " objects queued in total" << std::endl;
+        }
+    }
+
+    void OsmChangeHandler::resume() {
+        util::ChromeTrace::Span span("OsmChangeHandler::resume", "run");
+
+        UpdateJournal journal(_config.journalDir);
+        UpdatePlan plan;
+        try {
+            util::RunReport::Phase phase("journal");
+            plan = journal.resume(getTargetUris());
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            throw OsmChangeHandlerException("Exception while trying to read the update journal");
+        }
+
+        std::cout << "Resume update from batch " << journal.getFirstPendingBatch(0) << " of "
+                << plan.getNumberOfBatches() << " in journal..." << std::endl;
+        util::RunReport::setCounter("journalSkippedBatches", journal.getFirstPendingBatch(0));
+        util::RunReport::setCounter("journalBatches", plan.getNumberOfBatches());
+
+        applyPlan(plan, &journal);
+        finishTargets();
+
+        // The snapshot holds the queue as it was planned for the interrupted update
+        try {
+            if (!_config.geometryQueueFile.empty()
+                && std::filesystem::exists(journal.getGeometryQueuePath())) {
+                GeometryUpdateQueue snapshot(journal.getGeometryQueuePath());
+                snapshot.load();
+                snapshot.saveTo(_config.geometryQueueFile);
+            }
+
+            journal.complete();
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            throw OsmChangeHandlerException(
+                "Exception while trying to complete the update journal");
+        }
+    }
+
+    std::vector<std::string> OsmChangeHandler::getTargetUris() const {
+        std::vector<std::string> uris;
+        uris.reserve(_targets.size());
+        for (const auto &target : _targets) {
+            uris.emplace_back(target.endpointUri);
+        }
+
+        return uris;
     }
 
     void OsmChangeHandler::createTmpFiles() {
@@ -157,7 +346,21 @@ namespace olu::osm {
             for (const auto &[elementTag, element]: changesetElement) {
                 auto id = getIdFor(element);
 
-                if (changesetTag == cnst::MODIFY_TAG) {
+                // Objects that were created and modified in the merged change files are in the
+                // modify section, but do not exist in the database yet
+                const bool created = changesetTag == cnst::CREATE_TAG ||
+                    (changesetTag == cnst::MODIFY_TAG && _createdObjects.contains(
+                        osmium::char_to_item_type(elementTag.front()), id));
+
+                if (created) {
+                    if (elementTag == cnst::NODE_TAG) {
+                        _createdNodes.insert(id);
+                    } else if (elementTag == cnst::WAY_TAG) {
+                        _createdWays.insert(id);
+                    } else if (elementTag == cnst::RELATION_TAG) {
+                        _createdRelations.insert(id);
+                    }
+                } else if (changesetTag == cnst::MODIFY_TAG) {
                     if (elementTag == cnst::NODE_TAG) {
                         _modifiedNodes.insert(id);
                     } else if (elementTag == cnst::WAY_TAG) {
@@ -169,14 +372,6 @@ namespace olu::osm {
                             _modifiedAreas.insert(id);
                         }
                     }
-                } else if (changesetTag == cnst::CREATE_TAG) {
-                    if (elementTag == cnst::NODE_TAG) {
-                        _createdNodes.insert(id);
-                    } else if (elementTag == cnst::WAY_TAG) {
-                        _createdWays.insert(id);
-                    } else if (elementTag == cnst::RELATION_TAG) {
-                        _createdRelations.insert(id);
-                    }
                 } else if (changesetTag == cnst::DELETE_TAG) {
                     if (elementTag == cnst::NODE_TAG) {
                         _deletedNodes.insert(id);
@@ -278,6 +473,37 @@ namespace olu::osm {
 //        }
     }
 
+    void OsmChangeHandler::deferGeometryUpdates() {
+        _geometryQueue.load();
+
+        // Objects in the change file are handled in this run, regardless of the queue
+        _geometryQueue.removeWays(_createdWays);
+        _geometryQueue.removeWays(_modifiedWays);
+        _geometryQueue.removeWays(_deletedWays);
+        _geometryQueue.removeRelations(_createdRelations);
+        _geometryQueue.removeRelations(_modifiedRelations);
+        _geometryQueue.removeRelations(_deletedRelations);
+
+        _geometryQueue.addWays(_waysToUpdateGeometry);
+        _geometryQueue.addRelations(_relationsToUpdateGeometry);
+
+        if (_geometryQueue.shouldDrain(_config.geometryQueueMaxSize,
+                                       _config.geometryQueueMaxAge)) {
+            std::cout << "Drain geometry update queue with " << _geometryQueue.size()
+                      << " objects..." << std::endl;
+            _waysToUpdateGeometry.clear();
+            _relationsToUpdateGeometry.clear();
+            _geometryQueue.drain(_waysToUpdateGeometry, _relationsToUpdateGeometry);
+        } else {
+            // Only the geometries of this run count as deferred, the queue can hold geometries
+            // of earlier runs as well
+            _deferredWays = _waysToUpdateGeometry.size();
+            _deferredRelations = _relationsToUpdateGeometry.size();
+            _waysToUpdateGeometry.clear();
+            _relationsToUpdateGeometry.clear();
+        }
+    }
+
     void OsmChangeHandler::getReferencedRelations() {
         if (!_relationsToUpdateGeometry.empty()) {
             doInBatches(
@@ -350,6 +576,7 @@ namespace olu::osm {
         }
 
         std::cout << "Create referenced objects..." << std::endl;
+        setQueueDepth("createDummies", count);
         osm2rdf::util::ProgressBar createProgress(count, _config.showProgress);
         size_t counter = 0;
         createProgress.update(counter);
@@ -359,6 +586,7 @@ namespace olu::osm {
         createDummyRelations(createProgress, counter);
 
         createProgress.done();
+        setQueueDepth("createDummies", 0);
     }
 
 
@@ -368,8 +596,15 @@ namespace olu::osm {
             MAX_VALUES_PER_QUERY,
             [this, &counter, progress](std::set<id_t> const& batch) mutable {
                 progress.update(counter += batch.size());
+                // All nodes of a batch are written to the file at once
+                std::string elements;
                 for (auto const& node: _odf.fetchNodes(batch)) {
-                    addToTmpFile(node.getXml(), cnst::NODE_TAG);
+                    if (!elements.empty()) { elements.push_back('\n'); }
+                    node.writeXml(elements);
+                }
+
+                if (!elements.empty()) {
+                    addToTmpFile(elements, cnst::NODE_TAG);
                 }
             });
 
@@ -388,12 +623,18 @@ namespace olu::osm {
             MAX_VALUES_PER_QUERY,
             [this, progress, &counter](std::set<id_t> const& batch) mutable {
                 progress.update(counter += batch.size());
+                std::string elements;
                 for (auto& way: _odf.fetchWays(batch)) {
                     if (_waysToUpdateGeometry.contains(way.getId())) {
                         _odf.fetchWayInfos(way);
                     }
 
-                    addToTmpFile(way.getXml(), cnst::WAY_TAG);
+                    if (!elements.empty()) { elements.push_back('\n'); }
+                    way.writeXml(elements);
+                }
+
+                if (!elements.empty()) {
+                    addToTmpFile(elements, cnst::WAY_TAG);
                 }
             });
 
@@ -410,123 +651,167 @@ namespace olu::osm {
             MAX_VALUES_PER_QUERY,
             [this, &counter, progress](std::set<id_t> const& batch) mutable {
                 progress.update(counter += batch.size());
+                std::string elements;
                 for (auto& rel: _odf.fetchRelations(batch)) {
                     if (_relationsToUpdateGeometry.contains(rel.getId())) {
                         _odf.fetchRelationInfos(rel);
                     }
 
-                    addToTmpFile(rel.getXml(), cnst::RELATION_TAG);
+                    if (!elements.empty()) { elements.push_back('\n'); }
+                    rel.writeXml(elements);
                 }
 
+                if (!elements.empty()) {
+                    addToTmpFile(elements, cnst::RELATION_TAG);
+                }
             });
 
         finalizeTmpFile(cnst::PATH_TO_RELATION_FILE);
     }
 
     void
-    OsmChangeHandler::runUpdateQuery(const std::string &query,
-                                     const std::vector<std::string> &prefixes) {
-        _sparql.setQuery(query);
-        _sparql.setPrefixes(prefixes);
-        try {
-            _sparql.runUpdate();
-        } catch (std::exception &e) {
-            std::cerr << e.what() << std::endl;
-            const std::string msg = "Exception while trying to run sparql update query: "
-                                    + query.substr(0, std::min<int>(query.size(), 100))
-                                    + " ...";
-            throw OsmChangeHandlerException(msg.c_str());
+    OsmChangeHandler::runUpdateQuery(EndpointTarget &target, const std::string &query,
+                                     const std::vector<std::string> &prefixes,
+                                     const std::string &kind,
+                                     const std::size_t batchSize) const {
+        OLU_TRACE2(batch_start, kind.c_str(), batchSize);
+        for (std::size_t attempt = 0; ; ++attempt) {
+            try {
+                target.sparql.runUpdate({query, prefixes, kind, batchSize});
+                ++target.appliedQueries;
+                OLU_TRACE2(batch_end, kind.c_str(), batchSize);
+                return;
+            } catch (std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                if (attempt < _config.updateRetries) {
+                    ++target.retries;
+                    std::this_thread::sleep_for(
+                        UPDATE_RETRY_DELAY * (1L << std::min<std::size_t>(attempt, 6)));
+                    continue;
+                }
+
+                const std::string msg = "Exception while trying to run sparql update query on "
+                                        + target.endpointUri + ": "
+                                        + query.substr(0, std::min<int>(query.size(), 100))
+                                        + " ...";
+                throw OsmChangeHandlerException(msg.c_str());
+            }
+        }
+    }
+
+    void OsmChangeHandler::applyToTargets(
+        const std::size_t count,
+        const std::function<void(EndpointTarget &, osm2rdf::util::ProgressBar &,
+                                 size_t &)> &apply) {
+        // The progress bars of several targets would be printed over each other
+        const bool showProgress = _config.showProgress && _targets.size() == 1;
+        auto applyToTarget = [&apply, count, showProgress](EndpointTarget &target) {
+            if (!target.error.empty()) {
+                return;
+            }
+
+            osm2rdf::util::ProgressBar progress(count, showProgress);
+            size_t counter = 0;
+            progress.update(counter);
+            try {
+                apply(target, progress, counter);
+                progress.done();
+            } catch (std::exception &e) {
+                target.error = e.what();
+            }
+        };
+
+        if (_targets.size() == 1) {
+            applyToTarget(_targets.front());
+            return;
+        }
+
+        std::vector<std::future<void>> results;
+        results.reserve(_targets.size());
+        for (auto &target : _targets) {
+            results.emplace_back(std::async(std::launch::async, applyToTarget, std::ref(target)));
+        }
+        for (auto &result : results) {
+            result.get();
+        }
+    }
+
+    void OsmChangeHandler::checkTargets() const {
+        if (_targets.size() > 1) {
+            for (std::size_t i = 0; i < _targets.size(); ++i) {
+                const auto &target = _targets[i];
+                const std::string name = "updateTarget" + std::to_string(i);
+                util::RunReport::setCounter(name + "Queries", target.appliedQueries);
+                util::RunReport::setCounter(name + "Retries", target.retries);
+                util::RunReport::setCounter(name + "Failed", target.error.empty() ? 0 : 1);
+
+                std::cout << "target " << target.endpointUri << ": "
+                        << target.appliedQueries << " queries applied, " << target.retries
+                        << " retries" << (target.error.empty() ? "" : ", FAILED") << std::endl;
+            }
+        }
+
+        std::string failed;
+        for (const auto &target : _targets) {
+            if (!target.error.empty()) {
+                failed += (failed.empty() ? "" : "; ") + target.error;
+            }
+        }
+
+        if (!failed.empty()) {
+            throw OsmChangeHandlerException(failed.c_str());
         }
     }
 
-    void OsmChangeHandler::deleteNodesFromDatabase(osm2rdf::util::ProgressBar &progress,
-                                                   size_t &counter) {
+    void OsmChangeHandler::finishTargets() {
+        // Cache of sparql endpoint has to be cleared after the completion`
+        for (auto &target : _targets) {
+            if (target.error.empty()) {
+                target.sparql.clearCache();
+            }
+        }
+        checkTargets();
+    }
+
+    std::vector<UpdatePlan::DeleteBatch> OsmChangeHandler::getDeleteBatches() const {
         std::set<id_t> nodesToDelete;
         nodesToDelete.insert(_deletedNodes.begin(), _deletedNodes.end());
         nodesToDelete.insert(_modifiedNodes.begin(), _modifiedNodes.end());
 
-        doInBatches(
-            nodesToDelete,
-            MAX_VALUES_PER_QUERY,
-            [this, progress, &counter](std::set<id_t> const &batch) mutable {
-                runUpdateQuery(_queryWriter.writeDeleteQuery(batch, "osmnode"),
-                               cnst::PREFIXES_FOR_NODE_DELETE_QUERY);
-                progress.update(counter += batch.size());
-            });
-    }
-
-    void OsmChangeHandler::deleteWaysFromDatabase(osm2rdf::util::ProgressBar &progress,
-                                                  size_t &counter) {
         std::set<id_t> waysToDelete;
         waysToDelete.insert(_deletedWays.begin(), _deletedWays.end());
         waysToDelete.insert(_modifiedWays.begin(), _modifiedWays.end());
         waysToDelete.insert(_waysToUpdateGeometry.begin(), _waysToUpdateGeometry.end());
 
-        doInBatches(
-            waysToDelete,
-            MAX_VALUES_PER_QUERY,
-            [this, &counter, progress](std::set<id_t> const &batch) mutable {
-                runUpdateQuery(_queryWriter.writeDeleteQuery(batch, "osmway"),
-                               cnst::PREFIXES_FOR_WAY_DELETE_QUERY);
-                progress.update(counter += batch.size());
-            });
-    }
-
-    void OsmChangeHandler::deleteRelationsFromDatabase(osm2rdf::util::ProgressBar &progress,
-                                                       size_t &counter) {
         std::set<id_t> relationsToDelete;
         relationsToDelete.insert(_deletedRelations.begin(), _deletedRelations.end());
         relationsToDelete.insert(_modifiedRelations.begin(), _modifiedRelations.end());
         relationsToDelete.insert(_relationsToUpdateGeometry.begin(),
                                  _relationsToUpdateGeometry.end());
 
-        doInBatches(
-            relationsToDelete,
-            MAX_VALUES_PER_QUERY,
-            [this, &counter, progress](std::set<id_t> const &batch) mutable {
-                runUpdateQuery(_queryWriter.writeDeleteQuery(batch, "osmrel"),
-                               cnst::PREFIXES_FOR_RELATION_DELETE_QUERY);
-                progress.update(counter += batch.size());
-            });
-    }
-
-    void OsmChangeHandler::deleteTriplesFromDatabase() {
-        const std::size_t count = _deletedNodes.size() + _modifiedNodes.size()
-            + _deletedWays.size() + _modifiedWays.size() + _waysToUpdateGeometry.size()
-            + _deletedRelations.size() + _modifiedRelations.size()
-            + _relationsToUpdateGeometry.size();
-
-        if (count == 0) {
-            std::cout << "No elements to delete..." << std::endl;
-            return;
+        // The batches are computed once and written as queries for each target
+        std::vector<UpdatePlan::DeleteBatch> batches;
+        for (const auto &[osmTag, ids] : {std::pair{"osmnode", &nodesToDelete},
+                                          std::pair{"osmway", &waysToDelete},
+                                          std::pair{"osmrel", &relationsToDelete}}) {
+            for (auto &batch : toBatches(*ids, MAX_VALUES_PER_QUERY)) {
+                batches.push_back({osmTag, std::move(batch)});
+            }
         }
 
-        std::cout << "Deleting elements from database..." << std::endl;
-        osm2rdf::util::ProgressBar deleteProgress(count, _config.showProgress);
-        size_t counter = 0;
-        deleteProgress.update(counter);
-
-        deleteNodesFromDatabase(deleteProgress, counter);
-        deleteWaysFromDatabase(deleteProgress, counter);
-        deleteRelationsFromDatabase(deleteProgress, counter);
-
-        deleteProgress.done();
+        return batches;
     }
 
-
-    void OsmChangeHandler::insertTriplesToDatabase() {
-        auto triples = filterRelevantTriples();
-
-        if (triples.empty()) {
-            std::cout << "No triples to insert into database..." << std::endl;
-            return;
+    std::vector<UpdatePlan::InsertBatch> OsmChangeHandler::getInsertBatches() {
+        std::vector<Triple> triples;
+        {
+            util::RunReport::Phase phase("filter");
+            triples = filterRelevantTriples();
         }
 
-        std::cout << "Inserting triples into database..." << std::endl;
-        osm2rdf::util::ProgressBar insertProgress(triples.size(), _config.showProgress);
-        size_t counter = 0;
-        insertProgress.update(counter);
-
+        // The batches are computed once and written as queries for each target. For each batch
+        // the number of triples that were processed after it is stored as well.
+        std::vector<UpdatePlan::InsertBatch> batches;
         std::vector<std::string> tripleBatch;
         for (size_t i = 0; i < triples.size(); ++i) {
             auto [s, p, o] = triples[i];
@@ -562,16 +847,80 @@ namespace olu::osm {
             tripleBatch.emplace_back(triple.str());
 
             if (tripleBatch.size() == MAX_VALUES_PER_QUERY || i == triples.size() - 1) {
-                runUpdateQuery(_queryWriter.writeInsertQuery(tripleBatch), cnst::DEFAULT_PREFIXES);
+                batches.push_back({std::move(tripleBatch), i + 1});
                 tripleBatch.clear();
+            }
+        }
 
-                if (i == triples.size() - 1) {
-                    insertProgress.done();
-                } else {
-                    insertProgress.update(counter += MAX_VALUES_PER_QUERY);
-                }
+        return batches;
+    }
+
+    void OsmChangeHandler::applyPlan(const UpdatePlan &plan, UpdateJournal *journal) {
+        // Batches that a target acknowledged before the update was interrupted are not sent again
+        auto isPending = [this, journal](const EndpointTarget &target, const std::size_t batch) {
+            return journal == nullptr
+                || batch >= journal->getFirstPendingBatch(&target - _targets.data());
+        };
+        auto acknowledge = [this, journal](const EndpointTarget &target, const std::size_t batch) {
+            if (journal != nullptr) {
+                journal->acknowledge(&target - _targets.data(), batch);
             }
+        };
+
+        {
+            util::RunReport::Phase phase("delete");
+            const std::size_t count = plan.getNumberOfDeletedObjects();
+            if (count == 0) {
+                std::cout << "No elements to delete..." << std::endl;
+            } else {
+                std::cout << "Deleting elements from database..." << std::endl;
+                setQueueDepth("delete", count);
+                applyToTargets(count, [&](EndpointTarget &target,
+                                          osm2rdf::util::ProgressBar &progress, size_t &counter) {
+                    for (std::size_t batch = 0; batch < plan.deleteBatches.size(); ++batch) {
+                        const auto &[osmTag, ids] = plan.deleteBatches[batch];
+                        if (isPending(target, batch)) {
+                            runUpdateQuery(target, target.queryWriter.writeDeleteQuery(ids, osmTag),
+                                           getDeletePrefixes(osmTag), "writeDeleteQuery",
+                                           ids.size());
+                            acknowledge(target, batch);
+                        }
+                        progress.update(counter += ids.size());
+                    }
+                });
+                setQueueDepth("delete", 0);
+            }
+        }
+
+        util::RunReport::Phase phase("insert");
+        if (plan.insertBatches.empty()) {
+            std::cout << "No triples to insert into database..." << std::endl;
+            return;
         }
+
+        std::cout << "Inserting triples into database..." << std::endl;
+        const std::size_t tripleCount = plan.getNumberOfInsertedTriples();
+        setQueueDepth("insert", tripleCount);
+        applyToTargets(tripleCount, [&](EndpointTarget &target,
+                                        osm2rdf::util::ProgressBar &progress, size_t &counter) {
+            for (std::size_t batch = 0; batch < plan.insertBatches.size(); ++batch) {
+                const auto &[triples, processedTriples] = plan.insertBatches[batch];
+                // Insert batches are numbered after the delete batches
+                const std::size_t batchNumber = plan.deleteBatches.size() + batch;
+                if (isPending(target, batchNumber)) {
+                    runUpdateQuery(target, target.queryWriter.writeInsertQuery(triples),
+                                   cnst::DEFAULT_PREFIXES, "writeInsertQuery", triples.size());
+                    acknowledge(target, batchNumber);
+                }
+
+                // The queue depth follows the main target
+                counter = processedTriples;
+                if (&target == &_targets.front()) {
+                    setQueueDepth("insert", tripleCount - counter);
+                }
+                progress.update(counter);
+            }
+        });
     }
 
     std::vector<Triple> OsmChangeHandler::filterRelevantTriples() {
@@ -589,6 +938,15 @@ namespace olu::osm {
         relationsToInsert.insert(_modifiedRelations.begin(), _modifiedRelations.end());
         relationsToInsert.insert(_relationsToUpdateGeometry.begin(), _relationsToUpdateGeometry.end());
 
+        return filterRelevantTriples(cnst::PATH_TO_OUTPUT_FILE, nodesToInsert, waysToInsert,
+                                     relationsToInsert);
+    }
+
+    std::vector<Triple>
+    OsmChangeHandler::filterRelevantTriples(const std::filesystem::path &ttlFile,
+                                            const std::set<id_t> &nodesToInsert,
+                                            const std::set<id_t> &waysToInsert,
+                                            const std::set<id_t> &relationsToInsert) {
         // Triples that should be inserted into the database
         std::vector<Triple> relevantTriples;
         // current link object, for example member nodes or geometries
@@ -597,7 +955,7 @@ namespace olu::osm {
         // Loop over each triple that osm2rdf outputs
         std::string line;
         std::ifstream osm2rdfOutput;
-        osm2rdfOutput.open(cnst::PATH_TO_OUTPUT_FILE);
+        osm2rdfOutput.open(ttlFile);
         while (std::getline(osm2rdfOutput, line)) {
             if (line.starts_with("@")) {
                 continue;
@@ -607,7 +965,7 @@ namespace olu::osm {
 
             // Decode tag values
             if (pre.starts_with("osmkey:")) {
-                obj = util::XmlReader::xmlDecode(obj);
+                util::XmlReader::xmlDecodeInPlace(obj);
             }
 
             // Check if there is currently a link set
@@ -20,10 +20,16 @@
 #include "config/Constants.h"
 #include "util/URLHelper.h"
 #include "util/HttpRequest.h"
+#include "util/RequestTrace.h"
 #include "util/OsmObjectHelper.h"
 #include "util/XmlReader.h"
 #include "sparql/QueryWriter.h"
 
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <optional>
+#include <string_view>
 #include <vector>
 #include <boost/regex.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -32,14 +38,134 @@
 
 namespace cnst = olu::config::constants;
 namespace olu::osm {
+    namespace {
+        // Splits a `GROUP_CONCAT` list at ';' like `std::getline` does, but returns views into
+        // the list instead of copies
+        class GroupConcatTokenizer {
+        public:
+            explicit GroupConcatTokenizer(const std::string_view list) : _rest(list) {}
+
+            bool next(std::string_view &token) {
+                if (_rest.empty()) {
+                    return false;
+                }
+
+                const auto end = _rest.find(';');
+                token = _rest.substr(0, end);
+                _rest = end == std::string_view::npos ? std::string_view{} : _rest.substr(end + 1);
+                return true;
+            }
+
+        private:
+            std::string_view _rest;
+        };
+
+        // Returns an upper bound for the number of elements in a `GROUP_CONCAT` list
+        std::size_t countElements(const std::string_view list) {
+            return list.empty() ? 0 : std::ranges::count(list, ';') + 1;
+        }
+
+        int parsePosition(GroupConcatTokenizer &positions) {
+            std::string_view position;
+            int value = 0;
+            if (!positions.next(position)) {
+                throw OsmDataFetcherException("Member list has fewer positions than members");
+            }
+
+            const auto [ptr, ec] = std::from_chars(position.data(),
+                                                   position.data() + position.size(), value);
+            if (ec != std::errc() || ptr != position.data() + position.size()) {
+                const std::string msg = "Cant interpret member position: " + std::string(position);
+                throw OsmDataFetcherException(msg.c_str());
+            }
+
+            return value;
+        }
+
+        // Orders the members by their position and keeps only the first member for each position
+        template <typename T>
+        std::vector<T> sortByPosition(std::vector<std::pair<int, T>> &positioned) {
+            // GROUP_CONCAT usually keeps the order of the members, in which case nothing is sorted
+            if (!std::ranges::is_sorted(positioned, {}, &std::pair<int, T>::first)) {
+                std::ranges::stable_sort(positioned, {}, &std::pair<int, T>::first);
+            }
+
+            const auto duplicates = std::ranges::unique(positioned, {}, &std::pair<int, T>::first);
+            positioned.erase(duplicates.begin(), duplicates.end());
+
+            std::vector<T> members;
+            members.reserve(positioned.size());
+            for (auto &[position, member] : positioned) {
+                members.emplace_back(std::move(member));
+            }
+            return members;
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    std::vector<id_t> OsmDataFetcher::decodeWayMembers(const std::string_view nodeUris,
+                                                       const std::string_view nodePositions) {
+        std::vector<std::pair<int, id_t>> positioned;
+        positioned.reserve(countElements(nodeUris));
+
+        GroupConcatTokenizer uris(nodeUris);
+        GroupConcatTokenizer positions(nodePositions);
+        std::string_view uri;
+        while (uris.next(uri)) {
+            if (uri.empty()) { continue; }
+
+            const auto position = parsePosition(positions);
+            positioned.emplace_back(position, OsmObjectHelper::getIdFromUri(uri));
+        }
+
+        return sortByPosition(positioned);
+    }
+
+    // _____________________________________________________________________________________________
+    std::vector<RelationMember>
+    OsmDataFetcher::decodeRelationMembers(const std::string_view memberUris,
+                                          const std::string_view memberRoles,
+                                          const std::string_view memberPositions) {
+        std::vector<std::pair<int, RelationMember>> positioned;
+        positioned.reserve(countElements(memberUris));
+
+        GroupConcatTokenizer uris(memberUris);
+        GroupConcatTokenizer roles(memberRoles);
+        GroupConcatTokenizer positions(memberPositions);
+        std::string_view uri;
+        while (uris.next(uri)) {
+            if (uri.empty()) { continue; }
+
+            std::string_view role;
+            roles.next(role);
+            const auto position = parsePosition(positions);
+
+            OsmObjectType type;
+            if (uri.starts_with(cnst::OSM_NODE_URI)) {
+                type = OsmObjectType::NODE;
+            } else if (uri.starts_with(cnst::OSM_WAY_URI)) {
+                type = OsmObjectType::WAY;
+            } else if (uri.starts_with(cnst::OSM_REL_URI)) {
+                type = OsmObjectType::RELATION;
+            } else {
+                const std::string msg = "Cant interpret member uri: " + std::string(uri);
+                throw OsmDataFetcherException(msg.c_str());
+            }
+            positioned.emplace_back(position, RelationMember(OsmObjectHelper::getIdFromUri(uri),
+                                                             type, std::string(role)));
+        }
+
+        return sortByPosition(positioned);
+    }
+
     // _____________________________________________________________________________________________
     boost::property_tree::ptree OsmDataFetcher::runQuery(
-        const std::string &query,
-        const std::vector<std::string> &prefixes) {
+        std::string query,
+        const std::vector<std::string> &prefixes,
+        const std::string &kind,
+        const std::size_t batchSize) {
 
-        _sparqlWrapper.setQuery(query);
-        _sparqlWrapper.setPrefixes(prefixes);
-        return _sparqlWrapper.runQuery();
+        return _sparqlWrapper.runQuery({std::move(query), prefixes, kind, batchSize});
     }
 
     // _____________________________________________________________________________________________
@@ -60,6 +186,7 @@ namespace olu::osm {
 
         std::string response;
         response = request.perform();
+        util::RequestTrace::write("fetchDatabaseState", 1, request);
 
         return extractStateFromStateFile(response);
     }
@@ -75,6 +202,7 @@ namespace olu::osm {
         // Get state file from osm server
         auto request = util::HttpRequest(util::GET, url);
         const std::string response = request.perform();
+        util::RequestTrace::write("fetchLatestDatabaseState", 1, request);
         return extractStateFromStateFile(response);
     }
 
@@ -90,16 +218,48 @@ namespace olu::osm {
         pathSegments.emplace_back(diffFilename);
         std::string url = util::URLHelper::buildUrl(pathSegments);
 
-        // Get change file from server and write to cache file.
-        std::string filePath = cnst::PATH_TO_CHANGE_FILE_DIR + std::to_string(sequenceNumber) +
-                                cnst::OSM_CHANGE_FILE_EXTENSION + cnst::GZIP_EXTENSION;
-        auto request = util::HttpRequest(util::GET, url);
+        // Get change file from server and write to cache file. The file is downloaded to a
+        // temporary file outside the change file directory first, so that a failed download does
+        // not leave a truncated change file that a later run would read.
+        const std::string fileName = std::to_string(sequenceNumber) +
+                                     cnst::OSM_CHANGE_FILE_EXTENSION + cnst::GZIP_EXTENSION;
+        std::string filePath = cnst::PATH_TO_CHANGE_FILE_DIR + fileName;
+        const std::string tmpPath = cnst::PATH_TO_TEMP_DIR + fileName + ".download";
+        try {
+            std::ofstream outputFile(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!outputFile) {
+                const std::string msg = "Can not write change file: " + tmpPath;
+                throw OsmDataFetcherException(msg.c_str());
+            }
+
+            // The change file is written to the file while it is downloaded
+            auto request = util::HttpRequest(util::GET, url);
+            request.setResponseSink([&outputFile](const std::string_view chunk) {
+                outputFile.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+                if (!outputFile) {
+                    throw OsmDataFetcherException("Could not write downloaded change file");
+                }
+            });
+            request.perform();
+            util::RequestTrace::write("fetchChangeFile", 1, request);
+            if (request.getResponseCode() != 200) {
+                const std::string msg = "Change file " + url + " could not be downloaded, "
+                                        "status " + std::to_string(request.getResponseCode());
+                throw OsmDataFetcherException(msg.c_str());
+            }
 
-        auto response = request.perform();
-        std::ofstream outputFile;
-        outputFile.open(filePath);
-        outputFile << response;
-        outputFile.close();
+            outputFile.close();
+            if (!outputFile) {
+                const std::string msg = "Could not write change file: " + tmpPath;
+                throw OsmDataFetcherException(msg.c_str());
+            }
+
+            std::filesystem::rename(tmpPath, filePath);
+        } catch (...) {
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            throw;
+        }
 
         return filePath;
     }
@@ -109,9 +269,11 @@ namespace olu::osm {
     OsmDataFetcher::fetchNodes(const std::set<id_t> &nodeIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForNodeLocations(nodeIds),
-            cnst::PREFIXES_FOR_NODE_LOCATION);
+            cnst::PREFIXES_FOR_NODE_LOCATION,
+            "writeQueryForNodeLocations", nodeIds.size());
 
         std::vector<Node> nodes;
+        nodes.reserve(nodeIds.size());
         for (const auto &result : response.get_child("sparql.results")) {
             id_t id;
             std::string locationAsWkt;
@@ -145,7 +307,8 @@ namespace olu::osm {
     std::string OsmDataFetcher::fetchLatestTimestampOfAnyNode() {
         const auto response = runQuery(
             _queryWriter.writeQueryForLatestNodeTimestamp(),
-            cnst::PREFIXES_FOR_LATEST_NODE_TIMESTAMP);
+            cnst::PREFIXES_FOR_LATEST_NODE_TIMESTAMP,
+            "writeQueryForLatestNodeTimestamp", 1);
 
         std::string timestamp;
         try {
@@ -206,15 +369,17 @@ namespace olu::osm {
     OsmDataFetcher::fetchRelations(const std::set<id_t> &relationIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForRelations(relationIds),
-            cnst::PREFIXES_FOR_RELATION_MEMBERS);
+            cnst::PREFIXES_FOR_RELATION_MEMBERS,
+            "writeQueryForRelations", relationIds.size());
 
         std::vector<Relation> relations;
+        relations.reserve(relationIds.size());
         for (const auto &result : response.get_child("sparql.results")) {
             id_t relationId;
             std::string type;
-            std::string memberUris;
-            std::string memberRoles;
-            std::string memberPositions;
+            std::string_view memberUris;
+            std::string_view memberRoles;
+            std::string_view memberPositions;
             for (const auto &binding : result.second.get_child("")) {
                 auto name = util::XmlReader::readAttribute("<xmlattr>.name",binding.second);
                 if (name == "rel") {
@@ -227,51 +392,22 @@ namespace olu::osm {
                 }
 
                 if (name == "memberUris") {
-                    memberUris = binding.second.get<std::string>("literal");
+                    memberUris = binding.second.get_child("literal").data();
                 }
 
                 if (name == "memberRoles") {
-                    memberRoles = binding.second.get<std::string>("literal");
+                    memberRoles = binding.second.get_child("literal").data();
                 }
 
                 if (name == "memberPositions") {
-                    memberPositions = binding.second.get<std::string>("literal");
+                    memberPositions = binding.second.get_child("literal").data();
                 }
             }
 
             Relation relation(relationId);
             relation.setType(type);
-
-            std::stringstream uriStream(memberUris);
-            std::stringstream rolesStream(memberRoles);
-            std::stringstream posStream(memberPositions);
-
-            std::string uri;
-            std::string role;
-            std::string position;
-            std::map<int, RelationMember> members;
-            while (std::getline(uriStream, uri, ';')) {
-                if (uri.empty()) { continue; }
-
-                std::getline(rolesStream, role, ';');
-                std::getline(posStream, position, ';');
-                id_t id = OsmObjectHelper::getIdFromUri(uri);
-
-                std::string osmTag;
-                if (uri.starts_with(cnst::OSM_NODE_URI)) {
-                    osmTag = cnst::NODE_TAG;
-                } else if (uri.starts_with(cnst::OSM_WAY_URI)) {
-                    osmTag = cnst::WAY_TAG;
-                } else if (uri.starts_with(cnst::OSM_REL_URI)) {
-                    osmTag = cnst::RELATION_TAG;
-                }
-                members.emplace(std::stoi(position), RelationMember(id, osmTag, role));
-            }
-
-            for (auto [pos, member] : members) {
-                relation.addMember(member);
-            }
-            relations.emplace_back(relation);
+            relation.setMembers(decodeRelationMembers(memberUris, memberRoles, memberPositions));
+            relations.emplace_back(std::move(relation));
         }
 
         return relations;
@@ -281,13 +417,15 @@ namespace olu::osm {
     std::vector<Way> OsmDataFetcher::fetchWays(const std::set<id_t> &wayIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForWaysMembers(wayIds),
-            cnst::PREFIXES_FOR_WAY_MEMBERS);
+            cnst::PREFIXES_FOR_WAY_MEMBERS,
+            "writeQueryForWaysMembers", wayIds.size());
 
         std::vector<Way> ways;
+        ways.reserve(wayIds.size());
         for (const auto &result : response.get_child("sparql.results")) {
             id_t wayId;
-            std::string nodeUris;
-            std::string nodePositions;
+            std::string_view nodeUris;
+            std::string_view nodePositions;
             for (const auto &binding : result.second.get_child("")) {
                 auto name = util::XmlReader::readAttribute("<xmlattr>.name",binding.second);
                 if (name == "way") {
@@ -296,34 +434,17 @@ namespace olu::osm {
                 }
 
                 if (name == "nodeUris") {
-                    nodeUris = binding.second.get<std::string>("literal");
+                    nodeUris = binding.second.get_child("literal").data();
                 }
 
                 if (name == "nodePositions") {
-                    nodePositions = binding.second.get<std::string>("literal");
+                    nodePositions = binding.second.get_child("literal").data();
                 }
             }
 
             Way way(wayId);
-
-            std::stringstream uriStream(nodeUris);
-            std::stringstream posStream(nodePositions);
-
-            std::string uri;
-            std::string position;
-            std::map<int, id_t> nodes;
-            while (std::getline(uriStream, uri, ';')) {
-                if (uri.empty()) { continue; }
-
-                std::getline(posStream, position, ';');
-                id_t id = OsmObjectHelper::getIdFromUri(uri);
-                nodes.emplace(std::stoi(position), id);
-            }
-
-            for (auto [pos, nodeId] : nodes) {
-                way.addMember(nodeId);
-            }
-            ways.emplace_back(way);
+            way.setMembers(decodeWayMembers(nodeUris, nodePositions));
+            ways.emplace_back(std::move(way));
         }
 
         return ways;
@@ -334,7 +455,8 @@ namespace olu::osm {
         std::string subject = "osmway:" + std::to_string(way.getId());
         auto response = runQuery(
             _queryWriter.writeQueryForTagsAndTimestamp(subject),
-            cnst::PREFIXES_FOR_WAY_TAGS);
+            cnst::PREFIXES_FOR_WAY_TAGS,
+            "writeQueryForTagsAndTimestamp", 1);
 
         for (const auto &result : response.get_child("sparql.results")) {
             std::string key; std::string value;
@@ -366,7 +488,8 @@ namespace olu::osm {
         std::string subject = "osmrel:" + std::to_string(relation.getId());
         auto response = runQuery(
             _queryWriter.writeQueryForTagsAndTimestamp(subject),
-            cnst::PREFIXES_FOR_RELATION_TAGS);
+            cnst::PREFIXES_FOR_RELATION_TAGS,
+            "writeQueryForTagsAndTimestamp", 1);
 
         for (const auto &result : response.get_child("sparql.results")) {
             std::string key; std::string value;
@@ -398,13 +521,12 @@ namespace olu::osm {
     std::vector<id_t> OsmDataFetcher::fetchWaysMembers(const std::set<id_t> &wayIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForReferencedNodes(wayIds),
-            cnst::PREFIXES_FOR_WAY_MEMBERS);
+            cnst::PREFIXES_FOR_WAY_MEMBERS,
+            "writeQueryForReferencedNodes", wayIds.size());
 
         std::vector<id_t> nodeIds;
-        for (const auto &result : response.get_child("sparql.results")) {
-            auto memberUri = result.second.get<std::string>("binding.uri");
-            nodeIds.emplace_back(OsmObjectHelper::getIdFromUri(memberUri));
-        }
+        OsmObjectHelper::getIdsFromUris(response.get_child("sparql.results"), "binding.uri",
+                                        nodeIds);
 
         return nodeIds;
     }
@@ -414,12 +536,13 @@ namespace olu::osm {
     OsmDataFetcher::fetchRelationMembers(const std::set<id_t> &relIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForRelationMembers(relIds),
-            cnst::PREFIXES_FOR_RELATION_MEMBERS);
+            cnst::PREFIXES_FOR_RELATION_MEMBERS,
+            "writeQueryForRelationMembers", relIds.size());
 
         std::vector<id_t> nodeIds;
         std::vector<id_t> wayIds;
         for (const auto &result : response.get_child("sparql.results")) {
-            auto memberUri = result.second.get<std::string>("binding.uri");
+            const auto &memberUri = result.second.get_child("binding.uri").data();
 
             id_t id = OsmObjectHelper::getIdFromUri(memberUri);
             if (memberUri.starts_with(cnst::OSM_NODE_URI)) {
@@ -436,13 +559,12 @@ namespace olu::osm {
     std::vector<id_t> OsmDataFetcher::fetchWaysReferencingNodes(const std::set<id_t> &nodeIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForWaysReferencingNodes(nodeIds),
-            cnst::PREFIXES_FOR_WAYS_REFERENCING_NODE);
+            cnst::PREFIXES_FOR_WAYS_REFERENCING_NODE,
+            "writeQueryForWaysReferencingNodes", nodeIds.size());
 
         std::vector<id_t> memberSubjects;
-        for (const auto &result : response.get_child("sparql.results")) {
-            auto memberUri = result.second.get<std::string>("binding.uri");
-            memberSubjects.emplace_back(OsmObjectHelper::getIdFromUri(memberUri));
-        }
+        OsmObjectHelper::getIdsFromUris(response.get_child("sparql.results"), "binding.uri",
+                                        memberSubjects);
 
         return memberSubjects;
     }
@@ -452,14 +574,12 @@ namespace olu::osm {
     OsmDataFetcher::fetchRelationsReferencingNodes(const std::set<id_t> &nodeIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForRelationsReferencingNodes(nodeIds),
-            cnst::PREFIXES_FOR_RELATIONS_REFERENCING_NODE);
+            cnst::PREFIXES_FOR_RELATIONS_REFERENCING_NODE,
+            "writeQueryForRelationsReferencingNodes", nodeIds.size());
 
         std::vector<id_t> relationIds;
-        for (const auto &result : response.get_child(
-                "sparql.results")) {
-            auto memberUri = result.second.get<std::string>("binding.uri");
-            relationIds.emplace_back(OsmObjectHelper::getIdFromUri(memberUri));
-        }
+        OsmObjectHelper::getIdsFromUris(response.get_child("sparql.results"), "binding.uri",
+                                        relationIds);
 
         return relationIds;
     }
@@ -468,13 +588,12 @@ namespace olu::osm {
     std::vector<id_t> OsmDataFetcher::fetchRelationsReferencingWays(const std::set<id_t> &wayIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForRelationsReferencingWays(wayIds),
-            cnst::PREFIXES_FOR_RELATIONS_REFERENCING_WAY);
+            cnst::PREFIXES_FOR_RELATIONS_REFERENCING_WAY,
+            "writeQueryForRelationsReferencingWays", wayIds.size());
 
         std::vector<id_t> relationIds;
-        for (const auto &result : response.get_child("sparql.results")) {
-            auto uri = result.second.get<std::string>("binding.uri");
-            relationIds.emplace_back(OsmObjectHelper::getIdFromUri(uri));
-        }
+        OsmObjectHelper::getIdsFromUris(response.get_child("sparql.results"), "binding.uri",
+                                        relationIds);
 
         return relationIds;
     }
@@ -484,15 +603,50 @@ namespace olu::osm {
     OsmDataFetcher::fetchRelationsReferencingRelations(const std::set<id_t> &relationIds) {
         auto response = runQuery(
             _queryWriter.writeQueryForRelationsReferencingRelations(relationIds),
-            cnst::PREFIXES_FOR_RELATIONS_REFERENCING_RELATIONS);
+            cnst::PREFIXES_FOR_RELATIONS_REFERENCING_RELATIONS,
+            "writeQueryForRelationsReferencingRelations", relationIds.size());
 
         std::vector<id_t> refRelIds;
+        OsmObjectHelper::getIdsFromUris(response.get_child("sparql.results"), "binding.uri",
+                                        refRelIds);
+
+        return refRelIds;
+    }
+
+    // _____________________________________________________________________________________________
+    std::map<id_t, std::size_t> OsmDataFetcher::fetchVersions(const std::set<id_t> &ids,
+                                                              const std::string &osmTag) {
+        auto response = runQuery(
+            _queryWriter.writeQueryForVersions(ids, osmTag),
+            cnst::PREFIXES_FOR_VERSIONS,
+            "writeQueryForVersions", ids.size());
+
+        std::map<id_t, std::size_t> versions;
         for (const auto &result : response.get_child("sparql.results")) {
-            auto uri = result.second.get<std::string>("binding.uri");
-            refRelIds.emplace_back(OsmObjectHelper::getIdFromUri(uri));
+            std::optional<id_t> id;
+            std::optional<std::size_t> version;
+            for (const auto &binding : result.second.get_child("")) {
+                const auto name = util::XmlReader::readAttribute("<xmlattr>.name", binding.second);
+                if (name == "s") {
+                    id = OsmObjectHelper::getIdFromUri(binding.second.get<std::string>("uri"));
+                } else if (name == "version") {
+                    const auto literal = binding.second.get<std::string>("literal");
+                    std::size_t value;
+                    const auto [ptr, ec] = std::from_chars(literal.data(),
+                                                           literal.data() + literal.size(),
+                                                           value);
+                    if (ec == std::errc()) {
+                        version = value;
+                    }
+                }
+            }
+
+            if (id && version) {
+                versions[*id] = *version;
+            }
         }
 
-        return refRelIds;
+        return versions;
     }
 
 }
@@ -3,8 +3,16 @@
 //
 
 #include "osm/OsmUpdater.h"
+#include "osm/AppliedChangeFilter.h"
+#include "osm/ChangeCompactor.h"
 #include "osm/OsmChangeHandler.h"
+#include "osm/RegionClipper.h"
+#include "osm/UpdateJournal.h"
 #include "config/Constants.h"
+#include "util/RunReport.h"
+#include "util/RequestTrace.h"
+#include "util/Metrics.h"
+#include "util/ChromeTrace.h"
 #include "osm2rdf/util/Time.h"
 
 #include <osmium/visitor.hpp>
@@ -33,9 +41,81 @@ namespace olu::osm {
             std::cerr << e.what() << std::endl;
             throw OsmUpdaterException("Failed to create temporary directories");
         }
+
+        if (!_config.requestTraceFile.empty()) {
+            try {
+                util::RequestTrace::open(_config.requestTraceFile);
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                throw OsmUpdaterException("Failed to open request trace file");
+            }
+        }
+
+        if (_config.metricsPort > 0) {
+            try {
+                _metricsServer = std::make_unique<util::MetricsServer>(
+                    static_cast<unsigned short>(_config.metricsPort));
+                _metricsServer->start();
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                throw OsmUpdaterException("Failed to start metrics endpoint");
+            }
+        }
+
+        if (!_config.chromeTraceFile.empty()) {
+            try {
+                util::ChromeTrace::open(_config.chromeTraceFile);
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                throw OsmUpdaterException("Failed to open chrome trace file");
+            }
+        }
+
+        try {
+            if (!_config.clipBbox.empty()) {
+                _region = util::Region::fromBbox(_config.clipBbox);
+            } else if (!_config.clipPolygonFile.empty()) {
+                _region = util::Region::fromPolygonFile(_config.clipPolygonFile);
+            }
+        } catch (const util::RegionException &e) {
+            std::cerr << e.what() << std::endl;
+            throw OsmUpdaterException("Failed to read the region to clip the changes to");
+        }
+    }
+
+    OsmUpdater::~OsmUpdater() {
+        // Also terminates the timeline if the run was aborted by an exception
+        util::ChromeTrace::close();
     }
 
     void OsmUpdater::run() {
+        util::ChromeTrace::Span span("OsmUpdater::run", "run");
+
+        // An update that was interrupted is completed before new changes are processed
+        if (!_config.journalDir.empty() && UpdateJournal::hasPendingPlan(_config.journalDir)) {
+            std::cout
+            << osm2rdf::util::currentTimeFormatted()
+            << "Resume interrupted update from journal: "
+            << _config.journalDir
+            << std::endl;
+
+            auto och{OsmChangeHandler(_config)};
+            och.resume();
+
+            // The journal was written for the change files in the input directory, which are
+            // therefore already applied
+            if (!(_config.changeFileDir.empty())) {
+                deleteTmpDir();
+                writeRunReport();
+
+                std::cout
+                << osm2rdf::util::currentTimeFormatted()
+                << "DONE"
+                << std::endl;
+                return;
+            }
+        }
+
         // Handle either local directory with change files or external one depending on the user
         // input
         if (!(_config.changeFileDir.empty())) {
@@ -45,9 +125,9 @@ namespace olu::osm {
             << _config.changeFileDir
             << std::endl;
 
-            mergeChangeFiles(_config.changeFileDir);
+            auto createdObjects = mergeChangeFiles(_config.changeFileDir);
 
-            auto och{OsmChangeHandler(_config)};
+            auto och{OsmChangeHandler(_config, std::move(createdObjects))};
             och.run();
         } else {
             std::cout
@@ -71,11 +151,13 @@ namespace olu::osm {
                 << "Database is already up to date. DONE."
                 << std::endl;
 
+                publishReplicationState();
+                writeRunReport();
                 return;
             }
 
             fetchChangeFiles(sequenceNumber);
-            mergeChangeFiles(cnst::PATH_TO_CHANGE_FILE_DIR);
+            auto createdObjects = mergeChangeFiles(cnst::PATH_TO_CHANGE_FILE_DIR);
             clearChangesDir();
 
             std::cout
@@ -85,12 +167,14 @@ namespace olu::osm {
             << " change files"
             << std::endl;
 
-            auto och{OsmChangeHandler(_config)};
+            auto och{OsmChangeHandler(_config, std::move(createdObjects))};
             och.run();
 
+            publishReplicationState();
         }
 
         deleteTmpDir();
+        writeRunReport();
 
         std::cout
         << osm2rdf::util::currentTimeFormatted()
@@ -98,6 +182,24 @@ namespace olu::osm {
         << std::endl;
     }
 
+    void OsmUpdater::writeRunReport() const {
+        if (_config.runReportFile.empty()) {
+            return;
+        }
+
+        try {
+            util::RunReport::write(_config.runReportFile);
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            throw OsmUpdaterException("Failed to write run report");
+        }
+    }
+
+    void OsmUpdater::publishReplicationState() const {
+        util::Metrics::set(util::Metrics::SEQUENCE_NUMBER, _latestState.sequenceNumber);
+        util::Metrics::setReplicationTimestamp(_latestState.timeStamp);
+    }
+
     int OsmUpdater::decideStartSequenceNumber() {
         if (_config.sequenceNumber > 0) {
             return _config.sequenceNumber;
@@ -114,26 +216,22 @@ namespace olu::osm {
         return sequenceNumber;
     }
 
-    // We need to create a new ordering because we have to take the deleted status into account for
-    // the objects
-    struct object_order_type_id_reverse_version_delete {
-
-        bool operator()(const osmium::OSMObject& lhs, const osmium::OSMObject& rhs) const noexcept {
-            return const_tie(lhs.type(), lhs.id() > 0, lhs.positive_id(), rhs.version(), rhs.deleted(),
-                        ((lhs.timestamp().valid() && rhs.timestamp().valid()) ? rhs.timestamp() : osmium::Timestamp())) <
-                   const_tie(rhs.type(), rhs.id() > 0, rhs.positive_id(), lhs.version(), lhs.deleted(),
-                        ((lhs.timestamp().valid() && rhs.timestamp().valid()) ? lhs.timestamp() : osmium::Timestamp()));
-        }
-
-        /// @pre lhs and rhs must not be nullptr
-        bool operator()(const osmium::OSMObject* lhs, const osmium::OSMObject* rhs) const noexcept {
-            assert(lhs && rhs);
-            return operator()(*lhs, *rhs);
+    namespace {
+        // Returns the prefix of the uris of objects with the given type
+        std::string getOsmTag(const osmium::item_type type) {
+            switch (type) {
+                case osmium::item_type::node:
+                    return "osmnode";
+                case osmium::item_type::way:
+                    return "osmway";
+                default:
+                    return "osmrel";
+            }
         }
+    }
 
-    };
-
-    void OsmUpdater::mergeChangeFiles(const std::string &pathToChangeFileDir) {
+    CreatedObjects OsmUpdater::mergeChangeFiles(const std::string &pathToChangeFileDir) {
+        util::RunReport::Phase phase("mergeChangeFiles");
         // Get names for each change file and order them after their id
         std::vector<osmium::io::File> inputs;
         for (const auto& file : std::filesystem::directory_iterator(
@@ -150,24 +248,92 @@ namespace olu::osm {
         osmium::io::Writer writer{cnst::PATH_TO_CHANGE_FILE, osmium::io::overwrite::allow};
         auto out = osmium::io::make_output_iterator(writer);
 
-        std::vector<osmium::memory::Buffer> changes;
+        std::vector<osmium::memory::Buffer> buffers;
         osmium::ObjectPointerCollection objects;
         for (const osmium::io::File& change_file : inputs) {
             osmium::io::Reader reader{change_file, osmium::osm_entity_bits::object};
             while (osmium::memory::Buffer buffer = reader.read()) {
                 osmium::apply(buffer, objects);
-                changes.push_back(std::move(buffer));
+                buffers.push_back(std::move(buffer));
             }
             reader.close();
         }
 
         objects.sort(object_order_type_id_reverse_version_delete());
 
-        std::unique_copy(objects.cbegin(), objects.cend(), out, osmium::object_equal_type_id());
+        // Reduce all versions of each object in the window to its net effect, so that objects
+        // that were created and deleted again cost nothing and objects that were created and
+        // modified are not deleted from the database first. Whether such objects are already in
+        // the database is looked up, because the window can overlap with an applied one.
+        const auto storedLookup = [this](const osmium::item_type type,
+                                         const std::set<id_t> &ids) {
+            std::set<id_t> stored;
+            for (const auto &[id, version] : _odf.fetchVersions(ids, getOsmTag(type))) {
+                stored.insert(id);
+            }
+            return stored;
+        };
+        const std::vector<const osmium::OSMObject*> versions(objects.ptr_begin(),
+                                                             objects.ptr_end());
+        auto compacted = ChangeCompactor::compact(versions, storedLookup);
+        util::RunReport::setCounter("compactedNoOps", compacted.noOps);
+        util::RunReport::setCounter("compactedModifiesToCreates", compacted.modifiesToCreates);
+        util::RunReport::setCounter("compactedUnconfirmedCreates", compacted.unconfirmedCreates);
+
+        auto changes = std::move(compacted.objects);
+        if (_region) {
+            // Drop the objects outside the region before anything is fetched or converted for
+            // them. Objects that are stored are kept, as their stored version can be inside.
+            RegionClipper clipper(*_region, [this](const std::set<id_t> &nodeIds) {
+                return _odf.fetchNodes(nodeIds);
+            }, storedLookup);
+            const auto kept = clipper.clip(changes);
+            util::RunReport::setCounter("clippedObjects", changes.size() - kept.size());
+            util::RunReport::setCounter("clipLookedUpNodes", clipper.getNumberOfLookedUpNodes());
+            util::RunReport::setCounter("clipKeptStoredObjects",
+                                        clipper.getNumberOfKeptStoredObjects());
+
+            std::cout
+            << osm2rdf::util::currentTimeFormatted()
+            << "Clipped changes to region, keeping "
+            << kept.size()
+            << " of "
+            << changes.size()
+            << " objects"
+            << std::endl;
+
+            changes = kept;
+        }
+
+        if (_config.skipAppliedObjects) {
+            // Skip the objects that are already up to date, for example because the change files
+            // overlap with the ones of an earlier run
+            AppliedChangeFilter filter([this](const osmium::item_type type,
+                                              const std::set<id_t> &ids) {
+                return _odf.fetchVersions(ids, getOsmTag(type));
+            });
+            changes = filter.filter(changes);
+            util::RunReport::setCounter("skippedAppliedObjects",
+                                        filter.getNumberOfSkippedObjects());
+
+            std::cout
+            << osm2rdf::util::currentTimeFormatted()
+            << "Skipped "
+            << filter.getNumberOfSkippedObjects()
+            << " objects that are already up to date"
+            << std::endl;
+        }
+
+        for (const auto *object : changes) {
+            *out = *object;
+        }
         writer.close();
+
+        return std::move(compacted.created);
     }
 
     void OsmUpdater::fetchChangeFiles(int sequenceNumber) {
+        util::RunReport::Phase phase("fetchChangeFiles");
         std::cout << "Fetch and merge change files..." << std::endl;
 
         osm2rdf::util::ProgressBar downloadProgress(
@@ -0,0 +1,292 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "osm/RegionClipper.h"
+
+#include <unordered_map>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/relation.hpp>
+#include <osmium/osm/way.hpp>
+
+namespace olu::osm {
+
+    // _____________________________________________________________________________________________
+    std::vector<const osmium::OSMObject*>
+    RegionClipper::clip(const std::vector<const osmium::OSMObject*> &objects) {
+        // Whether a node lies inside the region, for the nodes of the change file and the nodes
+        // that were looked up
+        std::unordered_map<id_t, bool> nodeInside;
+        std::unordered_set<id_t> keptNodes;
+        std::unordered_set<id_t> keptWays;
+        std::unordered_set<id_t> keptRelations;
+        std::unordered_map<id_t, const osmium::Way*> ways;
+        std::unordered_map<id_t, const osmium::Relation*> relations;
+
+        for (const auto *object : objects) {
+            switch (object->type()) {
+                case osmium::item_type::node: {
+                    if (object->deleted()) {
+                        keptNodes.insert(object->id());
+                        break;
+                    }
+
+                    const auto &node = static_cast<const osmium::Node&>(*object);
+                    const bool inside = _region.contains(node.location());
+                    nodeInside.emplace(node.id(), inside);
+                    if (inside) {
+                        keptNodes.insert(node.id());
+                    }
+                    break;
+                }
+                case osmium::item_type::way:
+                    ways.emplace(object->id(), static_cast<const osmium::Way*>(object));
+                    break;
+                case osmium::item_type::relation:
+                    relations.emplace(object->id(), static_cast<const osmium::Relation*>(object));
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Look up the nodes that are referenced by ways and relations but are not part of the
+        // change file. Ways that already reference a node inside the region are kept without a
+        // lookup.
+        std::set<id_t> unknownNodes;
+        std::vector<const osmium::Way*> undecidedWays;
+        for (const auto &[id, way] : ways) {
+            if (way->deleted()) {
+                keptWays.insert(id);
+                continue;
+            }
+
+            bool inside = false;
+            for (const auto &nodeRef : way->nodes()) {
+                const auto it = nodeInside.find(nodeRef.ref());
+                if (it != nodeInside.end() && it->second) {
+                    inside = true;
+                    break;
+                }
+            }
+
+            if (inside) {
+                keptWays.insert(id);
+                continue;
+            }
+
+            undecidedWays.push_back(way);
+            for (const auto &nodeRef : way->nodes()) {
+                if (!nodeInside.contains(nodeRef.ref())) {
+                    unknownNodes.insert(nodeRef.ref());
+                }
+            }
+        }
+
+        for (const auto &[id, relation] : relations) {
+            if (relation->deleted()) {
+                continue;
+            }
+
+            for (const auto &member : relation->members()) {
+                if (member.type() == osmium::item_type::node &&
+                    !nodeInside.contains(member.ref())) {
+                    unknownNodes.insert(member.ref());
+                }
+            }
+        }
+
+        std::set<id_t> batch;
+        for (auto it = unknownNodes.begin(); it != unknownNodes.end();) {
+            batch.insert(*it);
+            // Nodes that are not in the database are outside the region
+            nodeInside.emplace(*it, false);
+            if (++it == unknownNodes.end() || batch.size() == MAX_NODES_PER_LOOKUP) {
+                for (const auto &node : _lookup(batch)) {
+                    nodeInside[node.getId()] = _region.contains(node.getLocation());
+                }
+                _lookedUpNodes += batch.size();
+                batch.clear();
+            }
+        }
+
+        for (const auto *way : undecidedWays) {
+            for (const auto &nodeRef : way->nodes()) {
+                if (nodeInside[nodeRef.ref()]) {
+                    keptWays.insert(way->id());
+                    break;
+                }
+            }
+        }
+
+        // A node or way that is outside the region now can still be stored with an older
+        // version inside the region, for example if it was moved out of the region. Such objects
+        // are kept, so that their stored version is replaced. The first version of an object can
+        // not be stored yet.
+        std::set<id_t> droppedNodes;
+        std::set<id_t> droppedWays;
+        for (const auto *object : objects) {
+            if (object->deleted() || object->version() <= 1) {
+                continue;
+            }
+
+            if (object->type() == osmium::item_type::node && !keptNodes.contains(object->id())) {
+                droppedNodes.insert(object->id());
+            } else if (object->type() == osmium::item_type::way &&
+                       !keptWays.contains(object->id())) {
+                droppedWays.insert(object->id());
+            }
+        }
+        keepStoredObjects(osmium::item_type::node, droppedNodes, keptNodes);
+        keepStoredObjects(osmium::item_type::way, droppedWays, keptWays);
+
+        // A relation is kept if one of its members is kept. As relations can be members of each
+        // other, this is repeated until no further relation is kept.
+        const auto hasKeptMember = [&](const osmium::Relation &relation) {
+            for (const auto &member : relation.members()) {
+                switch (member.type()) {
+                    case osmium::item_type::node:
+                        if (nodeInside[member.ref()]) {
+                            return true;
+                        }
+                        break;
+                    case osmium::item_type::way:
+                        if (!ways.contains(member.ref()) || keptWays.contains(member.ref())) {
+                            return true;
+                        }
+                        break;
+                    case osmium::item_type::relation:
+                        if (!relations.contains(member.ref()) ||
+                            keptRelations.contains(member.ref())) {
+                            return true;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return false;
+        };
+
+        const auto keepRelationsWithKeptMembers = [&]() {
+            bool changed = true;
+            while (changed) {
+                changed = false;
+                for (const auto &[id, relation] : relations) {
+                    if (!keptRelations.contains(id) &&
+                        (relation->deleted() || hasKeptMember(*relation))) {
+                        keptRelations.insert(id);
+                        changed = true;
+                    }
+                }
+            }
+        };
+        keepRelationsWithKeptMembers();
+
+        // Relations that are stored are kept like nodes and ways, which can cause the relations
+        // they are members of to be kept as well
+        std::set<id_t> droppedRelations;
+        for (const auto &[id, relation] : relations) {
+            if (!keptRelations.contains(id) && relation->version() > 1) {
+                droppedRelations.insert(id);
+            }
+        }
+        if (!droppedRelations.empty()) {
+            keepStoredObjects(osmium::item_type::relation, droppedRelations, keptRelations);
+            keepRelationsWithKeptMembers();
+        }
+
+        // Keep the members of the kept relations and ways that are part of the change file
+        std::vector<id_t> pendingRelations(keptRelations.begin(), keptRelations.end());
+        while (!pendingRelations.empty()) {
+            const auto *relation = relations.at(pendingRelations.back());
+            pendingRelations.pop_back();
+            for (const auto &member : relation->members()) {
+                switch (member.type()) {
+                    case osmium::item_type::node:
+                        keptNodes.insert(member.ref());
+                        break;
+                    case osmium::item_type::way:
+                        keptWays.insert(member.ref());
+                        break;
+                    case osmium::item_type::relation:
+                        if (relations.contains(member.ref()) &&
+                            keptRelations.insert(member.ref()).second) {
+                            pendingRelations.push_back(member.ref());
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        for (const auto &id : keptWays) {
+            if (const auto it = ways.find(id); it != ways.end()) {
+                for (const auto &nodeRef : it->second->nodes()) {
+                    keptNodes.insert(nodeRef.ref());
+                }
+            }
+        }
+
+        std::vector<const osmium::OSMObject*> kept;
+        kept.reserve(objects.size());
+        for (const auto *object : objects) {
+            switch (object->type()) {
+                case osmium::item_type::node:
+                    if (keptNodes.contains(object->id())) {
+                        kept.push_back(object);
+                    }
+                    break;
+                case osmium::item_type::way:
+                    if (keptWays.contains(object->id())) {
+                        kept.push_back(object);
+                    }
+                    break;
+                case osmium::item_type::relation:
+                    if (keptRelations.contains(object->id())) {
+                        kept.push_back(object);
+                    }
+                    break;
+                default:
+                    kept.push_back(object);
+                    break;
+            }
+        }
+
+        return kept;
+    }
+
+    // _____________________________________________________________________________________________
+    void RegionClipper::keepStoredObjects(const osmium::item_type type, const std::set<id_t> &ids,
+                                          std::unordered_set<id_t> &kept) {
+        std::set<id_t> batch;
+        for (auto it = ids.begin(); it != ids.end();) {
+            batch.insert(*it);
+            if (++it == ids.end() || batch.size() == MAX_OBJECTS_PER_LOOKUP) {
+                for (const auto &id : _storedLookup(type, batch)) {
+                    if (kept.insert(id).second) {
+                        ++_keptStoredObjects;
+                    }
+                }
+                batch.clear();
+            }
+        }
+    }
+
+} // namespace olu::osm
@@ -5,9 +5,18 @@
 #include "osm/Relation.h"
 #include "util/XmlReader.h"
 
-#include <sstream>
+#include <charconv>
 
 namespace olu::osm {
+    std::string_view getOsmTag(const OsmObjectType type) {
+        switch (type) {
+            case OsmObjectType::NODE: return "node";
+            case OsmObjectType::WAY: return "way";
+            case OsmObjectType::RELATION: return "relation";
+        }
+        return {};
+    }
+
     void Relation::setType(std::string const &type) {
         this->type = type;
     }
@@ -20,50 +29,58 @@ namespace olu::osm {
         this->members.push_back(member);
     }
 
+    void Relation::setMembers(std::vector<RelationMember> members) {
+        this->members = std::move(members);
+    }
+
     void Relation::addTag(const std::string& key, const std::string& value) {
         tags.emplace_back(key, util::XmlReader::xmlEncode(value));
     }
 
     std::string Relation::getXml() const {
-        std::ostringstream oss;
+        std::string xml;
+        writeXml(xml);
+        return xml;
+    }
 
-        oss << "<relation id=\"";
-        oss << std::to_string(this->id);
-        oss << "\"";
+    void Relation::writeXml(std::string &output) const {
+        char buffer[24];
+
+        output.append("<relation id=\"");
+        output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), this->id).ptr);
+        output.append("\"");
 
         if (!this->timestamp.empty()) {
-            oss << " timestamp=\"";
-            oss << this->timestamp;
-            oss << "Z\"";
+            output.append(" timestamp=\"");
+            output.append(this->timestamp);
+            output.append("Z\"");
         }
 
-        oss << ">";
+        output.append(">");
 
-        for (const auto &[id, osmTag, role] : this->members) {
-            oss << "<member type=\"";
-            oss << osmTag;
-            oss << "\" ref=\"";
-            oss << std::to_string(id);
-            oss << "\" role=\"";
-            oss << role;
-            oss << "\"/>";
+        for (const auto &[id, type, role] : this->members) {
+            output.append("<member type=\"");
+            output.append(getOsmTag(type));
+            output.append("\" ref=\"");
+            output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), id).ptr);
+            output.append("\" role=\"");
+            output.append(role);
+            output.append("\"/>");
         }
 
-        oss << R"(<tag k="type" v=")";
-        oss << this->type;
-        oss << "\"/>";
+        output.append(R"(<tag k="type" v=")");
+        output.append(this->type);
+        output.append("\"/>");
 
         for (const auto& [key, value] : this->tags) {
-            oss << "<tag k=\"";
-            oss << key;
-            oss << "\" v=\"";
-            oss << value;
-            oss << "\"/>";
+            output.append("<tag k=\"");
+            output.append(key);
+            output.append("\" v=\"");
+            output.append(value);
+            output.append("\"/>");
         }
 
-        oss << "</relation>";
-
-        return oss.str();
+        output.append("</relation>");
     }
 
 }
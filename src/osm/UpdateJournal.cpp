@@ -0,0 +1,350 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "osm/UpdateJournal.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+// First line of the plan file, which is changed if the format of the plan changes
+static inline const std::string PLAN_HEADER = "olu-update-journal 1";
+static inline const std::string TARGETS_KEY = "targets";
+static inline const std::string DELETE_KEY = "delete";
+static inline const std::string INSERT_KEY = "insert";
+static inline const std::string END_KEY = "end";
+
+// Flushes the file or directory at the given path to disk
+static void syncPath(const std::filesystem::path &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0 || ::fsync(fd) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        const std::string msg = "Could not sync update journal: " + path.string();
+        throw olu::osm::UpdateJournalException(msg.c_str());
+    }
+    ::close(fd);
+}
+
+// Reads the next line of the plan and throws if there is none
+static std::string readLine(std::istream &file) {
+    std::string line;
+    if (!std::getline(file, line)) {
+        throw olu::osm::UpdateJournalException("Unexpected end of update journal plan");
+    }
+
+    return line;
+}
+
+// Reads the number that follows the given key in the line, for example the number of batches
+static std::size_t readNumber(std::istringstream &line, const std::string &key) {
+    std::size_t number;
+    if (!(line >> number)) {
+        const std::string msg = "Invalid '" + key + "' entry in update journal plan";
+        throw olu::osm::UpdateJournalException(msg.c_str());
+    }
+
+    return number;
+}
+
+namespace olu::osm {
+    // _____________________________________________________________________________________________
+    std::size_t UpdatePlan::getNumberOfDeletedObjects() const {
+        std::size_t count = 0;
+        for (const auto &batch : deleteBatches) {
+            count += batch.ids.size();
+        }
+
+        return count;
+    }
+
+    // _____________________________________________________________________________________________
+    UpdateJournal::UpdateJournal(std::filesystem::path directory)
+        : _directory(std::move(directory)) { }
+
+    // _____________________________________________________________________________________________
+    UpdateJournal::~UpdateJournal() {
+        closeAckFile();
+    }
+
+    // _____________________________________________________________________________________________
+    bool UpdateJournal::hasPendingPlan(const std::filesystem::path &directory) {
+        return std::filesystem::exists(directory / PLAN_FILE);
+    }
+
+    // _____________________________________________________________________________________________
+    void UpdateJournal::begin(const UpdatePlan &plan, const std::vector<std::string> &targets) {
+        std::lock_guard lock(_mutex);
+        closeAckFile();
+
+        const auto planPath = _directory / PLAN_FILE;
+        auto tmpPath = planPath;
+        tmpPath += ".tmp";
+        try {
+            std::filesystem::create_directories(_directory);
+            // The old log must not be applied to the new plan
+            std::filesystem::remove(planPath);
+            std::filesystem::remove(_directory / ACK_FILE);
+        } catch (const std::filesystem::filesystem_error &e) {
+            std::cerr << e.what() << std::endl;
+            throw UpdateJournalException("Could not prepare update journal directory");
+        }
+
+        {
+            std::ofstream file(tmpPath, std::ios::trunc | std::ios::binary);
+            if (!file) {
+                const std::string msg = "Can not write update journal plan: " + tmpPath.string();
+                throw UpdateJournalException(msg.c_str());
+            }
+
+            file << PLAN_HEADER << "\n";
+            file << TARGETS_KEY << " " << targets.size() << "\n";
+            for (const auto &target : targets) {
+                file << target << "\n";
+            }
+
+            for (const auto &[osmTag, ids] : plan.deleteBatches) {
+                file << DELETE_KEY << " " << osmTag << " " << ids.size() << "\n";
+                for (const auto &id : ids) {
+                    file << id << " ";
+                }
+                file << "\n";
+            }
+
+            // Triples can contain literals with any character, so they are stored with their
+            // length in front
+            for (const auto &[triples, processedTriples] : plan.insertBatches) {
+                file << INSERT_KEY << " " << processedTriples << " " << triples.size() << "\n";
+                for (const auto &triple : triples) {
+                    file << triple.size() << "\n" << triple << "\n";
+                }
+            }
+
+            file << END_KEY << "\n";
+            file.flush();
+            if (!file) {
+                const std::string msg = "Could not write update journal plan: "
+                                        + tmpPath.string();
+                throw UpdateJournalException(msg.c_str());
+            }
+        }
+
+        // The plan only becomes visible once it is completely on disk
+        syncPath(tmpPath);
+        try {
+            std::filesystem::rename(tmpPath, planPath);
+        } catch (const std::filesystem::filesystem_error &e) {
+            std::cerr << e.what() << std::endl;
+            throw UpdateJournalException("Could not replace update journal plan");
+        }
+        syncPath(_directory);
+
+        _firstPendingBatches.assign(targets.size(), 0);
+        openAckFile();
+    }
+
+    // _____________________________________________________________________________________________
+    UpdatePlan UpdateJournal::resume(const std::vector<std::string> &targets) {
+        std::lock_guard lock(_mutex);
+        closeAckFile();
+
+        const auto planPath = _directory / PLAN_FILE;
+        std::ifstream file(planPath, std::ios::binary);
+        if (!file) {
+            const std::string msg = "Can not open update journal plan: " + planPath.string();
+            throw UpdateJournalException(msg.c_str());
+        }
+
+        if (readLine(file) != PLAN_HEADER) {
+            const std::string msg = "Unknown format of update journal plan: " + planPath.string();
+            throw UpdateJournalException(msg.c_str());
+        }
+
+        std::istringstream targetsLine(readLine(file));
+        std::string key;
+        targetsLine >> key;
+        if (key != TARGETS_KEY) {
+            throw UpdateJournalException("Update journal plan does not list its targets");
+        }
+
+        // The progress in the log is stored per target, so it is only valid for the same targets
+        std::vector<std::string> journaledTargets(readNumber(targetsLine, TARGETS_KEY));
+        for (auto &target : journaledTargets) {
+            target = readLine(file);
+        }
+        if (journaledTargets != targets) {
+            throw UpdateJournalException(
+                "The update journal was written for other update targets than the configured "
+                "ones");
+        }
+
+        UpdatePlan plan;
+        while (true) {
+            std::istringstream line(readLine(file));
+            line >> key;
+            if (key == END_KEY) {
+                break;
+            }
+
+            if (key == DELETE_KEY) {
+                UpdatePlan::DeleteBatch batch;
+                line >> batch.osmTag;
+                const auto count = readNumber(line, DELETE_KEY);
+                std::istringstream idsLine(readLine(file));
+                id_t id;
+                while (idsLine >> id) {
+                    batch.ids.insert(id);
+                }
+                if (batch.ids.size() != count) {
+                    throw UpdateJournalException("Invalid 'delete' entry in update journal plan");
+                }
+                plan.deleteBatches.emplace_back(std::move(batch));
+            } else if (key == INSERT_KEY) {
+                UpdatePlan::InsertBatch batch;
+                batch.processedTriples = readNumber(line, INSERT_KEY);
+                batch.triples.resize(readNumber(line, INSERT_KEY));
+                for (auto &triple : batch.triples) {
+                    std::istringstream lengthLine(readLine(file));
+                    triple.resize(readNumber(lengthLine, INSERT_KEY));
+                    file.read(triple.data(), static_cast<std::streamsize>(triple.size()));
+                    // Skip the newline that terminates the triple
+                    file.ignore(1);
+                    if (!file) {
+                        throw UpdateJournalException("Unexpected end of update journal plan");
+                    }
+                }
+                plan.insertBatches.emplace_back(std::move(batch));
+            } else {
+                const std::string msg = "Invalid entry in update journal plan: " + key;
+                throw UpdateJournalException(msg.c_str());
+            }
+        }
+
+        _firstPendingBatches.assign(targets.size(), 0);
+        const auto length = readAckFile(plan.getNumberOfBatches());
+
+        // The torn line of an acknowledgement that was not completely written is removed, so
+        // that the next acknowledgement is not appended to it
+        openAckFile();
+        if (::ftruncate(_ackFile, static_cast<off_t>(length)) != 0 || ::fsync(_ackFile) != 0) {
+            throw UpdateJournalException("Could not truncate update journal log");
+        }
+
+        return plan;
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t UpdateJournal::getFirstPendingBatch(const std::size_t target) const {
+        std::lock_guard lock(_mutex);
+        return target < _firstPendingBatches.size() ? _firstPendingBatches[target] : 0;
+    }
+
+    // _____________________________________________________________________________________________
+    void UpdateJournal::acknowledge(const std::size_t target, const std::size_t batch) {
+        std::lock_guard lock(_mutex);
+        if (_ackFile < 0) {
+            throw UpdateJournalException("Update journal was not started");
+        }
+
+        const std::string line = std::to_string(target) + " " + std::to_string(batch) + "\n";
+        if (::write(_ackFile, line.data(), line.size()) != static_cast<ssize_t>(line.size())
+            || ::fsync(_ackFile) != 0) {
+            throw UpdateJournalException("Could not write to update journal log");
+        }
+
+        if (target < _firstPendingBatches.size()) {
+            _firstPendingBatches[target] = std::max(_firstPendingBatches[target], batch + 1);
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    void UpdateJournal::complete() {
+        std::lock_guard lock(_mutex);
+        closeAckFile();
+
+        try {
+            // Removing the plan first marks the update as completed
+            std::filesystem::remove(_directory / PLAN_FILE);
+            std::filesystem::remove(_directory / ACK_FILE);
+            std::filesystem::remove(_directory / GEOMETRY_QUEUE_FILE);
+        } catch (const std::filesystem::filesystem_error &e) {
+            std::cerr << e.what() << std::endl;
+            throw UpdateJournalException("Could not remove update journal");
+        }
+        syncPath(_directory);
+        _firstPendingBatches.clear();
+    }
+
+    // _____________________________________________________________________________________________
+    void UpdateJournal::openAckFile() {
+        const auto path = _directory / ACK_FILE;
+        _ackFile = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (_ackFile < 0) {
+            const std::string msg = "Can not open update journal log: " + path.string();
+            throw UpdateJournalException(msg.c_str());
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    void UpdateJournal::closeAckFile() {
+        if (_ackFile >= 0) {
+            ::close(_ackFile);
+            _ackFile = -1;
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t UpdateJournal::readAckFile(const std::size_t numberOfBatches) {
+        std::ifstream file(_directory / ACK_FILE, std::ios::binary);
+        if (!file) {
+            return 0;
+        }
+
+        std::ostringstream content;
+        content << file.rdbuf();
+        const std::string log = content.str();
+
+        // A line without a newline at the end was not completely written before the crash, so
+        // its batch is treated as not acknowledged
+        std::size_t begin = 0;
+        for (auto end = log.find('\n'); end != std::string::npos;
+             begin = end + 1, end = log.find('\n', begin)) {
+            const auto entry = log.substr(begin, end - begin);
+            std::istringstream line(entry);
+            std::size_t target;
+            std::size_t batch;
+            if (entry.find('-') != std::string::npos || !(line >> target >> batch)
+                || !(line >> std::ws).eof() || target >= _firstPendingBatches.size()
+                || batch >= numberOfBatches) {
+                const std::string msg = "Invalid entry in update journal log: " + entry;
+                throw UpdateJournalException(msg.c_str());
+            }
+
+            _firstPendingBatches[target] = std::max(_firstPendingBatches[target], batch + 1);
+        }
+
+        return begin;
+    }
+
+} // namespace olu::osm
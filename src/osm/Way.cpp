@@ -19,7 +19,7 @@
 #include "osm/Way.h"
 #include "util/XmlReader.h"
 
-#include <sstream>
+#include <charconv>
 
 namespace olu::osm {
     void Way::setTimestamp(std::string const &timestamp) {
@@ -30,41 +30,50 @@ namespace olu::osm {
         members.emplace_back(nodeId);
     }
 
+    void Way::setMembers(std::vector<id_t> nodeIds) {
+        members = std::move(nodeIds);
+    }
+
     void Way::addTag(const std::string& key, const std::string& value) {
         tags.emplace_back(key, util::XmlReader::xmlEncode(value));
     }
 
     std::string Way::getXml() const {
-        std::ostringstream oss;
+        std::string xml;
+        writeXml(xml);
+        return xml;
+    }
+
+    void Way::writeXml(std::string &output) const {
+        char buffer[24];
 
-        oss << "<way id=\"";
-        oss << std::to_string(this->getId());
-        oss << "\"";
+        output.append("<way id=\"");
+        output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), this->id).ptr);
+        output.append("\"");
 
         if (!this->timestamp.empty()) {
-            oss << " timestamp=\"";
-            oss << this->timestamp;
-            oss << "Z\"";
+            output.append(" timestamp=\"");
+            output.append(this->timestamp);
+            output.append("Z\"");
         }
 
-        oss << ">";
+        output.append(">");
 
         for (const auto nodeId: this->members) {
-            oss << "<nd ref=\"";
-            oss << std::to_string(nodeId);
-            oss << "\"/>";
+            output.append("<nd ref=\"");
+            output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), nodeId).ptr);
+            output.append("\"/>");
         }
 
         for (const auto& [key, value] : this->tags) {
-            oss << "<tag k=\"";
-            oss << key;
-            oss << "\" v=\"";
-            oss << value;
-            oss << "\"/>";
+            output.append("<tag k=\"");
+            output.append(key);
+            output.append("\" v=\"");
+            output.append(value);
+            output.append("\"/>");
         }
 
-        oss << "</way>";
-        return oss.str();
+        output.append("</way>");
     }
 
-}
\ No newline at end of file
+}
@@ -18,246 +18,216 @@
 
 #include "sparql/QueryWriter.h"
 
+#include <charconv>
 #include <string>
 #include <vector>
-#include <sstream>
+
+namespace {
+    // Upper bound for the number of characters of an id and the following space
+    constexpr std::size_t MAX_ID_LENGTH = 21;
+}
+
+// _________________________________________________________________________________________________
+olu::sparql::QueryWriter::QueryWriter(config::Config config): _config(std::move(config)) {
+    const auto from = getFromClauseOptional();
+
+    _insertTemplate = {"INSERT DATA { ", "}"};
+    if (!_config.graphUri.empty()) {
+        _insertTemplate = {"INSERT DATA { GRAPH <" + _config.graphUri + "> { ", " } }"};
+    }
+
+    _deleteTemplate = {
+        "DELETE { " + wrapWithGraphOptional("?s ?p1 ?o1 . ?o1 ?p2 ?o2 . ")
+        + "} WHERE { VALUES ?s { ",
+        "} " + wrapWithGraphOptional("?s ?p1 ?o1 . OPTIONAL { ?o1 ?p2 ?o2. }") + " }"};
+
+    _nodeLocationsTemplate = {
+        "SELECT ?nodeGeo ?location " + from + "WHERE { VALUES ?nodeGeo { ",
+        "} ?nodeGeo geo:asWKT ?location . }"};
+
+    _relationsTemplate = {
+        "SELECT ?rel ?type"
+        "(GROUP_CONCAT(?memberUri; separator=\";\") AS ?memberUris) "
+        "(GROUP_CONCAT(?memberRole; separator=\";\") AS ?memberRoles) "
+        "(GROUP_CONCAT(?memberPos; separator=\";\") AS ?memberPositions) "
+        + from + "WHERE { VALUES ?rel { ",
+        "} ?rel osmkey:type ?type . "
+        "?rel osmrel:member ?o . "
+        "?o osm2rdfmember:id ?memberUri . "
+        "?o osm2rdfmember:role ?memberRole . "
+        "?o osm2rdfmember:pos ?memberPos . "
+        "} GROUP BY ?rel ?type"};
+
+    _waysMembersTemplate = {
+        "SELECT ?way "
+        "(GROUP_CONCAT(?nodeUri; separator=\";\") AS ?nodeUris) "
+        "(GROUP_CONCAT(?nodePos; separator=\";\") AS ?nodePositions) "
+        + from + "WHERE { VALUES ?way { ",
+        "} ?way osmway:node ?member . "
+        "?member osmway:node ?nodeUri . "
+        "?member osm2rdfmember:pos ?nodePos "
+        "} GROUP BY ?way"};
+
+    _referencedNodesTemplate = {
+        "SELECT ?node " + from + "WHERE { VALUES ?way { ",
+        "} ?way osmway:node ?member . ?member osmway:node ?node . } GROUP BY ?node"};
+
+    _relationMembersTemplate = {
+        "SELECT ?p " + from + "WHERE { VALUES ?rel { ",
+        "} ?rel osmrel:member ?o . ?o osm2rdfmember:id ?p . } GROUP BY ?p"};
+
+    _waysReferencingNodesTemplate = {
+        "SELECT ?way " + from + "WHERE { VALUES ?node { ",
+        "} ?identifier osmway:node ?node . ?way osmway:node ?identifier . } GROUP BY ?way"};
+
+    _relationsReferencingNodesTemplate = {
+        "SELECT ?s " + from + "WHERE { VALUES ?node { ",
+        "} ?s osmrel:member ?o . ?o osm2rdfmember:id ?node . } GROUP BY ?s"};
+
+    _relationsReferencingWaysTemplate = {
+        "SELECT ?s " + from + "WHERE { VALUES ?way { ",
+        "} ?s osmrel:member ?o . ?o osm2rdfmember:id ?way . } GROUP BY ?s"};
+
+    _relationsReferencingRelationsTemplate = {
+        "SELECT ?s " + from + "WHERE { VALUES ?rel { ",
+        "} ?s osmrel:member ?o . "
+        "?o osm2rdfmember:id ?rel . } "
+        "GROUP BY ?s"};
+
+    _versionsTemplate = {
+        "SELECT ?s ?version " + from + "WHERE { VALUES ?s { ",
+        "} ?s osmmeta:version ?version . }"};
+
+    _tagsAndTimestampTemplate = {
+        "SELECT ?key ?value ?time " + from + "WHERE { { ",
+        " ?key ?value . "
+        "FILTER regex(str(?key), \"https://www.openstreetmap.org/wiki/Key:\") } "
+        "UNION { ",
+        " osmmeta:timestamp ?time } }"};
+}
 
 // _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeInsertQuery(const std::vector<std::string>& triples) const {
-    std::ostringstream tripleClause;
+    std::size_t size = _insertTemplate.head.size() + _insertTemplate.tail.size();
     for (const auto & element : triples) {
-        tripleClause << element;
-        tripleClause << " . ";
+        size += element.size() + 3;
     }
 
-    std::ostringstream ss;
-    ss << "INSERT DATA ";
-    ss << "{ ";
-    ss << wrapWithGraphOptional(tripleClause.str());
-    ss << "}";
-    return ss.str();
+    std::string query;
+    query.reserve(size);
+    query.append(_insertTemplate.head);
+    for (const auto & element : triples) {
+        query.append(element);
+        query.append(" . ");
+    }
+    query.append(_insertTemplate.tail);
+    return query;
 }
 
 // _________________________________________________________________________________________________
 std::string
 olu::sparql::QueryWriter::writeDeleteQuery(const std::set<id_t> &ids, const std::string &osmTag) const {
-    std::ostringstream ss;
-    ss << "DELETE { ";
-    ss << wrapWithGraphOptional("?s ?p1 ?o1 . ?o1 ?p2 ?o2 . ");
-    ss << "} WHERE { VALUES ?s { ";
-
-    for (const auto & id : ids) {
-        ss << osmTag;
-        ss << ":";
-        ss << std::to_string(id);
-        ss << " ";
-    }
-
-    ss << "} ";
-    ss << wrapWithGraphOptional("?s ?p1 ?o1 . OPTIONAL { ?o1 ?p2 ?o2. }");
-    ss << " }";
-    return ss.str();
+    return fillTemplate(_deleteTemplate, osmTag + ":", ids);
 }
 
 // _________________________________________________________________________________________________
 std::string
 olu::sparql::QueryWriter::writeQueryForNodeLocations(const std::set<id_t> &nodeIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?nodeGeo ?location ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?nodeGeo { ";
-
-    for (const auto & nodeId : nodeIds) {
-        ss << "osm2rdfgeom:osm_node_";
-        ss << std::to_string(nodeId);
-        ss << " ";
-    }
-
-    ss << "} ?nodeGeo geo:asWKT ?location . }";
-    return ss.str();
+    return fillTemplate(_nodeLocationsTemplate, "osm2rdfgeom:osm_node_", nodeIds);
 }
 
 // _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeQueryForLatestNodeTimestamp() const {
-    std::ostringstream ss;
-    ss << "SELECT ?p ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { ?s rdf:type osm:node . ?s osmmeta:timestamp ?p . } ORDER BY DESC(?p) LIMIT 1";
-    return ss.str();
+    return "SELECT ?p " + getFromClauseOptional() +
+           "WHERE { ?s rdf:type osm:node . ?s osmmeta:timestamp ?p . } ORDER BY DESC(?p) LIMIT 1";
 }
 
 // _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeQueryForRelations(const std::set<id_t> & relationIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?rel ?type"
-          "(GROUP_CONCAT(?memberUri; separator=\";\") AS ?memberUris) "
-          "(GROUP_CONCAT(?memberRole; separator=\";\") AS ?memberRoles) "
-          "(GROUP_CONCAT(?memberPos; separator=\";\") AS ?memberPositions) ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?rel { ";
-
-    for (const auto & relId : relationIds) {
-        ss << "osmrel:";
-        ss << std::to_string(relId);
-        ss << " ";
-    }
-
-    ss << "} ?rel osmkey:type ?type . "
-          "?rel osmrel:member ?o . "
-          "?o osm2rdfmember:id ?memberUri . "
-          "?o osm2rdfmember:role ?memberRole . "
-          "?o osm2rdfmember:pos ?memberPos . "
-          "} GROUP BY ?rel ?type";
-    return ss.str();
+    return fillTemplate(_relationsTemplate, "osmrel:", relationIds);
 }
 
 // _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeQueryForWaysMembers(const std::set<id_t> &wayIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?way "
-          "(GROUP_CONCAT(?nodeUri; separator=\";\") AS ?nodeUris) "
-          "(GROUP_CONCAT(?nodePos; separator=\";\") AS ?nodePositions) ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?way { ";
-
-    for (const auto & wayId : wayIds) {
-        ss << "osmway:";
-        ss << std::to_string(wayId);
-        ss << " ";
-    }
-
-    ss << "} ?way osmway:node ?member . "
-          "?member osmway:node ?nodeUri . "
-          "?member osm2rdfmember:pos ?nodePos "
-          "} GROUP BY ?way";
-    return ss.str();
+    return fillTemplate(_waysMembersTemplate, "osmway:", wayIds);
 }
 
 // _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeQueryForReferencedNodes(const std::set<id_t> &wayIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?node ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?way { ";
-
-    for (const auto & wayId : wayIds) {
-        ss << "osmway:" + std::to_string(wayId)+ " ";
-    }
-
-    ss << "} ?way osmway:node ?member . ?member osmway:node ?node . } GROUP BY ?node";
-    return ss.str();
+    return fillTemplate(_referencedNodesTemplate, "osmway:", wayIds);
 }
 
 // _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeQueryForRelationMembers(const std::set<id_t> &relIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?p ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?rel { ";
-
-    for (const auto & relId : relIds) {
-        ss << "osmrel:";
-        ss << std::to_string(relId);
-        ss << " ";
-    }
-
-    ss << "} ?rel osmrel:member ?o . ?o osm2rdfmember:id ?p . } GROUP BY ?p";
-    return ss.str();
+    return fillTemplate(_relationMembersTemplate, "osmrel:", relIds);
 }
 
 // _________________________________________________________________________________________________
 std::string
 olu::sparql::QueryWriter::writeQueryForWaysReferencingNodes(const std::set<id_t> &nodeIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?way ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?node { ";
-
-    for (const auto & nodeId : nodeIds) {
-        ss << "osmnode:";
-        ss << std::to_string(nodeId);
-        ss << " ";
-    }
-
-    ss << "} ?identifier osmway:node ?node . ?way osmway:node ?identifier . } GROUP BY ?way";
-    return ss.str();
+    return fillTemplate(_waysReferencingNodesTemplate, "osmnode:", nodeIds);
 }
 
 // _________________________________________________________________________________________________
 std::string
 olu::sparql::QueryWriter::writeQueryForRelationsReferencingNodes(const std::set<id_t> &nodeIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?s ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?node { ";
-
-    for (const auto & nodeId : nodeIds) {
-        ss << "osmnode:";
-        ss << std::to_string(nodeId);
-        ss << " ";
-    }
-
-    ss << "} ?s osmrel:member ?o . ?o osm2rdfmember:id ?node . } GROUP BY ?s";
-    return ss.str();
+    return fillTemplate(_relationsReferencingNodesTemplate, "osmnode:", nodeIds);
 }
 
 // _________________________________________________________________________________________________
 std::string
 olu::sparql::QueryWriter::writeQueryForRelationsReferencingWays(const std::set<id_t> &wayIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?s ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?way { ";
-
-    for (const auto & wayId : wayIds) {
-        ss << "osmway:";
-        ss << std::to_string(wayId);
-        ss << " ";
-    }
-
-    ss << "} ?s osmrel:member ?o . ?o osm2rdfmember:id ?way . } GROUP BY ?s";
-    return ss.str();
+    return fillTemplate(_relationsReferencingWaysTemplate, "osmway:", wayIds);
 }
 
 // _________________________________________________________________________________________________
 std::string
 olu::sparql::QueryWriter::writeQueryForRelationsReferencingRelations(const std::set<id_t> &relationIds) const {
-    std::ostringstream ss;
-    ss << "SELECT ?s ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { VALUES ?rel { ";
-
-    for (const auto & relId : relationIds) {
-        ss << "osmrel:";
-        ss << std::to_string(relId);
-        ss << " ";
-    }
+    return fillTemplate(_relationsReferencingRelationsTemplate, "osmrel:", relationIds);
+}
 
-    ss << "} ?s osmrel:member ?o . "
-          "?o osm2rdfmember:id ?rel . } "
-          "GROUP BY ?s";
-    return ss.str();
+// _________________________________________________________________________________________________
+std::string olu::sparql::QueryWriter::writeQueryForVersions(const std::set<id_t> &ids,
+                                                            const std::string &osmTag) const {
+    return fillTemplate(_versionsTemplate, osmTag + ":", ids);
 }
 
+// _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeQueryForTagsAndTimestamp(const std::string &subject) const {
-    std::ostringstream ss;
-    ss << "SELECT ?key ?value ?time ";
-    ss << getFromClauseOptional();
-    ss << "WHERE { { ";
-    ss << subject;
-    ss << " ?key ?value . "
-          "FILTER regex(str(?key), \"https://www.openstreetmap.org/wiki/Key:\") } "
-          "UNION { ";
-    ss << subject;
-    ss << " osmmeta:timestamp ?time } }";
-
-    return ss.str();
+    const auto &[head, middle, tail] = _tagsAndTimestampTemplate;
+    std::string query;
+    query.reserve(head.size() + middle.size() + tail.size() + 2 * subject.size());
+    query.append(head).append(subject).append(middle).append(subject).append(tail);
+    return query;
 }
 
+// _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::getFromClauseOptional() const {
     return  _config.graphUri.empty() ? "" : "FROM <" +_config.graphUri + "> ";
 }
 
+// _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::wrapWithGraphOptional(const std::string& clause) const {
     return _config.graphUri.empty() ? clause : "GRAPH <" + _config.graphUri + "> { " + clause + " } ";
 }
+
+// _________________________________________________________________________________________________
+std::string olu::sparql::QueryWriter::fillTemplate(const QueryTemplate &queryTemplate,
+                                                   const std::string_view valuePrefix,
+                                                   const std::set<id_t> &ids) {
+    // The query is sized once, so that the values are written without reallocation
+    std::string query;
+    query.reserve(queryTemplate.head.size() + queryTemplate.tail.size()
+                  + ids.size() * (valuePrefix.size() + MAX_ID_LENGTH));
+
+    query.append(queryTemplate.head);
+    char buffer[MAX_ID_LENGTH];
+    for (const auto & id : ids) {
+        query.append(valuePrefix);
+        query.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), id).ptr);
+        query.push_back(' ');
+    }
+    query.append(queryTemplate.tail);
+
+    return query;
+}
@@ -21,81 +21,282 @@
 #include "util/HttpRequest.h"
 #include "config/Constants.h"
 #include "util/XmlReader.h"
+#include "util/RunReport.h"
+#include "util/RequestTrace.h"
+#include "util/RequestRecording.h"
+#include "util/Metrics.h"
+#include "util/Tracepoints.h"
+#include "util/ChromeTrace.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <optional>
 #include <string>
 #include <fstream>
 #include <iostream>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
 
 namespace cnst = olu::config::constants;
 namespace olu::sparql {
+    namespace {
+        const std::string TRACE_KIND_QUERY = "query";
+        const std::string TRACE_KIND_UPDATE = "update";
+
+        // Returns the prefixes and the query as they are sent to the endpoint
+        std::string joinPrefixesAndQuery(const SparqlRequest &request) {
+            std::string text;
+            for (const auto & prefix : request.prefixes) {
+                text.append(prefix);
+                text.push_back(' ');
+            }
+            text.append(request.query);
+            return text;
+        }
+
+        // Parses the json response in place without copying it into a stream
+        void readJson(const std::string &response, boost::property_tree::ptree &tree) {
+            boost::iostreams::stream<boost::iostreams::array_source> stream(response.data(),
+                                                                              response.size());
+            read_json(stream, tree);
+        }
+
+        // QLever answers with a json object if an exception occurred
+        bool isJsonResponse(const std::string &response) {
+            const auto start = response.find_first_not_of(" \t\r\n");
+            return start != std::string::npos && response[start] == '{';
+        }
+    }
+
     // _____________________________________________________________________________________________
-    void SparqlWrapper::setQuery(const std::string &query) {
-        _query = query;
+    SparqlWrapper::SparqlWrapper(config::Config config) : _config(std::move(config)) {
+        std::vector<std::string> readUris{_config.sparqlEndpointUri};
+        readUris.insert(readUris.end(), _config.sparqlReadReplicaUris.begin(),
+                        _config.sparqlReadReplicaUris.end());
+        _readReplicas = std::make_shared<util::ReplicaPool>(std::move(readUris));
+        _updateEndpoint = std::make_shared<util::ReplicaPool>(
+            std::vector{_config.sparqlEndpointUriForUpdates});
     }
 
     // _____________________________________________________________________________________________
-    void SparqlWrapper::setPrefixes(const std::vector<std::string> &prefixes) {
-        for (const auto & prefix : prefixes) {
-            _prefixes += prefix + " ";
+    std::optional<double> SparqlWrapper::getServerTime(const std::string &response) {
+        if (!isJsonResponse(response)) {
+            return std::nullopt;
+        }
+
+        boost::property_tree::ptree pt;
+        try {
+            readJson(response, pt);
+        } catch(std::exception &_) {
+            return std::nullopt;
+        }
+
+        auto time = pt.get_optional<std::string>("time.computeResult");
+        if (!time) {
+            time = pt.get_optional<std::string>("time.total");
         }
+
+        if (!time || time->empty()) {
+            return std::nullopt;
+        }
+
+        char* end = nullptr;
+        const double value = std::strtod(time->c_str(), &end);
+        if (end == time->c_str()) {
+            return std::nullopt;
+        }
+
+        return value;
     }
 
+    // _____________________________________________________________________________________________
     std::string
-    SparqlWrapper::send(const std::string& acceptValue, bool isUpdate) {
+    SparqlWrapper::send(const SparqlRequest &sparqlRequest, const std::string& acceptValue,
+                        const bool isUpdate) const {
         if (_config.sparqlOutput == config::SparqlOutput::DEBUG_FILE ||
             (_config.sparqlOutput == config::SparqlOutput::FILE && isUpdate)) {
-            writeQueryToFileOutput();
+            writeQueryToFileOutput(sparqlRequest);
         }
 
-        // Format and encode query
-        std::string query = _prefixes + _query;
-        std::string encodedQuery = util::URLHelper::encodeForUrlQuery(query);
-
-        auto endpointUri = isUpdate ?
-                _config.sparqlEndpointUriForUpdates : _config.sparqlEndpointUri;
-        auto request = util::HttpRequest(util::POST, endpointUri);
-        request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, cnst::HTML_VALUE_CONTENT_TYPE);
-        request.addHeader(cnst::HTML_KEY_ACCEPT, acceptValue);
-        // We need to set this otherwise libcurl will wait 1 sec before sending the request
-        request.addHeader("Expect", "");
-
-        std::string body = (isUpdate ? "update=" : "query=") + encodedQuery;
+        // The prefixes and the query are encoded directly into the body, without joining them first
+        std::string body = isUpdate ? "update=" : "query=";
+        appendEncodedPrefixes(sparqlRequest.prefixes, body);
+        util::URLHelper::encodeForUrlQuery(sparqlRequest.query, body);
         body += _config.accessToken.empty() ? "" : "&access-token=" + _config.accessToken;
-        request.addBody(body);
+
+        const std::string &traceKind = sparqlRequest.kind.empty() ?
+                (isUpdate ? TRACE_KIND_UPDATE : TRACE_KIND_QUERY) : sparqlRequest.kind;
+        const auto batchSize = sparqlRequest.batchSize;
 
         std::string response;
+        const bool sendRequest =
+                !isUpdate || _config.sparqlOutput == config::SparqlOutput::ENDPOINT;
         try {
-            if (!isUpdate || _config.sparqlOutput == config::SparqlOutput::ENDPOINT) {
-                response = request.perform();
+            if (sendRequest) {
+                util::ChromeTrace::Span span(traceKind, isUpdate ? "update" : "query");
+                span.addArg("batchSize", batchSize);
+                {
+                    util::Metrics::InFlight inFlight(util::Metrics::SPARQL_IN_FLIGHT);
+                    OLU_TRACE2(sparql_start, traceKind.c_str(), batchSize);
+                    response = sendToReplica(isUpdate ? *_updateEndpoint : *_readReplicas,
+                                             !isUpdate && _config.hedgeReadQueries,
+                                             acceptValue, body, traceKind, batchSize);
+                    OLU_TRACE3(sparql_end, traceKind.c_str(), batchSize, response.size());
+                }
+                util::RunReport::countSparqlRequest();
+                util::Metrics::add(util::Metrics::SPARQL_REQUESTS_TOTAL, 1);
             }
         } catch(std::exception &e) {
             std::cerr << e.what() << std::endl;
             std::string msg =
                     "Exception while sending `POST` request to the sparql endpoint with body: "
-                    + query;
+                    + joinPrefixesAndQuery(sparqlRequest);
             throw SparqlWrapperException(msg.c_str());
         }
 
-        // Clear query and prefixes for next request
-        _query = ""; _prefixes = "";
+        // The request was sent successfully at this point, so a failure to record it is not
+        // reported as a failed request
+        if (sendRequest && !_config.requestRecordingFile.empty()) {
+            try {
+                // The access token is not recorded
+                util::RequestRecording::append(_config.requestRecordingFile,
+                                               body.substr(0, body.find("&access-token=")),
+                                               response);
+            } catch (const util::RequestRecordingException &e) {
+                std::cerr << e.what() << std::endl;
+                const std::string msg = "Could not record the request to the sparql endpoint in "
+                                        + _config.requestRecordingFile.string();
+                throw SparqlWrapperException(msg.c_str());
+            }
+        }
+
         return response;
     }
 
+    // _____________________________________________________________________________________________
+    void SparqlWrapper::appendEncodedPrefixes(const std::span<const std::string> prefixes,
+                                              std::string &body) {
+        if (prefixes.empty()) {
+            return;
+        }
+
+        // A list is identified by its address, and compared with the cached copy in case a
+        // different list was created at the same address
+        {
+            std::shared_lock lock(_encodedPrefixesMutex);
+            if (const auto it = _encodedPrefixes.find(prefixes.data());
+                it != _encodedPrefixes.end() && std::ranges::equal(it->second.prefixes, prefixes)) {
+                body.append(it->second.encoded);
+                return;
+            }
+        }
+
+        std::string encoded;
+        for (const auto & prefix : prefixes) {
+            util::URLHelper::encodeForUrlQuery(prefix, encoded);
+            encoded.append("%20");
+        }
+        body.append(encoded);
+
+        std::unique_lock lock(_encodedPrefixesMutex);
+        if (_encodedPrefixes.size() >= MAX_ENCODED_PREFIX_LISTS) {
+            _encodedPrefixes.clear();
+        }
+        _encodedPrefixes[prefixes.data()] = {{prefixes.begin(), prefixes.end()},
+                                             std::move(encoded)};
+    }
+
+    // _____________________________________________________________________________________________
+    void SparqlWrapper::setupRequest(util::HttpRequest &request, const std::string &acceptValue,
+                                     const std::string &body) {
+        request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, cnst::HTML_VALUE_CONTENT_TYPE);
+        request.addHeader(cnst::HTML_KEY_ACCEPT, acceptValue);
+        // We need to set this otherwise libcurl will wait 1 sec before sending the request
+        request.addHeader("Expect", "");
+        request.addBody(body);
+    }
+
+    // _____________________________________________________________________________________________
+    std::string SparqlWrapper::sendToReplica(util::ReplicaPool &replicas, const bool hedge,
+                                             const std::string &acceptValue,
+                                             const std::string &body,
+                                             const std::string &traceKind,
+                                             const std::size_t batchSize) {
+        const auto primaryReplica = replicas.select();
+        util::HttpRequest primary(util::POST, replicas.getUri(primaryReplica));
+        setupRequest(primary, acceptValue, body);
+
+        // A query is only hedged if there is a second replica and enough latencies are known
+        const auto hedgeDelay = hedge && replicas.size() > 1 ?
+                replicas.getHedgeDelay() : std::nullopt;
+        std::size_t hedgeReplica = primaryReplica;
+        std::optional<util::HttpRequest> hedgeRequest;
+        bool hedged = false;
+
+        util::HttpRequest* winner = &primary;
+        std::string response;
+        const auto start = std::chrono::steady_clock::now();
+        replicas.begin(primaryReplica);
+        try {
+            if (hedgeDelay) {
+                // The hedge replica is only selected when the hedge is sent, because the pool
+                // records each selection to balance the queries
+                winner = &util::HttpRequest::performHedged(primary, *hedgeDelay,
+                    [&]() -> util::HttpRequest& {
+                        hedgeReplica = replicas.select(primaryReplica);
+                        replicas.begin(hedgeReplica);
+                        hedged = true;
+                        util::Metrics::add(util::Metrics::SPARQL_HEDGED_REQUESTS_TOTAL, 1);
+
+                        hedgeRequest.emplace(util::POST, replicas.getUri(hedgeReplica));
+                        setupRequest(*hedgeRequest, acceptValue, body);
+                        return *hedgeRequest;
+                    });
+                response = winner->finish();
+            } else {
+                response = primary.perform();
+            }
+        } catch (...) {
+            replicas.end(primaryReplica, std::nullopt);
+            if (hedged) {
+                replicas.end(hedgeReplica, std::nullopt);
+            }
+            util::RequestTrace::write(traceKind, batchSize, *winner);
+            throw;
+        }
+
+        // Only the request that finished counts towards the latency, the other one was aborted.
+        // The latency is measured from the start of the primary, because that is how long the
+        // query took, even if the hedge answered it.
+        const bool hedgeWon = winner != &primary;
+        const double latency = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        replicas.end(primaryReplica, hedgeWon ? std::nullopt : std::optional(latency));
+        if (hedged) {
+            replicas.end(hedgeReplica, hedgeWon ? std::optional(latency) : std::nullopt);
+        }
+
+        if (util::RequestTrace::isEnabled()) {
+            util::RequestTrace::write(traceKind, batchSize, *winner, getServerTime(response));
+        }
+
+        return response;
+    }
 
     // _____________________________________________________________________________________________
-    void SparqlWrapper::runUpdate() {
-        auto response = send(cnst::HTML_VALUE_ACCEPT_SPARQL_RESULT_JSON, true);
+    void SparqlWrapper::runUpdate(const SparqlRequest &request) const {
+        auto response = send(request, cnst::HTML_VALUE_ACCEPT_SPARQL_RESULT_JSON, true);
 
         if (response.empty() || response == "Update successful") {
             return;
         }
 
         boost::property_tree::ptree pt;
-        std::istringstream json_stream(response);
         try {
-            read_json(json_stream, pt);
+            readJson(response, pt);
         } catch(std::exception &e) {
             std::cerr << e.what() << std::endl;
             std::string msg = "Could not interpret response from SPARQL endpoint: " + response;
@@ -110,28 +311,34 @@ namespace olu::sparql {
     }
 
     // _____________________________________________________________________________________________
-    boost::property_tree::ptree SparqlWrapper::runQuery() {
-        auto response = send(cnst::HTML_VALUE_ACCEPT_SPARQL_RESULT_XML,
-                             false);
+    boost::property_tree::ptree SparqlWrapper::runQuery(const SparqlRequest &request) const {
+        auto response = send(request, cnst::HTML_VALUE_ACCEPT_SPARQL_RESULT_XML, false);
 
         if (response.empty()) {
             throw SparqlWrapperException("Empty response from SPARQL endpoint");
         }
 
-        boost::property_tree::ptree pt;
-        std::istringstream json_stream(response);
-        // The QLever endpoint will return the content in json if an exception occurred, so we check
-        // If we can parse the response as json. If that fails the response is in xml format and we
-        // can carry on
-        try {
-            read_json(json_stream, pt);
-        } catch(std::exception &_) {
-            // If the json parsing failed that means we got a valid response from the endpoint
+        // The QLever endpoint will return the content in json if an exception occurred, otherwise
+        // the response is in xml format and can be parsed directly
+        if (!isJsonResponse(response)) {
             boost::property_tree::ptree responseAsTree;
             util::XmlReader::populatePTreeFromString(response, responseAsTree);
+
+            if (const auto results = responseAsTree.get_child_optional("sparql.results")) {
+                util::RunReport::countRows(results->count("result"));
+            }
+
             return responseAsTree;
         }
 
+        boost::property_tree::ptree pt;
+        try {
+            readJson(response, pt);
+        } catch(std::exception &_) {
+            std::string msg = "Could not interpret response from SPARQL endpoint: " + response;
+            throw SparqlWrapperException(msg.c_str());
+        }
+
         if (pt.get<std::string>("status") == "ERROR") {
             auto exception = pt.get<std::string>("exception");
             std::string msg = "SPARQL endpoint returned status ERROR with exception: " + exception;
@@ -142,10 +349,13 @@ namespace olu::sparql {
         throw SparqlWrapperException(msg.c_str());
     }
 
-    void SparqlWrapper::writeQueryToFileOutput() const {
+    void SparqlWrapper::writeQueryToFileOutput(const SparqlRequest &request) const {
+        const auto text = joinPrefixesAndQuery(request);
+
+        std::lock_guard lock(_outputFileMutex);
         std::ofstream outputFile;
         outputFile.open (_config.sparqlOutputFile, std::ios_base::app);
-        outputFile << _prefixes << _query << std::endl;
+        outputFile << text << std::endl;
         outputFile.close();
     }
 
@@ -156,6 +366,7 @@ namespace olu::sparql {
 
         try {
             request.perform();
+            util::RequestTrace::write("clearCache", 0, request);
         } catch(std::exception &e) {
             std::cerr << e.what() << std::endl;
             std::string msg =
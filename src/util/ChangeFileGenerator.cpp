@@ -0,0 +1,272 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ChangeFileGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+
+namespace olu::util {
+
+    static constexpr std::array HIGHWAY_VALUES = {
+        "residential", "service", "track", "footway", "primary", "secondary", "unclassified"};
+    static constexpr std::array AMENITY_VALUES = {
+        "bench", "restaurant", "cafe", "parking", "waste_basket", "post_box", "pharmacy"};
+
+    // _____________________________________________________________________________________________
+    ChangeFileGenerator::ChangeFileGenerator(const std::size_t numObjects,
+                                             const ChangeFileMix mix,
+                                             const unsigned int seed) : _numObjects(numObjects),
+                                                                        _mix(mix),
+                                                                        _random(seed) { }
+
+    // _____________________________________________________________________________________________
+    std::string ChangeFileGenerator::generate() {
+        std::discrete_distribution<int> editKind({_mix.nodeMoves, _mix.tagEdits, _mix.wayRewires,
+                                                  _mix.multipolygonEdits, _mix.deletes});
+
+        for (auto *block : {&_modifiedNodes, &_deletedNodes, &_modifiedWays, &_deletedWays,
+                            &_modifiedRelations, &_deletedRelations}) {
+            block->clear();
+        }
+        _nodePool.clear();
+        _wayPool.clear();
+        _closedWayPool.clear();
+
+        std::size_t objects = 0;
+        while (objects < _numObjects) {
+            switch (editKind(_random)) {
+                case 0: objects += writeNodeMove(); break;
+                case 1: objects += writeTagEdit(); break;
+                case 2: objects += writeWayRewire(); break;
+                case 3: objects += writeMultipolygonEdit(); break;
+                default: objects += writeDelete(); break;
+            }
+        }
+
+        // Nodes have to occur before ways and ways before relations
+        std::string content;
+        content.reserve(_modifiedNodes.size() + _deletedNodes.size() + _modifiedWays.size()
+                        + _deletedWays.size() + _modifiedRelations.size()
+                        + _deletedRelations.size() + 1024);
+        content += "<?xml version='1.0' encoding='UTF-8'?>\n";
+        content += "<osmChange version=\"0.6\" generator=\"olu-generate-changes\">\n";
+        for (const auto *block : {&_modifiedNodes, &_deletedNodes, &_modifiedWays,
+                                  &_deletedWays, &_modifiedRelations, &_deletedRelations}) {
+            if (block->empty()) { continue; }
+
+            const bool isDelete = block == &_deletedNodes || block == &_deletedWays ||
+                                  block == &_deletedRelations;
+            content += isDelete ? "  <delete>\n" : "  <modify>\n";
+            content += *block;
+            content += isDelete ? "  </delete>\n" : "  </modify>\n";
+        }
+        content += "</osmChange>\n";
+
+        return content;
+    }
+
+    // _____________________________________________________________________________________________
+    void ChangeFileGenerator::write(const std::string &content,
+                                    const std::filesystem::path &path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (path.extension() != ".gz") {
+            file << content;
+            return;
+        }
+
+        boost::iostreams::filtering_ostream out;
+        out.push(boost::iostreams::gzip_compressor());
+        out.push(file);
+        out << content;
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ChangeFileGenerator::writeNodeMove() {
+        const auto id = _nextNodeId++;
+        writeNode(_modifiedNodes, id, false);
+        _nodePool.emplace_back(id);
+        return 1;
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ChangeFileGenerator::writeTagEdit() {
+        // Tag edits on ways need nodes to reference
+        if (_nodePool.size() < 2 || getRandomIndex(2) == 0) {
+            const auto id = _nextNodeId++;
+            writeNode(_modifiedNodes, id, true);
+            _nodePool.emplace_back(id);
+            return 1;
+        }
+
+        const auto id = _nextWayId++;
+        writeWay(_modifiedWays, id, {_nodePool[getRandomIndex(_nodePool.size())],
+                                     _nodePool[getRandomIndex(_nodePool.size())]}, true);
+        _wayPool.emplace_back(id);
+        return 1;
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ChangeFileGenerator::writeWayRewire() {
+        std::size_t objects = 0;
+
+        // Every rewired way gets some new nodes, the rest is taken from the existing ones
+        const std::size_t numNodes = 2 + getRandomIndex(9);
+        std::vector<id_t> nodeIds;
+        for (std::size_t i = 0; i < numNodes; ++i) {
+            if (_nodePool.empty() || getRandomIndex(3) == 0) {
+                objects += writeNodeMove();
+                nodeIds.emplace_back(_nodePool.back());
+            } else {
+                nodeIds.emplace_back(_nodePool[getRandomIndex(_nodePool.size())]);
+            }
+        }
+
+        const auto id = _nextWayId++;
+        // Some ways are closed, so that they can be used as outer ring of a multipolygon
+        const bool closed = numNodes >= 3 && getRandomIndex(3) == 0;
+        if (closed) {
+            nodeIds.emplace_back(nodeIds.front());
+            _closedWayPool.emplace_back(id);
+        }
+
+        writeWay(_modifiedWays, id, nodeIds, true);
+        _wayPool.emplace_back(id);
+        return objects + 1;
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ChangeFileGenerator::writeMultipolygonEdit() {
+        std::size_t objects = 0;
+        while (_closedWayPool.empty()) {
+            objects += writeWayRewire();
+        }
+
+        const auto id = _nextRelationId++;
+        std::ostringstream oss;
+        oss << "    <relation " << getAttributes(id) << ">\n";
+        // The members are drawn with a partial shuffle of the pool, so that a way is not used
+        // twice in the same multipolygon
+        const std::size_t numMembers = std::min(1 + getRandomIndex(3), _closedWayPool.size());
+        for (std::size_t i = 0; i < numMembers; ++i) {
+            std::swap(_closedWayPool[i],
+                      _closedWayPool[i + getRandomIndex(_closedWayPool.size() - i)]);
+            oss << "      <member type=\"way\" ref=\"" << _closedWayPool[i]
+                << "\" role=\"" << (i == 0 ? "outer" : "inner") << "\"/>\n";
+        }
+        oss << "      <tag k=\"type\" v=\"multipolygon\"/>\n";
+        oss << "      <tag k=\"landuse\" v=\"" << (getRandomIndex(2) == 0 ? "forest" : "grass")
+            << "\"/>\n";
+        oss << "    </relation>\n";
+        _modifiedRelations += oss.str();
+
+        return objects + 1;
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ChangeFileGenerator::writeDelete() {
+        // Deleted objects get ids that are never referenced in the file
+        switch (getRandomIndex(10)) {
+            case 0: {
+                std::ostringstream oss;
+                oss << "    <relation " << getAttributes(_nextRelationId++) << "/>\n";
+                _deletedRelations += oss.str();
+                break;
+            }
+            case 1:
+            case 2: {
+                std::ostringstream oss;
+                oss << "    <way " << getAttributes(_nextWayId++) << "/>\n";
+                _deletedWays += oss.str();
+                break;
+            }
+            default: {
+                std::ostringstream oss;
+                oss << "    <node " << getAttributes(_nextNodeId++) << "/>\n";
+                _deletedNodes += oss.str();
+                break;
+            }
+        }
+
+        return 1;
+    }
+
+    // _____________________________________________________________________________________________
+    void ChangeFileGenerator::writeNode(std::string &out, const id_t id, const bool withTags) {
+        std::ostringstream oss;
+        oss << "    <node " << getAttributes(id) << " " << getRandomLocation();
+        if (!withTags) {
+            oss << "/>\n";
+        } else {
+            oss << ">\n"
+                << "      <tag k=\"amenity\" v=\""
+                << AMENITY_VALUES[getRandomIndex(AMENITY_VALUES.size())] << "\"/>\n"
+                << "      <tag k=\"name\" v=\"Node " << id << "\"/>\n"
+                << "    </node>\n";
+        }
+        out += oss.str();
+    }
+
+    // _____________________________________________________________________________________________
+    void ChangeFileGenerator::writeWay(std::string &out, const id_t id,
+                                       const std::vector<id_t> &nodeIds, const bool withTags) {
+        std::ostringstream oss;
+        oss << "    <way " << getAttributes(id) << ">\n";
+        for (const auto &nodeId : nodeIds) {
+            oss << "      <nd ref=\"" << nodeId << "\"/>\n";
+        }
+        if (withTags) {
+            oss << "      <tag k=\"highway\" v=\""
+                << HIGHWAY_VALUES[getRandomIndex(HIGHWAY_VALUES.size())] << "\"/>\n";
+        }
+        oss << "    </way>\n";
+        out += oss.str();
+    }
+
+    // _____________________________________________________________________________________________
+    std::string ChangeFileGenerator::getAttributes(const id_t id) {
+        std::ostringstream oss;
+        oss << "id=\"" << id << "\" version=\"" << 2 + getRandomIndex(20)
+            << "\" timestamp=\"2024-08-02T10:00:33Z\" uid=\"1\" user=\"olu\" changeset=\""
+            << 1 + getRandomIndex(1000) << "\"";
+        return oss.str();
+    }
+
+    // _____________________________________________________________________________________________
+    std::string ChangeFileGenerator::getRandomLocation() {
+        // Locations are spread over central europe
+        std::uniform_real_distribution lat(45.0, 55.0);
+        std::uniform_real_distribution lon(5.0, 15.0);
+
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(7)
+            << "lat=\"" << lat(_random) << "\" lon=\"" << lon(_random) << "\"";
+        return oss.str();
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ChangeFileGenerator::getRandomIndex(const std::size_t size) {
+        return std::uniform_int_distribution<std::size_t>(0, size - 1)(_random);
+    }
+
+} // namespace olu::util
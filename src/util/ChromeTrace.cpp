@@ -0,0 +1,135 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ChromeTrace.h"
+#include "util/JsonHelper.h"
+
+#include <sstream>
+#include <unistd.h>
+
+namespace olu::util {
+
+    // _____________________________________________________________________________________________
+    ChromeTrace::Span::Span(std::string name, std::string category) : _enabled(isEnabled()) {
+        if (!_enabled) {
+            return;
+        }
+
+        _name = std::move(name);
+        _category = std::move(category);
+        _start = now();
+    }
+
+    // _____________________________________________________________________________________________
+    ChromeTrace::Span::~Span() {
+        if (!_enabled) {
+            return;
+        }
+
+        std::ostringstream oss;
+        oss << "{\"name\":\"" << JsonHelper::escape(_name) << "\""
+            << ",\"cat\":\"" << JsonHelper::escape(_category) << "\""
+            << ",\"ph\":\"X\""
+            << ",\"ts\":" << _start
+            << ",\"dur\":" << now() - _start
+            << ",\"pid\":" << getpid()
+            << ",\"tid\":" << getThreadId()
+            << ",\"args\":{" << _args << "}}";
+        writeEvent(oss.str());
+    }
+
+    // _____________________________________________________________________________________________
+    void ChromeTrace::Span::addArg(const std::string &key, const std::string &value) {
+        if (!_enabled) {
+            return;
+        }
+
+        _args += (_args.empty() ? "\"" : ",\"") + JsonHelper::escape(key) + "\":\""
+                 + JsonHelper::escape(value) + "\"";
+    }
+
+    // _____________________________________________________________________________________________
+    void ChromeTrace::Span::addArg(const std::string &key, const std::size_t value) {
+        if (!_enabled) {
+            return;
+        }
+
+        _args += (_args.empty() ? "\"" : ",\"") + JsonHelper::escape(key) + "\":"
+                 + std::to_string(value);
+    }
+
+    // _____________________________________________________________________________________________
+    void ChromeTrace::open(const std::filesystem::path &path) {
+        std::lock_guard lock(_mutex);
+        if (_file.is_open()) {
+            _file << "\n]\n";
+            _file.close();
+        }
+
+        _file.open(path, std::ios::trunc);
+        if (!_file) {
+            _enabled = false;
+            const std::string msg = "Can not open chrome trace file: " + path.string();
+            throw ChromeTraceException(msg.c_str());
+        }
+
+        _file << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << getpid()
+              << ",\"args\":{\"name\":\"olu\"}}";
+        _enabled = true;
+    }
+
+    // _____________________________________________________________________________________________
+    void ChromeTrace::close() {
+        std::lock_guard lock(_mutex);
+        _enabled = false;
+        if (_file.is_open()) {
+            _file << "\n]\n";
+            _file.close();
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    bool ChromeTrace::isEnabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    // _____________________________________________________________________________________________
+    long ChromeTrace::now() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - _startTime).count();
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ChromeTrace::getThreadId() {
+        thread_local const std::size_t threadId = _nextThreadId++;
+        return threadId;
+    }
+
+    // _____________________________________________________________________________________________
+    void ChromeTrace::writeEvent(const std::string &event) {
+        std::lock_guard lock(_mutex);
+        if (!_file.is_open()) {
+            return;
+        }
+
+        // The process name is always the first event, so every span is preceded by a comma
+        _file << ",\n" << event;
+        _file.flush();
+    }
+
+} // namespace olu::util
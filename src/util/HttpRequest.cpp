@@ -17,43 +17,122 @@
 // along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "util/HttpRequest.h"
+#include "util/RunReport.h"
+#include "util/Tracepoints.h"
+#include "util/ChromeTrace.h"
 
 #include <curl/curl.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <vector>
-#include <cstring>
+#include <mutex>
+
+// Maximum number of bytes that are reserved for a response in advance
+static inline constexpr std::size_t MAX_RESERVED_RESPONSE_SIZE = 64 * 1024 * 1024;
+
+namespace {
+    /**
+     * Owns a curl multi handle and removes the easy handles that are still attached to it when it
+     * is destroyed, which aborts their transfers.
+     */
+    class MultiHandle {
+    public:
+        MultiHandle() : _multi(curl_multi_init()) { }
+        ~MultiHandle() {
+            for (CURL* easy : _attached) {
+                curl_multi_remove_handle(_multi, easy);
+            }
+            curl_multi_cleanup(_multi);
+        }
+        MultiHandle(const MultiHandle&) = delete;
+        MultiHandle& operator=(const MultiHandle&) = delete;
+
+        [[nodiscard]] CURLM* get() const { return _multi; }
+
+        void add(CURL* easy) {
+            curl_multi_add_handle(_multi, easy);
+            _attached.push_back(easy);
+        }
+
+        void remove(CURL* easy) {
+            curl_multi_remove_handle(_multi, easy);
+            std::erase(_attached, easy);
+        }
+
+        [[nodiscard]] bool isAttached(CURL* easy) const {
+            return std::ranges::find(_attached, easy) != _attached.end();
+        }
+    private:
+        CURLM* _multi;
+        std::vector<CURL*> _attached;
+    };
+}
 
 namespace olu::util {
 
 // _________________________________________________________________________________________________
-static size_t WriteMemoryCallback(void* contents, size_t size, size_t nmemb, void* userp)
-{
-    size_t realsize = size * nmemb;
-    auto& mem = *static_cast<std::string*>(userp);
-    mem.append(static_cast<char*>(contents), realsize);
-    memset(contents, 0, realsize);
+size_t HttpRequest::writeCallback(char* contents, const size_t size, const size_t nmemb,
+                                  void* userp) {
+    const size_t realsize = size * nmemb;
+    auto& request = *static_cast<HttpRequest*>(userp);
+    request._responseSize += realsize;
+
+    // Exceptions must not pass through libcurl, so the transfer is aborted by returning a
+    // different size and the exception is rethrown in `perform()`
+    try {
+        if (request._sink) {
+            request._sink(std::string_view(contents, realsize));
+            return realsize;
+        }
+
+        if (request._data.empty()) {
+            // Reserve the whole body at once if the server sent a Content-Length. The length is
+            // capped, because it is sent by the server and the body can still be shorter.
+            curl_off_t contentLength = -1;
+            curl_easy_getinfo(request._curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength);
+            if (contentLength > 0) {
+                request._data.reserve(std::min(static_cast<std::size_t>(contentLength),
+                                               MAX_RESERVED_RESPONSE_SIZE));
+            }
+        }
+
+        request._data.append(contents, realsize);
+    } catch (...) {
+        request._callbackException = std::current_exception();
+        return 0;
+    }
+
     return realsize;
 }
 
 // _________________________________________________________________________________________________
-void setup_curl(CURL* curl_handle, std::string& data, const std::string& url)
+void setup_curl(CURL* curl_handle, void* userp, curl_write_callback callback,
+                const std::string& url)
 {
     curl_easy_setopt(curl_handle, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
-    curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, &data);
+    curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, callback);
+    curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, userp);
     curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1L);
+    // Signals are not thread-safe, and requests can be sent from several threads
+    curl_easy_setopt(curl_handle, CURLOPT_NOSIGNAL, 1L);
 
 //    curl_easy_setopt(curl_handle, CURLOPT_VERBOSE, 1L);
 }
 
 // _________________________________________________________________________________________________
 HttpRequest::HttpRequest(const HttpMethod& method, const std::string& url) {
+    // curl_global_init is not thread-safe, so it has to run once before the first handle is
+    // created instead of implicitly in curl_easy_init
+    static std::once_flag curlInitialized;
+    std::call_once(curlInitialized, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
     _curl = curl_easy_init();
     _method = method;
     _res = CURLcode::CURLE_FAILED_INIT;
     _url = url;
-    setup_curl(_curl, _data, url);
+    setup_curl(_curl, this, writeCallback, url);
 }
 
 // _________________________________________________________________________________________________
@@ -74,8 +153,16 @@ void HttpRequest::addBody(std::string body) {
 }
 
 // _________________________________________________________________________________________________
-std::string HttpRequest::perform() {
-    std::string response;
+void HttpRequest::setResponseSink(ResponseSink sink) {
+    _sink = std::move(sink);
+}
+
+// _________________________________________________________________________________________________
+void HttpRequest::prepare() {
+    if (_curl == nullptr) {
+        throw HttpRequestException("Failed to initialize CURL");
+    }
+
     curl_easy_setopt(_curl, CURLOPT_HTTPHEADER, _chunk);
 
     if (_method == POST) {
@@ -84,11 +171,17 @@ std::string HttpRequest::perform() {
         curl_easy_setopt(_curl, CURLOPT_POSTFIELDSIZE, _body.length());
     }
 
-    if(_curl != nullptr) {
-        _res = curl_easy_perform(_curl);
-        response = _data;
-    } else {
-        throw HttpRequestException("Failed to initialize CURL");
+    OLU_TRACE3(http_start, _method == POST ? "POST" : "GET", _url.c_str(), getRequestSize());
+}
+
+// _________________________________________________________________________________________________
+std::string HttpRequest::finish() {
+    RunReport::countBytes(getRequestSize(), getResponseSize());
+    OLU_TRACE5(http_end, _method == POST ? "POST" : "GET", _url.c_str(), getResponseCode(),
+               getRequestSize(), getResponseSize());
+
+    if (_callbackException) {
+        std::rethrow_exception(_callbackException);
     }
 
     if (_res != CURLE_OK) {
@@ -97,7 +190,7 @@ std::string HttpRequest::perform() {
             std::cerr << "POST failed with reason " << reason << std::endl;
             std::cerr << "URL: " << _url << std::endl;
             std::cerr << "Body: see Log at log.txt" << std::endl;
-            std::cerr << "Response: " << response << std::endl;
+            std::cerr << "Response: " << _data << std::endl;
 
             std::ofstream outputFile;
             outputFile.open ("log.txt", std::ios_base::app);
@@ -106,12 +199,132 @@ std::string HttpRequest::perform() {
         } else if (_method == GET) {
             std::cerr << "GET failed with reason " << reason << std::endl;
             std::cerr << "URL: " << _url << std::endl;
-            std::cerr << "Response: " << response << std::endl;
+            std::cerr << "Response: " << _data << std::endl;
         }
         throw HttpRequestException(&"Http Request failed: " [ _res]);
     }
 
-    return response;
+    // The response is not needed by the request anymore, its size is kept in `_responseSize`
+    return std::move(_data);
+}
+
+// _________________________________________________________________________________________________
+std::string HttpRequest::perform() {
+    prepare();
+    {
+        ChromeTrace::Span span(_method == POST ? "POST" : "GET", "http");
+        span.addArg("url", _url);
+        _res = curl_easy_perform(_curl);
+        span.addArg("status", static_cast<std::size_t>(getResponseCode()));
+        span.addArg("requestBytes", getRequestSize());
+        span.addArg("responseBytes", getResponseSize());
+    }
+
+    return finish();
+}
+
+// _________________________________________________________________________________________________
+HttpRequest& HttpRequest::performHedged(HttpRequest &primary,
+                                        const std::chrono::milliseconds hedgeDelay,
+                                        const std::function<HttpRequest&()> &makeHedge) {
+    primary.prepare();
+
+    MultiHandle multi;
+    if (multi.get() == nullptr) {
+        throw HttpRequestException("Failed to initialize CURL");
+    }
+
+    ChromeTrace::Span span("hedged", "http");
+    span.addArg("url", primary._url);
+
+    multi.add(primary._curl);
+    const auto start = std::chrono::steady_clock::now();
+    HttpRequest* hedge = nullptr;
+    HttpRequest* winner = nullptr;
+
+    while (winner == nullptr) {
+        int running = 0;
+        curl_multi_perform(multi.get(), &running);
+
+        int queued = 0;
+        while (const CURLMsg* msg = curl_multi_info_read(multi.get(), &queued)) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+
+            const bool isPrimary = msg->easy_handle == primary._curl;
+            HttpRequest &request = isPrimary ? primary : *hedge;
+            request._res = msg->data.result;
+            multi.remove(request._curl);
+
+            // A failed request only decides the result if the other one can not succeed anymore.
+            // An error status from the server counts as failure as well, because the other
+            // replica might still answer the query.
+            const long code = request.getResponseCode();
+            const bool succeeded = request._res == CURLE_OK && code >= 200 && code < 300;
+            const bool otherRunning = isPrimary ?
+                hedge != nullptr && multi.isAttached(hedge->_curl) :
+                multi.isAttached(primary._curl);
+            if (succeeded || !otherRunning) {
+                winner = &request;
+                break;
+            }
+        }
+
+        if (winner != nullptr) {
+            break;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        if (hedge == nullptr && multi.isAttached(primary._curl) && elapsed >= hedgeDelay) {
+            hedge = &makeHedge();
+            hedge->prepare();
+            multi.add(hedge->_curl);
+            continue;
+        }
+
+        const auto timeout = hedge != nullptr ? std::chrono::milliseconds(1000) :
+                                                hedgeDelay - elapsed;
+        curl_multi_poll(multi.get(), nullptr, 0, static_cast<int>(timeout.count()), nullptr);
+    }
+
+    // The slower request is aborted when its handle is removed from the multi handle
+    span.addArg("hedged", static_cast<std::size_t>(hedge != nullptr));
+    span.addArg("status", static_cast<std::size_t>(winner->getResponseCode()));
+    span.addArg("responseBytes", winner->getResponseSize());
+    return *winner;
+}
+
+// _________________________________________________________________________________________________
+static double getTimeInfo(CURL* curl_handle, const CURLINFO info) {
+    curl_off_t time = 0;
+    curl_easy_getinfo(curl_handle, info, &time);
+    return static_cast<double>(time) / 1000.0;
+}
+
+// _________________________________________________________________________________________________
+RequestTimings HttpRequest::getTimings() const {
+    // libcurl reports the time from the start of the request until the end of each step, so
+    // the previous steps are subtracted to get the time of the single steps
+    const double nameLookup = getTimeInfo(_curl, CURLINFO_NAMELOOKUP_TIME_T);
+    const double connect = getTimeInfo(_curl, CURLINFO_CONNECT_TIME_T);
+    const double appConnect = getTimeInfo(_curl, CURLINFO_APPCONNECT_TIME_T);
+
+    RequestTimings timings;
+    timings.nameLookup = nameLookup;
+    timings.connect = connect - nameLookup;
+    timings.tls = appConnect > 0 ? appConnect - connect : 0;
+    timings.firstByte = getTimeInfo(_curl, CURLINFO_STARTTRANSFER_TIME_T);
+    timings.total = getTimeInfo(_curl, CURLINFO_TOTAL_TIME_T);
+    return timings;
+}
+
+// _________________________________________________________________________________________________
+long HttpRequest::getResponseCode() const {
+    long code = 0;
+    curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, &code);
+    return code;
 }
 
 } // namespace olu::util
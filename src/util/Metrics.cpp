@@ -0,0 +1,131 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/Metrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace olu::util {
+
+    // Help texts for the series that are known in advance
+    static const std::map<std::string, std::string> HELP = {
+        {Metrics::SEQUENCE_NUMBER, "Sequence number of the last applied change file"},
+        {Metrics::REPLICATION_TIMESTAMP, "Timestamp of the last applied replication state"},
+        {Metrics::REPLICATION_LAG,
+         "Seconds between the last applied replication state and the wall clock"},
+        {Metrics::OBJECTS_PER_SECOND, "Osm objects processed per second in the last run"},
+        {Metrics::TRIPLES_PER_SECOND, "Triples inserted per second in the last run"},
+        {Metrics::OBJECTS_TOTAL, "Osm objects processed since the start of the process"},
+        {Metrics::TRIPLES_TOTAL, "Triples inserted since the start of the process"},
+        {Metrics::SPARQL_IN_FLIGHT, "SPARQL requests that are currently waiting for a response"},
+        {Metrics::SPARQL_REQUESTS_TOTAL, "SPARQL requests sent since the start of the process"},
+        {Metrics::SPARQL_HEDGED_REQUESTS_TOTAL,
+            "SPARQL queries that were also sent to a second read replica"},
+        {Metrics::STAGE_QUEUE_DEPTH, "Objects or triples that are still waiting in each stage"},
+    };
+
+    // _____________________________________________________________________________________________
+    void Metrics::set(const std::string &name, const double value, const std::string &labels) {
+        std::lock_guard lock(_mutex);
+        _series[name][labels] = value;
+    }
+
+    // _____________________________________________________________________________________________
+    void Metrics::add(const std::string &name, const double value, const std::string &labels) {
+        std::lock_guard lock(_mutex);
+        _series[name][labels] += value;
+    }
+
+    // _____________________________________________________________________________________________
+    double Metrics::get(const std::string &name, const std::string &labels) {
+        std::lock_guard lock(_mutex);
+        const auto series = _series.find(name);
+        if (series == _series.end()) {
+            return 0;
+        }
+
+        const auto value = series->second.find(labels);
+        return value == series->second.end() ? 0 : value->second;
+    }
+
+    // _____________________________________________________________________________________________
+    void Metrics::setReplicationTimestamp(const std::string &timestamp) {
+        // Timestamps from replication state files escape the colons, e.g. '12\:00\:00'
+        std::string unescaped;
+        std::ranges::copy_if(timestamp, std::back_inserter(unescaped),
+                             [](const char c) { return c != '\\'; });
+
+        std::tm time{};
+        std::istringstream iss(unescaped);
+        iss >> std::get_time(&time, "%Y-%m-%dT%H:%M:%S");
+        if (iss.fail()) {
+            return;
+        }
+
+        set(REPLICATION_TIMESTAMP, static_cast<double>(timegm(&time)));
+    }
+
+    // _____________________________________________________________________________________________
+    std::string Metrics::render() {
+        const auto now = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        std::lock_guard lock(_mutex);
+        if (const auto timestamp = _series.find(REPLICATION_TIMESTAMP);
+            timestamp != _series.end()) {
+            _series[REPLICATION_LAG][""] = now - timestamp->second[""];
+        }
+
+        std::ostringstream oss;
+        // Large enough for timestamps, while integral values are printed without a fraction
+        oss << std::setprecision(15);
+        for (const auto &[name, values] : _series) {
+            if (const auto help = HELP.find(name); help != HELP.end()) {
+                oss << "# HELP " << name << " " << help->second << "\n";
+            }
+            oss << "# TYPE " << name << " "
+                << (name.ends_with("_total") ? "counter" : "gauge") << "\n";
+
+            for (const auto &[labels, value] : values) {
+                oss << name;
+                if (!labels.empty()) {
+                    oss << "{" << labels << "}";
+                }
+                oss << " " << value << "\n";
+            }
+        }
+
+        return oss.str();
+    }
+
+    // _____________________________________________________________________________________________
+    Metrics::InFlight::InFlight(std::string name) : _name(std::move(name)) {
+        add(_name, 1);
+    }
+
+    // _____________________________________________________________________________________________
+    Metrics::InFlight::~InFlight() {
+        add(_name, -1);
+    }
+
+} // namespace olu::util
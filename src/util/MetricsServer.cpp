@@ -0,0 +1,153 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/MetricsServer.h"
+#include "util/Metrics.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+namespace asio = boost::asio;
+using tcp = boost::asio::ip::tcp;
+
+// Time a client has to send its request and receive the response before the connection is
+// closed, so that an idle client does not keep the connection open
+static inline constexpr std::chrono::seconds CONNECTION_TIMEOUT{5};
+
+namespace {
+    // A connection of a client. The connection stays alive as long as one of its asynchronous
+    // operations is pending.
+    struct Connection : std::enable_shared_from_this<Connection> {
+        explicit Connection(tcp::socket socket)
+            : socket(std::move(socket)), deadline(this->socket.get_executor()) { }
+
+        tcp::socket socket;
+        asio::steady_timer deadline;
+        asio::streambuf request;
+        std::string response;
+
+        void start() {
+            deadline.expires_after(CONNECTION_TIMEOUT);
+            deadline.async_wait([self = shared_from_this()](const boost::system::error_code &ec) {
+                if (!ec) {
+                    boost::system::error_code closeEc;
+                    self->socket.close(closeEc);
+                }
+            });
+
+            asio::async_read_until(socket, request, "\r\n\r\n",
+                                   [self = shared_from_this()](const boost::system::error_code &ec,
+                                                               std::size_t) {
+                if (ec) {
+                    self->deadline.cancel();
+                    return;
+                }
+
+                const auto body = olu::util::Metrics::render();
+                self->response = "HTTP/1.1 200 OK\r\n"
+                                 "Content-Type: text/plain; version=0.0.4\r\n"
+                                 "Content-Length: " + std::to_string(body.size()) +
+                                 "\r\nConnection: close\r\n\r\n" + body;
+                asio::async_write(self->socket, asio::buffer(self->response),
+                                  [self](const boost::system::error_code &, std::size_t) {
+                    self->deadline.cancel();
+                    boost::system::error_code closeEc;
+                    self->socket.shutdown(tcp::socket::shutdown_both, closeEc);
+                    self->socket.close(closeEc);
+                });
+            });
+        }
+    };
+}
+
+namespace olu::util {
+
+    // _____________________________________________________________________________________________
+    MetricsServer::MetricsServer(const unsigned short port) : _acceptor(_ioContext) {
+        try {
+            const tcp::endpoint endpoint(asio::ip::address_v4::loopback(), port);
+            _acceptor.open(endpoint.protocol());
+            _acceptor.set_option(tcp::acceptor::reuse_address(true));
+            _acceptor.bind(endpoint);
+            _acceptor.listen();
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            const std::string msg = "Metrics server can not listen on port "
+                                    + std::to_string(port);
+            throw MetricsServerException(msg.c_str());
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    MetricsServer::~MetricsServer() {
+        stop();
+    }
+
+    // _____________________________________________________________________________________________
+    void MetricsServer::start() {
+        if (_running.exchange(true)) {
+            return;
+        }
+
+        accept();
+        _thread = std::thread([this]() { _ioContext.run(); });
+    }
+
+    // _____________________________________________________________________________________________
+    void MetricsServer::stop() {
+        if (!_running.exchange(false)) {
+            return;
+        }
+
+        // Open connections are dropped as well, so that stopping does not wait for their timeout
+        asio::post(_ioContext, [this]() {
+            boost::system::error_code ec;
+            _acceptor.close(ec);
+            _ioContext.stop();
+        });
+        _thread.join();
+    }
+
+    // _____________________________________________________________________________________________
+    unsigned short MetricsServer::getPort() const {
+        return _acceptor.local_endpoint().port();
+    }
+
+    // _____________________________________________________________________________________________
+    void MetricsServer::accept() {
+        _acceptor.async_accept([this](const boost::system::error_code &ec, tcp::socket socket) {
+            if (ec) {
+                // The acceptor was closed
+                return;
+            }
+
+            // The next client is accepted right away, so that a slow client does not block the
+            // scrapes of the others
+            std::make_shared<Connection>(std::move(socket))->start();
+            accept();
+        });
+    }
+
+} // namespace olu::util
@@ -5,7 +5,7 @@
 #include "util/OsmObjectHelper.h"
 #include "util/XmlReader.h"
 
-#include <iostream>
+#include <charconv>
 #include <string>
 
 namespace olu::osm {
@@ -22,25 +22,29 @@ namespace olu::osm {
         return false;
     }
 
-    id_t OsmObjectHelper::getIdFromUri(const std::string &uri) {
-        std::vector<char> id;
-        // Read characters from end of uri until first non digit is reached
-        for (auto it = uri.rbegin(); it != uri.rend(); ++it) {
-            if (std::isdigit(*it)) {
-                id.push_back(*it);
-            } else {
-                break;
-            }
+    id_t OsmObjectHelper::getIdFromUri(const std::string_view uri) {
+        // Find the first character of the id by reading from the end of the uri until the first
+        // non digit is reached
+        auto begin = uri.size();
+        while (begin > 0 && static_cast<unsigned char>(uri[begin - 1] - '0') < 10) {
+            --begin;
         }
 
-        try {
-            return std::stoll(std::string(id.rbegin(), id.rend()));
-        } catch (const std::exception &e) {
-            std::cerr << e.what() << std::endl;
-            const std::string msg = "Cant extract id from uri: " + uri;
+        id_t id;
+        const auto [ptr, ec] = std::from_chars(uri.data() + begin, uri.data() + uri.size(), id);
+        if (ec != std::errc()) {
+            const std::string msg = "Cant extract id from uri: " + std::string(uri);
             throw OsmObjectHelperException(msg.c_str());
         }
-    }
-}
 
+        return id;
+    }
 
+    void OsmObjectHelper::getIdsFromUris(const boost::property_tree::ptree &results,
+                                         const std::string &path, std::vector<id_t> &ids) {
+        ids.reserve(ids.size() + results.size());
+        for (const auto &result : results) {
+            ids.emplace_back(getIdFromUri(result.second.get_child(path).data()));
+        }
+    }
+}
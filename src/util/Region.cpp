@@ -0,0 +1,257 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "util/Region.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+namespace olu::util {
+
+    namespace {
+        // _________________________________________________________________________________________
+        std::string_view trim(std::string_view value) {
+            const auto begin = value.find_first_not_of(" \t\r");
+            if (begin == std::string_view::npos) {
+                return {};
+            }
+            const auto end = value.find_last_not_of(" \t\r");
+            return value.substr(begin, end - begin + 1);
+        }
+
+        // _________________________________________________________________________________________
+        // Reads a coordinate from the start of `value` and removes it together with the
+        // separators that follow it. Returns false if `value` does not start with a number.
+        bool readCoordinate(std::string_view &value, const std::string_view separators,
+                            double &coordinate) {
+            // std::from_chars does not accept a leading plus sign, which polygon files written
+            // in scientific notation sometimes contain
+            if (!value.empty() && value.front() == '+') {
+                value.remove_prefix(1);
+            }
+
+            const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(),
+                                                   coordinate);
+            if (ec != std::errc()) {
+                return false;
+            }
+
+            value.remove_prefix(ptr - value.data());
+            const auto next = value.find_first_not_of(separators);
+            value.remove_prefix(next == std::string_view::npos ? value.size() : next);
+            return true;
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    Region Region::fromBbox(std::string_view bbox) {
+        double minLon, minLat, maxLon, maxLat;
+        bbox = trim(bbox);
+        if (!readCoordinate(bbox, ", ", minLon) || !readCoordinate(bbox, ", ", minLat) ||
+            !readCoordinate(bbox, ", ", maxLon) || !readCoordinate(bbox, ", ", maxLat) ||
+            !bbox.empty()) {
+            throw RegionException("Bounding box has to be of the form MIN_LON,MIN_LAT,MAX_LON,"
+                                  "MAX_LAT");
+        }
+
+        if (!(minLon < maxLon) || !(minLat < maxLat)) {
+            throw RegionException("Minimum of bounding box has to be smaller than its maximum");
+        }
+
+        if (minLon < -180 || maxLon > 180 || minLat < -90 || maxLat > 90) {
+            throw RegionException("Bounding box lies outside of the valid coordinate range");
+        }
+
+        Region region({{
+            {minLon, minLat, maxLon, minLat},
+            {maxLon, minLat, maxLon, maxLat},
+            {maxLon, maxLat, minLon, maxLat},
+            {minLon, maxLat, minLon, minLat}
+        }});
+        region._isBox = true;
+        return region;
+    }
+
+    // _____________________________________________________________________________________________
+    Region Region::fromPolygon(const std::string_view polygon) {
+        std::vector<std::vector<Edge>> rings;
+        std::vector<std::pair<double, double>> points;
+
+        // The first line is the name of the polygon, which we do not need
+        bool readName = false;
+        bool inRing = false;
+        bool closed = false;
+        std::size_t lineNumber = 0;
+        std::size_t position = 0;
+        while (position < polygon.size() && !closed) {
+            auto end = polygon.find('\n', position);
+            if (end == std::string_view::npos) {
+                end = polygon.size();
+            }
+            const auto line = trim(polygon.substr(position, end - position));
+            position = end + 1;
+            ++lineNumber;
+
+            if (line.empty()) {
+                continue;
+            }
+
+            if (!readName) {
+                readName = true;
+            } else if (!inRing) {
+                if (line == "END") {
+                    closed = true;
+                } else {
+                    // The name of the ring. Holes start with `!`, but as the edges of all rings
+                    // are combined with the even-odd rule, holes do not need to be treated
+                    // differently.
+                    inRing = true;
+                    points.clear();
+                }
+            } else if (line == "END") {
+                if (points.size() < 3) {
+                    const std::string msg = "Ring of polygon ending in line "
+                                            + std::to_string(lineNumber)
+                                            + " has less than three points";
+                    throw RegionException(msg.c_str());
+                }
+
+                if (points.front() != points.back()) {
+                    points.emplace_back(points.front());
+                }
+
+                auto &ring = rings.emplace_back();
+                ring.reserve(points.size() - 1);
+                for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+                    ring.push_back({points[i].first, points[i].second,
+                                    points[i + 1].first, points[i + 1].second});
+                }
+                inRing = false;
+            } else {
+                auto coordinates = line;
+                double lon, lat;
+                if (!readCoordinate(coordinates, " \t", lon) ||
+                    !readCoordinate(coordinates, " \t", lat) || !coordinates.empty()) {
+                    const std::string msg = "Invalid coordinates in line "
+                                            + std::to_string(lineNumber) + " of polygon: "
+                                            + std::string(line);
+                    throw RegionException(msg.c_str());
+                }
+                points.emplace_back(lon, lat);
+            }
+        }
+
+        if (!closed || rings.empty()) {
+            throw RegionException("Polygon has to contain at least one ring and end with END");
+        }
+
+        return Region(std::move(rings));
+    }
+
+    // _____________________________________________________________________________________________
+    Region Region::fromPolygonFile(const std::filesystem::path &path) {
+        std::ifstream file(path);
+        if (!file) {
+            const std::string msg = "Cannot open polygon file: " + path.string();
+            throw RegionException(msg.c_str());
+        }
+
+        std::ostringstream content;
+        content << file.rdbuf();
+        return fromPolygon(content.str());
+    }
+
+    // _____________________________________________________________________________________________
+    Region::Region(std::vector<std::vector<Edge>> rings)
+        : _minLon(std::numeric_limits<double>::max()),
+          _minLat(std::numeric_limits<double>::max()),
+          _maxLon(std::numeric_limits<double>::lowest()),
+          _maxLat(std::numeric_limits<double>::lowest()) {
+        for (auto &ring : rings) {
+            for (const auto &edge : ring) {
+                _minLon = std::min({_minLon, edge.lon1, edge.lon2});
+                _minLat = std::min({_minLat, edge.lat1, edge.lat2});
+                _maxLon = std::max({_maxLon, edge.lon1, edge.lon2});
+                _maxLat = std::max({_maxLat, edge.lat1, edge.lat2});
+            }
+            _edges.insert(_edges.end(), ring.begin(), ring.end());
+        }
+
+        if (!(_minLon < _maxLon) || !(_minLat < _maxLat)) {
+            throw RegionException("Region has to cover an area");
+        }
+
+        const auto numberOfBands = std::clamp(_edges.size() / EDGES_PER_BAND,
+                                              std::size_t{1}, MAX_BANDS);
+        _bandHeight = (_maxLat - _minLat) / static_cast<double>(numberOfBands);
+        _bands.resize(numberOfBands);
+        for (std::size_t i = 0; i < _edges.size(); ++i) {
+            const auto &edge = _edges[i];
+            const auto first = getBand(std::min(edge.lat1, edge.lat2));
+            const auto last = getBand(std::max(edge.lat1, edge.lat2));
+            for (auto band = first; band <= last; ++band) {
+                _bands[band].push_back(i);
+            }
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t Region::getBand(const double lat) const {
+        const auto band = static_cast<std::size_t>((lat - _minLat) / _bandHeight);
+        return std::min(band, _bands.size() - 1);
+    }
+
+    // _____________________________________________________________________________________________
+    bool Region::contains(const osmium::Location &location) const {
+        if (!location.valid()) {
+            return false;
+        }
+
+        const auto lon = location.lon_without_check();
+        const auto lat = location.lat_without_check();
+        if (lon < _minLon || lon > _maxLon || lat < _minLat || lat > _maxLat) {
+            return false;
+        }
+
+        if (_isBox) {
+            return true;
+        }
+
+        // Cast a ray from the location to the east and count the edges it crosses. Only edges
+        // that cross the latitude of the location can be hit, and these are all in its band.
+        bool inside = false;
+        for (const auto i : _bands[getBand(lat)]) {
+            const auto &edge = _edges[i];
+            if ((edge.lat1 > lat) != (edge.lat2 > lat)) {
+                const auto crossing = edge.lon1 + (lat - edge.lat1) * (edge.lon2 - edge.lon1)
+                                                  / (edge.lat2 - edge.lat1);
+                if (lon < crossing) {
+                    inside = !inside;
+                }
+            }
+        }
+
+        return inside;
+    }
+
+} // namespace olu::util
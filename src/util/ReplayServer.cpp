@@ -0,0 +1,244 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ReplayServer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <istream>
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+namespace asio = boost::asio;
+using tcp = boost::asio::ip::tcp;
+
+namespace olu::util {
+
+    // _____________________________________________________________________________________________
+    ReplayServer::ReplayServer(const std::vector<RecordedExchange> &exchanges,
+                               const std::chrono::milliseconds latency,
+                               const unsigned short port) : _latency(latency),
+                                                            _acceptor(_ioContext) {
+        for (const auto &exchange : exchanges) {
+            _responses[exchange.request].responses.emplace_back(exchange.response);
+        }
+
+        try {
+            const tcp::endpoint endpoint(asio::ip::address_v4::loopback(), port);
+            _acceptor.open(endpoint.protocol());
+            _acceptor.set_option(tcp::acceptor::reuse_address(true));
+            _acceptor.bind(endpoint);
+            _acceptor.listen();
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            const std::string msg = "Replay server can not listen on port " + std::to_string(port);
+            throw ReplayServerException(msg.c_str());
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    ReplayServer::~ReplayServer() {
+        stop();
+    }
+
+    // _____________________________________________________________________________________________
+    void ReplayServer::start() {
+        if (_running.exchange(true)) {
+            return;
+        }
+
+        accept();
+        _acceptThread = std::thread([this]() { _ioContext.run(); });
+    }
+
+    // _____________________________________________________________________________________________
+    void ReplayServer::stop() {
+        if (!_running.exchange(false)) {
+            return;
+        }
+
+        asio::post(_ioContext, [this]() {
+            boost::system::error_code ec;
+            _acceptor.close(ec);
+        });
+        _acceptThread.join();
+
+        // Shutting down the sockets wakes up connections that wait for the next request
+        std::unique_lock lock(_mutex);
+        for (const auto &[id, socket] : _connections) {
+            boost::system::error_code ec;
+            socket->shutdown(tcp::socket::shutdown_both, ec);
+        }
+        _connectionClosed.wait(lock, [this]() { return _connections.empty(); });
+    }
+
+    // _____________________________________________________________________________________________
+    unsigned short ReplayServer::getPort() const {
+        return _acceptor.local_endpoint().port();
+    }
+
+    // _____________________________________________________________________________________________
+    std::string ReplayServer::getUri() const {
+        return "http://127.0.0.1:" + std::to_string(getPort()) + "/";
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ReplayServer::getOpenConnections() {
+        std::lock_guard lock(_mutex);
+        return _connections.size();
+    }
+
+    // _____________________________________________________________________________________________
+    void ReplayServer::setStatus(const std::string &status) {
+        std::lock_guard lock(_mutex);
+        _status = status;
+    }
+
+    // _____________________________________________________________________________________________
+    std::string ReplayServer::getResponse(const std::string &requestBody) {
+        // Access tokens are not part of the recording
+        const auto body = requestBody.substr(0, requestBody.find("&access-token="));
+        {
+            std::lock_guard lock(_mutex);
+            if (const auto it = _responses.find(body); it != _responses.end()) {
+                auto &recorded = it->second;
+                const auto &response = recorded.responses[recorded.next];
+                recorded.next = std::min(recorded.next + 1, recorded.responses.size() - 1);
+                return response;
+            }
+        }
+
+        if (body.starts_with("query=")) {
+            return EMPTY_QUERY_RESPONSE;
+        }
+
+        if (body.starts_with("update=")) {
+            return UPDATE_RESPONSE;
+        }
+
+        return "";
+    }
+
+    // _____________________________________________________________________________________________
+    void ReplayServer::accept() {
+        _acceptor.async_accept([this](const boost::system::error_code &ec, tcp::socket socket) {
+            if (ec) {
+                // The acceptor was closed
+                return;
+            }
+
+            auto sharedSocket = std::make_shared<tcp::socket>(std::move(socket));
+            {
+                std::lock_guard lock(_mutex);
+                const auto id = _nextConnection++;
+                _connections.emplace(id, sharedSocket);
+
+                // A client like libcurl can open a new connection for each request, so the thread
+                // and the socket of a connection are released as soon as it is closed instead of
+                // when the server stops
+                std::thread([this, id, connection = std::move(sharedSocket)]() mutable {
+                    handleConnection(connection);
+                    boost::system::error_code closeEc;
+                    connection->close(closeEc);
+                    connection.reset();
+
+                    // The socket is destroyed while the lock is held, so `stop()` can not return
+                    // and destroy the io context before
+                    std::lock_guard connectionLock(_mutex);
+                    _connections.erase(id);
+                    _connectionClosed.notify_all();
+                }).detach();
+            }
+
+            accept();
+        });
+    }
+
+    // _____________________________________________________________________________________________
+    void ReplayServer::handleConnection(const std::shared_ptr<tcp::socket> &socket) {
+        try {
+            // Connections are kept alive until the client closes them, so that libcurl can reuse
+            // them for consecutive requests
+            asio::streambuf buffer;
+            while (true) {
+                boost::system::error_code ec;
+                const auto headerEnd = asio::read_until(*socket, buffer, "\r\n\r\n", ec);
+                if (ec) {
+                    return;
+                }
+
+                std::string header(asio::buffers_begin(buffer.data()),
+                                   asio::buffers_begin(buffer.data()) + headerEnd);
+                buffer.consume(headerEnd);
+
+                std::string lowerHeader = header;
+                std::ranges::transform(lowerHeader, lowerHeader.begin(), [](const unsigned char c) {
+                    return static_cast<char>(std::tolower(c));
+                });
+
+                std::size_t contentLength = 0;
+                if (const auto pos = lowerHeader.find("content-length:");
+                    pos != std::string::npos) {
+                    contentLength = std::stoul(header.substr(pos + 15));
+                }
+
+                if (buffer.size() < contentLength) {
+                    asio::read(*socket, buffer,
+                               asio::transfer_exactly(contentLength - buffer.size()));
+                }
+
+                std::string body(asio::buffers_begin(buffer.data()),
+                                 asio::buffers_begin(buffer.data()) + contentLength);
+                buffer.consume(contentLength);
+
+                const auto response = getResponse(body);
+                std::string status;
+                {
+                    std::lock_guard lock(_mutex);
+                    status = _status;
+                }
+                ++_requestCount;
+
+                if (_latency.count() > 0) {
+                    std::this_thread::sleep_for(_latency);
+                }
+
+                const std::string contentType = response.starts_with("{") ?
+                    "application/json" : "application/sparql-results+xml";
+                std::string message = "HTTP/1.1 " + status + "\r\n"
+                                      "Content-Type: " + contentType + "\r\n"
+                                      "Content-Length: " + std::to_string(response.size()) +
+                                      "\r\n\r\n" + response;
+                asio::write(*socket, asio::buffer(message));
+
+                if (!_running) {
+                    return;
+                }
+            }
+        } catch (std::exception &) {
+            // The client closed the connection while the request was handled
+        }
+    }
+
+} // namespace olu::util
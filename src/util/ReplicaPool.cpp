@@ -0,0 +1,104 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "util/ReplicaPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace olu::util {
+
+    // _____________________________________________________________________________________________
+    ReplicaPool::ReplicaPool(std::vector<std::string> uris)
+        : _uris(std::move(uris)),
+          _outstanding(_uris.size(), 0),
+          _lastSelected(_uris.size(), 0) {
+        _latencies.reserve(LATENCY_WINDOW);
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ReplicaPool::select(const std::optional<std::size_t> exclude) {
+        std::lock_guard lock(_mutex);
+        std::optional<std::size_t> best;
+        for (std::size_t replica = 0; replica < _uris.size(); ++replica) {
+            if (replica == exclude && _uris.size() > 1) {
+                continue;
+            }
+
+            if (!best || _outstanding[replica] < _outstanding[*best] ||
+                (_outstanding[replica] == _outstanding[*best] &&
+                 _lastSelected[replica] < _lastSelected[*best])) {
+                best = replica;
+            }
+        }
+
+        _lastSelected[best.value_or(0)] = ++_selections;
+        return best.value_or(0);
+    }
+
+    // _____________________________________________________________________________________________
+    void ReplicaPool::begin(const std::size_t replica) {
+        std::lock_guard lock(_mutex);
+        ++_outstanding[replica];
+    }
+
+    // _____________________________________________________________________________________________
+    void ReplicaPool::end(const std::size_t replica, const std::optional<double> latency) {
+        std::lock_guard lock(_mutex);
+        if (_outstanding[replica] > 0) {
+            --_outstanding[replica];
+        }
+
+        if (!latency) {
+            return;
+        }
+
+        if (_latencies.size() < LATENCY_WINDOW) {
+            _latencies.push_back(*latency);
+        } else {
+            _latencies[_nextLatency] = *latency;
+        }
+        _nextLatency = (_nextLatency + 1) % LATENCY_WINDOW;
+    }
+
+    // _____________________________________________________________________________________________
+    std::optional<std::chrono::milliseconds> ReplicaPool::getHedgeDelay() const {
+        std::vector<double> latencies;
+        {
+            std::lock_guard lock(_mutex);
+            if (_latencies.size() < MIN_LATENCY_SAMPLES) {
+                return std::nullopt;
+            }
+            latencies = _latencies;
+        }
+
+        const auto percentile = latencies.begin() + static_cast<std::ptrdiff_t>(
+            std::ceil(0.95 * static_cast<double>(latencies.size())) - 1);
+        std::ranges::nth_element(latencies, percentile);
+        return std::chrono::milliseconds(static_cast<long>(std::ceil(*percentile)));
+    }
+
+    // _____________________________________________________________________________________________
+    std::size_t ReplicaPool::getOutstanding(const std::size_t replica) const {
+        std::lock_guard lock(_mutex);
+        return _outstanding[replica];
+    }
+
+} // namespace olu::util
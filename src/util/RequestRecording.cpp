@@ -0,0 +1,87 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/RequestRecording.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace olu::util {
+
+    // _____________________________________________________________________________________________
+    static std::string readBlock(std::ifstream &file, const std::string &marker) {
+        std::string header;
+        if (!std::getline(file, header) || !header.starts_with(marker + " ")) {
+            const std::string msg = "Expected '" + marker + "' block in recording, got: " + header;
+            throw RequestRecordingException(msg.c_str());
+        }
+
+        std::size_t length;
+        try {
+            length = std::stoul(header.substr(marker.size() + 1));
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            const std::string msg = "Invalid block length in recording: " + header;
+            throw RequestRecordingException(msg.c_str());
+        }
+
+        std::string block(length, '\0');
+        file.read(block.data(), static_cast<std::streamsize>(length));
+        // Skip the newline that terminates the block
+        file.ignore(1);
+        if (!file) {
+            throw RequestRecordingException("Unexpected end of recording");
+        }
+
+        return block;
+    }
+
+    // _____________________________________________________________________________________________
+    void RequestRecording::append(const std::filesystem::path &path, const std::string &request,
+                                  const std::string &response) {
+        std::lock_guard lock(_mutex);
+        std::ofstream file(path, std::ios::app | std::ios::binary);
+        if (!file) {
+            const std::string msg = "Can not open recording file: " + path.string();
+            throw RequestRecordingException(msg.c_str());
+        }
+
+        file << "request " << request.size() << "\n" << request << "\n"
+             << "response " << response.size() << "\n" << response << "\n";
+    }
+
+    // _____________________________________________________________________________________________
+    std::vector<RecordedExchange> RequestRecording::load(const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            const std::string msg = "Can not open recording file: " + path.string();
+            throw RequestRecordingException(msg.c_str());
+        }
+
+        std::vector<RecordedExchange> exchanges;
+        while (file.peek() != std::ifstream::traits_type::eof()) {
+            RecordedExchange exchange;
+            exchange.request = readBlock(file, "request");
+            exchange.response = readBlock(file, "response");
+            exchanges.emplace_back(std::move(exchange));
+        }
+
+        return exchanges;
+    }
+
+} // namespace olu::util
@@ -0,0 +1,93 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/RequestTrace.h"
+#include "util/JsonHelper.h"
+
+#include <chrono>
+#include <sstream>
+
+namespace olu::util {
+
+    // _____________________________________________________________________________________________
+    void RequestTrace::open(const std::filesystem::path &path) {
+        std::lock_guard lock(_mutex);
+        if (_file.is_open()) {
+            _file.close();
+        }
+
+        _file.open(path, std::ios::trunc);
+        if (!_file) {
+            const std::string msg = "Can not open request trace file: " + path.string();
+            throw RequestTraceException(msg.c_str());
+        }
+    }
+
+    // _____________________________________________________________________________________________
+    void RequestTrace::close() {
+        std::lock_guard lock(_mutex);
+        _file.close();
+    }
+
+    // _____________________________________________________________________________________________
+    bool RequestTrace::isEnabled() {
+        std::lock_guard lock(_mutex);
+        return _file.is_open();
+    }
+
+    // _____________________________________________________________________________________________
+    void RequestTrace::write(const std::string &kind, const std::size_t batchSize,
+                             const HttpRequest &request, const std::optional<double> serverTime) {
+        if (!isEnabled()) {
+            return;
+        }
+
+        const auto timings = request.getTimings();
+        const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        std::ostringstream oss;
+        oss << "{\"timestamp\":" << timestamp
+            << ",\"kind\":\"" << JsonHelper::escape(kind) << "\""
+            << ",\"batchSize\":" << batchSize
+            << ",\"method\":\"" << (request.getMethod() == POST ? "POST" : "GET") << "\""
+            << ",\"url\":\"" << JsonHelper::escape(request.getUrl()) << "\""
+            << ",\"status\":" << request.getResponseCode()
+            << ",\"requestBytes\":" << request.getRequestSize()
+            << ",\"responseBytes\":" << request.getResponseSize()
+            << ",\"dnsMs\":" << timings.nameLookup
+            << ",\"connectMs\":" << timings.connect
+            << ",\"tlsMs\":" << timings.tls
+            << ",\"ttfbMs\":" << timings.firstByte
+            << ",\"totalMs\":" << timings.total
+            << ",\"serverMs\":";
+        if (serverTime) {
+            oss << *serverTime;
+        } else {
+            oss << "null";
+        }
+        oss << "}\n";
+
+        std::lock_guard lock(_mutex);
+        if (_file.is_open()) {
+            _file << oss.str();
+            _file.flush();
+        }
+    }
+
+} // namespace olu::util
@@ -0,0 +1,170 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/RunReport.h"
+#include "util/Tracepoints.h"
+#include "util/JsonHelper.h"
+
+#include <fstream>
+#include <sstream>
+#include <sys/resource.h>
+
+namespace olu::util {
+
+    // _____________________________________________________________________________________________
+    static double getCpuTime() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+             + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+    // _____________________________________________________________________________________________
+    static long getPeakRss() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        // On linux `ru_maxrss` is already given in kilobytes
+        return usage.ru_maxrss;
+    }
+
+    // _____________________________________________________________________________________________
+    static void writeStats(std::ostream &out, const PhaseStats &stats) {
+        out << "\"wallTime\": " << stats.wallTime
+            << ", \"cpuTime\": " << stats.cpuTime
+            << ", \"peakRssKb\": " << stats.peakRss
+            << ", \"sparqlRequests\": " << stats.sparqlRequests
+            << ", \"bytesSent\": " << stats.bytesSent
+            << ", \"bytesReceived\": " << stats.bytesReceived
+            << ", \"rowsReturned\": " << stats.rowsReturned;
+    }
+
+    // _____________________________________________________________________________________________
+    RunReport::Phase::Phase(std::string name) : _startTime(std::chrono::steady_clock::now()),
+                                                _span(name, "phase") {
+        _start = getTotal();
+        _start.name = std::move(name);
+        OLU_TRACE1(phase_start, _start.name.c_str());
+    }
+
+    // _____________________________________________________________________________________________
+    RunReport::Phase::~Phase() {
+        const auto end = getTotal();
+
+        PhaseStats stats;
+        stats.name = std::move(_start.name);
+        stats.wallTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - _startTime).count();
+        stats.cpuTime = end.cpuTime - _start.cpuTime;
+        stats.peakRss = end.peakRss;
+        stats.sparqlRequests = end.sparqlRequests - _start.sparqlRequests;
+        stats.bytesSent = end.bytesSent - _start.bytesSent;
+        stats.bytesReceived = end.bytesReceived - _start.bytesReceived;
+        stats.rowsReturned = end.rowsReturned - _start.rowsReturned;
+        OLU_TRACE2(phase_end, stats.name.c_str(), static_cast<long>(stats.wallTime * 1000));
+        addPhase(std::move(stats));
+    }
+
+    // _____________________________________________________________________________________________
+    void RunReport::countSparqlRequest() {
+        ++_sparqlRequests;
+    }
+
+    // _____________________________________________________________________________________________
+    void RunReport::countBytes(const std::size_t sent, const std::size_t received) {
+        _bytesSent += sent;
+        _bytesReceived += received;
+    }
+
+    // _____________________________________________________________________________________________
+    void RunReport::countRows(const std::size_t rows) {
+        _rowsReturned += rows;
+    }
+
+    // _____________________________________________________________________________________________
+    void RunReport::setCounter(const std::string &name, const std::size_t value) {
+        std::lock_guard lock(_mutex);
+        _counters[name] = value;
+    }
+
+    // _____________________________________________________________________________________________
+    void RunReport::addPhase(PhaseStats phase) {
+        std::lock_guard lock(_mutex);
+        _phases.emplace_back(std::move(phase));
+    }
+
+    // _____________________________________________________________________________________________
+    std::vector<PhaseStats> RunReport::getPhases() {
+        std::lock_guard lock(_mutex);
+        return _phases;
+    }
+
+    // _____________________________________________________________________________________________
+    PhaseStats RunReport::getTotal() {
+        PhaseStats total;
+        total.name = "total";
+        total.wallTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - _startTime).count();
+        total.cpuTime = getCpuTime();
+        total.peakRss = getPeakRss();
+        total.sparqlRequests = _sparqlRequests;
+        total.bytesSent = _bytesSent;
+        total.bytesReceived = _bytesReceived;
+        total.rowsReturned = _rowsReturned;
+        return total;
+    }
+
+    // _____________________________________________________________________________________________
+    std::string RunReport::toJson() {
+        const auto total = getTotal();
+
+        std::lock_guard lock(_mutex);
+        std::ostringstream oss;
+        oss << "{\n  \"total\": { ";
+        writeStats(oss, total);
+        oss << " },\n  \"phases\": [";
+
+        for (std::size_t i = 0; i < _phases.size(); ++i) {
+            oss << (i == 0 ? "\n" : ",\n");
+            oss << "    { \"name\": \"" << JsonHelper::escape(_phases[i].name) << "\", ";
+            writeStats(oss, _phases[i]);
+            oss << " }";
+        }
+
+        oss << "\n  ],\n  \"counters\": {";
+        std::size_t i = 0;
+        for (const auto &[name, value] : _counters) {
+            oss << (i++ == 0 ? "\n" : ",\n");
+            oss << "    \"" << name << "\": " << value;
+        }
+        oss << "\n  }\n}\n";
+
+        return oss.str();
+    }
+
+    // _____________________________________________________________________________________________
+    void RunReport::write(const std::filesystem::path &path) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            const std::string msg = "Can not write run report to: " + path.string();
+            throw RunReportException(msg.c_str());
+        }
+
+        file << toJson();
+    }
+
+} // namespace olu::util
@@ -6,9 +6,23 @@
 #include "config/Constants.h"
 
 #include <boost/regex.hpp>
+#include <charconv>
+#include <span>
 
 namespace cnst = olu::config::constants;
 namespace olu::util {
+    namespace {
+        // Prefixes that precede the id in the subjects of triples for nodes, ways and relations
+        constexpr std::string_view NODE_SUBJECT_PREFIXES[] = {
+            "osmnode:", "osm_node_", "osm_node_centroid_"
+        };
+        constexpr std::string_view WAY_SUBJECT_PREFIXES[] = {"osmway:", "osm_wayarea_"};
+        constexpr std::string_view RELATION_SUBJECT_PREFIXES[] = {"osmrel:", "osm_relarea_"};
+
+        bool isDigit(const char c) {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+    }
 
     Triple TtlHelper::getTriple(const std::string& triple) {
         const boost::regex regex(R"((\S+)\s(\S+)\s(.*)\s\.)");
@@ -59,25 +73,43 @@ namespace olu::util {
         throw TtlHelperException(msg.c_str());
     }
 
-    id_t TtlHelper::getIdFromSubject(const std::string& subject, const std::string& osmTag) {
-        std::string regexString;
+    id_t TtlHelper::getIdFromSubject(const std::string_view subject, const std::string& osmTag) {
+        std::span<const std::string_view> prefixes;
         if (osmTag == cnst::NODE_TAG) {
-            regexString = R"((?:osmnode:|osm_node_|osm_node_centroid_)(\d+))";
+            prefixes = NODE_SUBJECT_PREFIXES;
         } else if (osmTag == cnst::WAY_TAG) {
-            regexString = R"((?:osmway:|osm_wayarea_)(\d+))";
+            prefixes = WAY_SUBJECT_PREFIXES;
         } else if (osmTag == cnst::RELATION_TAG) {
-            regexString = R"((?:osmrel:|osm_relarea_)(\d+))";
+            prefixes = RELATION_SUBJECT_PREFIXES;
         } else {
             const std::string msg = "Unknown element tag: " + osmTag;
             throw TtlHelperException(msg.c_str());
         }
 
-        const boost::regex integerRegex(regexString);
-        if (boost::smatch match; boost::regex_search(subject, match, integerRegex)) {
-            return stoll(match[1]);
+        // The id follows the first prefix in the subject that is directly followed by a digit
+        std::size_t idStart = std::string_view::npos;
+        for (const auto prefix : prefixes) {
+            for (auto pos = subject.find(prefix); pos != std::string_view::npos && pos < idStart;
+                 pos = subject.find(prefix, pos + 1)) {
+                const auto start = pos + prefix.size();
+                if (start < subject.size() && isDigit(subject[start])) {
+                    idStart = start;
+                    break;
+                }
+            }
+        }
+
+        if (idStart != std::string_view::npos) {
+            id_t id;
+            const auto [ptr, ec] = std::from_chars(subject.data() + idStart,
+                                                   subject.data() + subject.size(), id);
+            if (ec == std::errc()) {
+                return id;
+            }
         }
 
-        const std::string msg = "Cant get id for " + osmTag + " from triple: " + subject;
+        const std::string msg = "Cant get id for " + osmTag + " from triple: "
+                                + std::string(subject);
         throw TtlHelperException(msg.c_str());
     }
-}
\ No newline at end of file
+}
@@ -21,10 +21,17 @@
 
 #include <stdexcept>
 #include <boost/asio/connect.hpp>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
-#include <iomanip>
 #include <boost/regex.hpp>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 const static inline int MIN_SEQ_NUMBER = 0;
 const static inline int MAX_SEQ_NUMBER = 999999999;
 
@@ -71,25 +78,140 @@ std::string URLHelper::formatSequenceNumberForUrl(int &sequenceNumber) {
     return firstSegment + "/" + secondSegment + "/" + thirdSegment;
 }
 
+namespace {
+    // Characters that are kept as they are when url encoding, all others are percent-encoded
+    constexpr std::array<bool, 256> UNRESERVED = [] {
+        std::array<bool, 256> table{};
+        for (int c = '0'; c <= '9'; ++c) { table[c] = true; }
+        for (int c = 'A'; c <= 'Z'; ++c) { table[c] = true; }
+        for (int c = 'a'; c <= 'z'; ++c) { table[c] = true; }
+        table['-'] = true; table['_'] = true; table['.'] = true; table['~'] = true;
+        return table;
+    }();
+
+    constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    bool isUnreserved(const char c) {
+        return UNRESERVED[static_cast<unsigned char>(c)];
+    }
+
+#if defined(__AVX2__)
+    constexpr std::size_t CHUNK_SIZE = 32;
+
+    // Returns true for every byte in [lo, hi]. Bytes >= 0x80 are negative as signed chars and
+    // therefore never in range.
+    __m256i inRange(const __m256i chunk, const char lo, const char hi) {
+        const __m256i lower = _mm256_set1_epi8(static_cast<char>(lo - 1));
+        const __m256i upper = _mm256_set1_epi8(static_cast<char>(hi + 1));
+        return _mm256_and_si256(_mm256_cmpgt_epi8(chunk, lower), _mm256_cmpgt_epi8(upper, chunk));
+    }
+
+    // Returns a mask with bit i set if the i-th byte at `data` has to be percent-encoded
+    uint32_t reservedMask(const char* data) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        const __m256i unreserved = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_or_si256(inRange(chunk, '0', '9'), inRange(chunk, 'A', 'Z')),
+                _mm256_or_si256(inRange(chunk, 'a', 'z'), inRange(chunk, '-', '.'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_')),
+                            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('~'))));
+        return ~static_cast<uint32_t>(_mm256_movemask_epi8(unreserved));
+    }
+#elif defined(__SSE2__)
+    constexpr std::size_t CHUNK_SIZE = 16;
+
+    // Returns true for every byte in [lo, hi]. Bytes >= 0x80 are negative as signed chars and
+    // therefore never in range.
+    __m128i inRange(const __m128i chunk, const char lo, const char hi) {
+        const __m128i lower = _mm_set1_epi8(static_cast<char>(lo - 1));
+        const __m128i upper = _mm_set1_epi8(static_cast<char>(hi + 1));
+        return _mm_and_si128(_mm_cmpgt_epi8(chunk, lower), _mm_cmplt_epi8(chunk, upper));
+    }
+
+    // Returns a mask with bit i set if the i-th byte at `data` has to be percent-encoded
+    uint32_t reservedMask(const char* data) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i unreserved = _mm_or_si128(
+            _mm_or_si128(
+                _mm_or_si128(inRange(chunk, '0', '9'), inRange(chunk, 'A', 'Z')),
+                _mm_or_si128(inRange(chunk, 'a', 'z'), inRange(chunk, '-', '.'))),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')),
+                         _mm_cmpeq_epi8(chunk, _mm_set1_epi8('~'))));
+        return ~static_cast<uint32_t>(_mm_movemask_epi8(unreserved)) & 0xFFFFu;
+    }
+#endif
+
+    // Returns the number of characters in `value` that have to be percent-encoded
+    std::size_t countReservedCharacters(const std::string_view value) {
+        std::size_t count = 0;
+        std::size_t pos = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+        for (; pos + CHUNK_SIZE <= value.size(); pos += CHUNK_SIZE) {
+            count += std::popcount(reservedMask(value.data() + pos));
+        }
+#endif
+        for (; pos < value.size(); ++pos) {
+            count += isUnreserved(value[pos]) ? 0 : 1;
+        }
+        return count;
+    }
+
+    // Writes the character to `out` and returns the position behind it
+    char* encodeCharacter(const char c, char* out) {
+        if (isUnreserved(c)) {
+            *out = c;
+            return out + 1;
+        }
+
+        const auto byte = static_cast<unsigned char>(c);
+        out[0] = '%';
+        out[1] = HEX_DIGITS[byte >> 4];
+        out[2] = HEX_DIGITS[byte & 0x0F];
+        return out + 3;
+    }
+}
+
+// _________________________________________________________________________________________________
+std::string URLHelper::encodeForUrlQuery(const std::string_view value) {
+    std::string encoded;
+    encodeForUrlQuery(value, encoded);
+    return encoded;
+}
+
 // _________________________________________________________________________________________________
-std::string URLHelper::encodeForUrlQuery(const std::string &value) {
-    std::ostringstream escaped;
-    escaped.fill('0');
-    escaped << std::hex;
-
-    for (const char c : value) {
-        // Keep alphanumeric characters and other allowed characters
-        if (isalnum(c) != 0 || c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped << c;
+void URLHelper::encodeForUrlQuery(const std::string_view value, std::string &output) {
+    // The size of the output is known after one pass, so that it is written without reallocation
+    const auto reservedCount = countReservedCharacters(value);
+    if (reservedCount == 0) {
+        output.append(value);
+        return;
+    }
+
+    const auto offset = output.size();
+    output.resize(offset + value.size() + 2 * reservedCount);
+    char* out = output.data() + offset;
+
+    std::size_t pos = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Chunks without reserved characters, like long runs of digits in WKT, are copied at once
+    for (; pos + CHUNK_SIZE <= value.size(); pos += CHUNK_SIZE) {
+        if (reservedMask(value.data() + pos) == 0) {
+            std::memcpy(out, value.data() + pos, CHUNK_SIZE);
+            out += CHUNK_SIZE;
             continue;
         }
-        // Any other characters are percent-encoded
-        escaped << '%' << std::setw(2) << int((unsigned char)c);
-    }
 
-    return escaped.str();
+        for (std::size_t i = pos; i < pos + CHUNK_SIZE; ++i) {
+            out = encodeCharacter(value[i], out);
+        }
+    }
+#endif
+    for (; pos < value.size(); ++pos) {
+        out = encodeCharacter(value[pos], out);
+    }
 }
 
+// _________________________________________________________________________________________________
 bool URLHelper::isValidUri(const std::string &uri) {
     const boost::regex regex(R"(((\w+:\/\/)[-a-zA-Z0-9:@;?&=\/%\+\.\*!'\(\),\$_\{\}\^~\[\]`#|]+))");
     return boost::regex_match (uri, regex);
@@ -0,0 +1,127 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "util/WktHelper.h"
+
+#include <charconv>
+
+namespace olu::util {
+
+namespace {
+    // Parses WKT literals from left to right. All functions return false if the expected token
+    // is not found, in which case the position is undefined.
+    class WktCursor {
+    public:
+        explicit WktCursor(const std::string_view wkt) : _pos(wkt.data()),
+                                                          _end(wkt.data() + wkt.size()) {}
+
+        void skipWhitespace() {
+            while (_pos != _end && (*_pos == ' ' || *_pos == '\t' || *_pos == '\n' ||
+                                    *_pos == '\r')) {
+                ++_pos;
+            }
+        }
+
+        // Matches the given upper case keyword case-insensitively
+        bool consumeKeyword(const std::string_view keyword) {
+            if (static_cast<std::size_t>(_end - _pos) < keyword.size()) {
+                return false;
+            }
+
+            for (const char c : keyword) {
+                if ((*_pos & ~0x20) != c) {
+                    return false;
+                }
+                ++_pos;
+            }
+            return true;
+        }
+
+        bool consume(const char c) {
+            skipWhitespace();
+            if (_pos == _end || *_pos != c) {
+                return false;
+            }
+            ++_pos;
+            return true;
+        }
+
+        // Reads a coordinate pair that is separated by whitespace
+        bool readLocation(osmium::Location &location) {
+            double lon;
+            double lat;
+            skipWhitespace();
+            if (!readNumber(lon)) {
+                return false;
+            }
+
+            // The coordinates have to be separated by at least one whitespace
+            const char* separator = _pos;
+            skipWhitespace();
+            if (_pos == separator || !readNumber(lat)) {
+                return false;
+            }
+
+            location = osmium::Location(lon, lat);
+            return true;
+        }
+
+        [[nodiscard]] bool atEnd() {
+            skipWhitespace();
+            return _pos == _end;
+        }
+
+    private:
+        bool readNumber(double &value) {
+            // from_chars does not accept an explicit plus sign
+            if (_pos != _end && *_pos == '+') {
+                ++_pos;
+            }
+
+            const auto [ptr, ec] = std::from_chars(_pos, _end, value);
+            if (ec != std::errc()) {
+                return false;
+            }
+            _pos = ptr;
+            return true;
+        }
+
+        const char* _pos;
+        const char* _end;
+    };
+}
+
+// _________________________________________________________________________________________________
+bool WktHelper::parsePoint(const std::string_view wkt, osmium::Location &location) {
+    WktCursor cursor(wkt);
+    cursor.skipWhitespace();
+    if (!cursor.consumeKeyword("POINT") || !cursor.consume('(')) {
+        return false;
+    }
+
+    osmium::Location parsed;
+    if (!cursor.readLocation(parsed) || !cursor.consume(')') || !cursor.atEnd()) {
+        return false;
+    }
+
+    location = parsed;
+    return true;
+}
+
+} // namespace olu::util
@@ -21,22 +21,30 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
-#include <boost/regex.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <string>
 #include <iostream>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace pt = boost::property_tree;
 
 // _________________________________________________________________________________________________
-void olu::util::XmlReader::populatePTreeFromString(const std::string &xml, pt::ptree &tree) {
-    std::stringstream ss;
-    ss << xml;
+void olu::util::XmlReader::populatePTreeFromString(const std::string_view xml, pt::ptree &tree) {
+    boost::iostreams::stream<boost::iostreams::array_source> stream(xml.data(), xml.size());
 
     try {
-        read_xml(ss, tree, pt::xml_parser::trim_whitespace);
+        read_xml(stream, tree, pt::xml_parser::trim_whitespace);
     } catch(std::exception &e) {
         std::cout << e.what() << std::endl;
-        std::string msg = "Exception while trying to read the xml: " + xml;
+        std::string msg = "Exception while trying to read the xml: " + std::string(xml);
         throw XmlReaderException(msg.c_str());
     }
 }
@@ -120,86 +128,222 @@ std::vector<std::string> olu::util::XmlReader::readTagOfChildren(
 
 // _________________________________________________________________________________________________
 void olu::util::XmlReader::sanitizeXmlTags(pt::ptree &tree) {
+    std::string encoded;
     for (auto &tag : tree.get_child("")) {
         if (tag.first == "tag") {
-            auto value = tag.second.get<std::string>("<xmlattr>.v");
+            // The value is modified in the tree directly and left untouched if nothing has to be
+            // encoded
+            auto &value = tag.second.get_child("<xmlattr>.v").data();
             if (isXmlEncoded(value)) {
-                value = xmlEncode(value);
+                encoded.clear();
+                xmlEncode(value, encoded);
+                value.assign(encoded);
+            }
+        }
+    }
+}
+
+namespace {
+    // Returns the position of the first character at or after `pos` that has to be encoded for
+    // xml, or the size of the input if there is none. With AVX2 or SSE2, 32 or 16 bytes are
+    // compared against all eight special characters at once.
+    std::size_t findXmlSpecialCharacter(const std::string_view input, std::size_t pos) {
+        const char* data = input.data();
+        const std::size_t size = input.size();
+
+#if defined(__AVX2__)
+        const __m256i amp = _mm256_set1_epi8('&');
+        const __m256i quot = _mm256_set1_epi8('"');
+        const __m256i apos = _mm256_set1_epi8('\'');
+        const __m256i lt = _mm256_set1_epi8('<');
+        const __m256i gt = _mm256_set1_epi8('>');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        for (; pos + 32 <= size; pos += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+            const __m256i match = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, amp), _mm256_cmpeq_epi8(chunk, quot)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, apos), _mm256_cmpeq_epi8(chunk, lt))),
+                _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, gt), _mm256_cmpeq_epi8(chunk, lf)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr), _mm256_cmpeq_epi8(chunk, tab))));
+            if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(match)); mask != 0) {
+                return pos + std::countr_zero(mask);
+            }
+        }
+#elif defined(__SSE2__)
+        const __m128i amp = _mm_set1_epi8('&');
+        const __m128i quot = _mm_set1_epi8('"');
+        const __m128i apos = _mm_set1_epi8('\'');
+        const __m128i lt = _mm_set1_epi8('<');
+        const __m128i gt = _mm_set1_epi8('>');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i tab = _mm_set1_epi8('\t');
+        for (; pos + 16 <= size; pos += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            const __m128i match = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, amp), _mm_cmpeq_epi8(chunk, quot)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, apos), _mm_cmpeq_epi8(chunk, lt))),
+                _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, gt), _mm_cmpeq_epi8(chunk, lf)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, tab))));
+            if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(match)); mask != 0) {
+                return pos + std::countr_zero(mask);
+            }
+        }
+#endif
+
+        // Scalar fallback and the tail of the input
+        for (; pos < size; ++pos) {
+            switch (data[pos]) {
+                case '&': case '"': case '\'': case '<': case '>': case '\n': case '\r': case '\t':
+                    return pos;
+                default:
+                    break;
             }
-            tag.second.put<std::string>("<xmlattr>.v", value);
         }
+        return size;
+    }
+
+    // Returns the position of the next '&' at or after `pos`, or npos. `memchr`, which
+    // `find` uses, is already vectorised by the standard library.
+    std::size_t findAmpersand(const std::string_view input, const std::size_t pos) {
+        return input.find('&', pos);
+    }
+
+    // If an xml entity starts at the beginning of the input, returns its length and the
+    // characters it is decoded to. Otherwise, the length is zero.
+    std::pair<std::size_t, std::string_view> matchXmlEntity(const std::string_view input) {
+        if (input.starts_with("&amp;")) return {5, "&"};
+        if (input.starts_with("&lt;")) return {4, "<"};
+        if (input.starts_with("&gt;")) return {4, ">"};
+        if (input.starts_with("&quot;")) return {6, "\\\""};
+        if (input.starts_with("&apos;")) return {6, "\\'"};
+        if (input.starts_with("&#xA;")) return {5, "\n"};
+        if (input.starts_with("&#xD;")) return {5, "\r"};
+        if (input.starts_with("&#x9;")) return {5, "\t"};
+        return {0, {}};
     }
 }
 
-bool olu::util::XmlReader::isXmlEncoded(const std::string &input) {
-    const boost::regex xmlEntityRegex("&(amp|lt|gt|quot|apos|#xA|#xD|#x9);");
-    return regex_search(input, xmlEntityRegex);
+// _________________________________________________________________________________________________
+bool olu::util::XmlReader::isXmlEncoded(const std::string_view input) {
+    for (auto pos = findAmpersand(input, 0); pos != std::string_view::npos;
+         pos = findAmpersand(input, pos + 1)) {
+        if (matchXmlEntity(input.substr(pos)).first > 0) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
+// _________________________________________________________________________________________________
+std::string olu::util::XmlReader::xmlEncode(const std::string_view input) {
+    std::string output;
+    xmlEncode(input, output);
+    return output;
+}
 
 // _________________________________________________________________________________________________
-std::string olu::util::XmlReader::xmlEncode(const std::string &input) {
-    std::stringstream ss;
-
-    for (const auto c : input) {
-        switch (c) {
-            case '&':  ss << "&amp;";  break;
-            case '\"': ss << "&quot;"; break;
-            case '\'': ss << "&apos;"; break;
-            case '<':  ss << "&lt;";   break;
-            case '>':  ss << "&gt;";   break;
-            case '\n': ss << "&#xA;";  break;
-            case '\r': ss << "&#xD;";  break;
-            case '\t': ss << "&#x9;";  break;
-            default:   ss << c;    break;
+void olu::util::XmlReader::xmlEncode(const std::string_view input, std::string &output) {
+    auto pos = findXmlSpecialCharacter(input, 0);
+    if (pos == input.size()) {
+        output.append(input);
+        return;
+    }
+
+    // Most strings contain only a few special characters
+    output.reserve(output.size() + input.size() + input.size() / 8 + 8);
+    std::size_t prev = 0;
+    while (pos < input.size()) {
+        output.append(input, prev, pos - prev);
+        switch (input[pos]) {
+            case '&':  output.append("&amp;");  break;
+            case '\"': output.append("&quot;"); break;
+            case '\'': output.append("&apos;"); break;
+            case '<':  output.append("&lt;");   break;
+            case '>':  output.append("&gt;");   break;
+            case '\n': output.append("&#xA;");  break;
+            case '\r': output.append("&#xD;");  break;
+            case '\t': output.append("&#x9;");  break;
+            default:   break;
         }
+        prev = pos + 1;
+        pos = findXmlSpecialCharacter(input, prev);
     }
 
-    return ss.str();
+    output.append(input, prev);
 }
 
 // _________________________________________________________________________________________________
-std::string olu::util::XmlReader::xmlDecode(const std::string &input) {
+std::string olu::util::XmlReader::xmlDecode(const std::string_view input) {
     std::string output;
-    std::string::size_type pos = 0, prev_pos = 0;
+    xmlDecode(input, output);
+    return output;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::XmlReader::xmlDecode(const std::string_view input, std::string &output) {
+    auto pos = findAmpersand(input, 0);
+    if (pos == std::string_view::npos) {
+        output.append(input);
+        return;
+    }
 
-    while ((pos = input.find('&', prev_pos)) != std::string::npos) {
-        output.append(input, prev_pos, pos - prev_pos);
+    output.reserve(output.size() + input.size());
+    std::size_t prev = 0;
+    while (pos != std::string_view::npos) {
+        output.append(input, prev, pos - prev);
 
-        if (input.compare(pos, 5, "&amp;") == 0) {
-            output.push_back('&');
-            pos += 5;
-        } else if (input.compare(pos, 4, "&lt;") == 0) {
-            output.push_back('<');
-            pos += 4;
-        } else if (input.compare(pos, 4, "&gt;") == 0) {
-            output.push_back('>');
-            pos += 4;
-        } else if (input.compare(pos, 6, "&quot;") == 0) {
-            output.push_back('\\');
-            output.push_back('\"');
-            pos += 6;
-        } else if (input.compare(pos, 6, "&apos;") == 0) {
-            output.push_back('\\');
-            output.push_back('\'');
-            pos += 6;
-        } else if (input.compare(pos, 5, "&#xA;") == 0) {
-            output.push_back('\n');
-            pos += 5;
-        } else if (input.compare(pos, 5, "&#xD;") == 0) {
-            output.push_back('\r');
-            pos += 5;
-        } else if (input.compare(pos, 5, "&#x9;") == 0) {
-            output.push_back('\t');
-            pos += 5;
+        if (const auto [length, decoded] = matchXmlEntity(input.substr(pos)); length > 0) {
+            output.append(decoded);
+            pos += length;
         } else {
             output.push_back('&');
             pos++;
         }
 
-        prev_pos = pos;
+        prev = pos;
+        pos = findAmpersand(input, prev);
     }
 
-    output.append(input, prev_pos, std::string::npos);
-    return output;
-}
\ No newline at end of file
+    output.append(input, prev);
+}
+
+// _________________________________________________________________________________________________
+void olu::util::XmlReader::xmlDecodeInPlace(std::string &value) {
+    auto pos = findAmpersand(value, 0);
+    if (pos == std::string::npos) {
+        return;
+    }
+
+    // Decoded characters are written to `out`, which never overtakes the read position `pos`
+    std::size_t out = pos;
+    while (pos < value.size()) {
+        if (value[pos] != '&') {
+            const auto next = std::min(findAmpersand(value, pos), value.size());
+            // The text is shifted to the left, so the source and the destination can overlap
+            std::memmove(value.data() + out, value.data() + pos, next - pos);
+            out += next - pos;
+            pos = next;
+            continue;
+        }
+
+        if (const auto [length, decoded] = matchXmlEntity(std::string_view(value).substr(pos));
+            length > 0) {
+            std::ranges::copy(decoded, value.begin() + out);
+            out += decoded.size();
+            pos += length;
+        } else {
+            value[out++] = '&';
+            pos++;
+        }
+    }
+
+    value.resize(out);
+}
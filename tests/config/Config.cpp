@@ -0,0 +1,54 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "config/Config.h"
+#include "gtest/gtest.h"
+
+namespace olu::config {
+    TEST(Config, parseUpdateTarget) {
+        {
+            const auto target = Config::parseUpdateTarget("http://localhost:7001");
+            ASSERT_TRUE(target.has_value());
+            ASSERT_EQ(target->endpointUri, "http://localhost:7001");
+            ASSERT_EQ(target->graphUri, "");
+            ASSERT_EQ(target->accessToken, "");
+        }
+        {
+            const auto target = Config::parseUpdateTarget(
+                "http://localhost:7001,https://example.org/graph,secret");
+            ASSERT_TRUE(target.has_value());
+            ASSERT_EQ(target->endpointUri, "http://localhost:7001");
+            ASSERT_EQ(target->graphUri, "https://example.org/graph");
+            ASSERT_EQ(target->accessToken, "secret");
+        }
+        {
+            // An access token without a graph
+            const auto target = Config::parseUpdateTarget("http://localhost:7001,,secret");
+            ASSERT_TRUE(target.has_value());
+            ASSERT_EQ(target->graphUri, "");
+            ASSERT_EQ(target->accessToken, "secret");
+        }
+        {
+            ASSERT_FALSE(Config::parseUpdateTarget("").has_value());
+            ASSERT_FALSE(Config::parseUpdateTarget("localhost").has_value());
+            ASSERT_FALSE(Config::parseUpdateTarget("http://localhost:7001,graph").has_value());
+            ASSERT_FALSE(Config::parseUpdateTarget("http://a,http://b,c,d").has_value());
+        }
+    }
+}
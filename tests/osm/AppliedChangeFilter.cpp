@@ -0,0 +1,67 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#include "osm/AppliedChangeFilter.h"
+#include "gtest/gtest.h"
+
+#include "ChangeFileReader.h"
+
+#include <string>
+
+namespace olu::osm {
+    TEST(AppliedChangeFilter, skipObjectsWithStoredVersion) {
+        const std::string osc =
+            "<osmChange version=\"0.6\"><modify>"
+            "<node id=\"1\" version=\"3\" lat=\"1\" lon=\"1\"/>"
+            "<node id=\"2\" version=\"3\" lat=\"1\" lon=\"1\"/>"
+            "<node id=\"3\" version=\"3\" lat=\"1\" lon=\"1\"/>"
+            "<node id=\"4\" version=\"3\" lat=\"1\" lon=\"1\"/>"
+            "<way id=\"1\" version=\"2\"><nd ref=\"1\"/></way>"
+            "</modify><delete>"
+            "<node id=\"5\" version=\"4\"/>"
+            "</delete></osmChange>";
+
+        ChangeFileReader reader;
+        const auto changes = reader.read(osc);
+
+        // Node 1 is older, node 2 as new and node 3 newer in the database than in the change
+        // file. Node 4 is not in the database. Way 1 has the same id as node 1 but is older.
+        std::vector<std::pair<osmium::item_type, std::set<id_t>>> lookups;
+        AppliedChangeFilter filter([&lookups](const osmium::item_type type,
+                                              const std::set<id_t> &ids) {
+            lookups.emplace_back(type, ids);
+            if (type == osmium::item_type::way) {
+                return std::map<id_t, std::size_t>{{1, 1}};
+            }
+            return std::map<id_t, std::size_t>{{1, 2}, {2, 3}, {3, 4}, {5, 3}};
+        });
+
+        std::vector<std::string> kept;
+        for (const auto *object : filter.filter(changes)) {
+            kept.push_back(ChangeFileReader::toString(*object));
+        }
+
+        ASSERT_EQ(kept, std::vector<std::string>({"n1", "n4", "w1", "n5"}));
+        ASSERT_EQ(filter.getNumberOfSkippedObjects(), 2);
+        ASSERT_EQ(lookups.size(), 2);
+        ASSERT_EQ(lookups[0].second, std::set<id_t>({1, 2, 3, 4}));
+        ASSERT_EQ(lookups[1].second, std::set<id_t>({1}));
+    }
+}
@@ -0,0 +1,158 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#include "osm/ChangeCompactor.h"
+#include "gtest/gtest.h"
+
+#include "ChangeFileReader.h"
+
+#include <string>
+
+namespace olu::osm {
+    // Reads the versions of an osm change file in the order `mergeChangeFiles` sorts them
+    class ChangeCompactorTest : public ::testing::Test {
+    protected:
+        std::vector<const osmium::OSMObject*> read(const std::string &osc) {
+            return _reader.readSorted(osc);
+        }
+
+        static std::vector<std::string> toStrings(const ChangeCompactor::Result &result) {
+            std::vector<std::string> objects;
+            for (const auto *object : result.objects) {
+                objects.push_back(ChangeFileReader::toString(*object)
+                                  + "v" + std::to_string(object->version()));
+            }
+            return objects;
+        }
+
+        // Node 1 is created and deleted, node 2 created and modified, node 3 modified twice,
+        // node 4 modified and deleted and node 5 only created
+        static inline const std::string NODE_CHANGES =
+            "<osmChange version=\"0.6\">"
+            "<create>"
+            "<node id=\"1\" version=\"1\" lat=\"1\" lon=\"1\"/>"
+            "<node id=\"2\" version=\"1\" lat=\"1\" lon=\"1\"/>"
+            "<node id=\"5\" version=\"1\" lat=\"1\" lon=\"1\"/>"
+            "</create>"
+            "<modify>"
+            "<node id=\"2\" version=\"2\" lat=\"2\" lon=\"2\"/>"
+            "<node id=\"3\" version=\"4\" lat=\"2\" lon=\"2\"/>"
+            "<node id=\"3\" version=\"5\" lat=\"3\" lon=\"3\"/>"
+            "<node id=\"4\" version=\"2\" lat=\"2\" lon=\"2\"/>"
+            "</modify>"
+            "<delete>"
+            "<node id=\"1\" version=\"2\"/>"
+            "<node id=\"4\" version=\"3\"/>"
+            "</delete>"
+            "</osmChange>";
+
+        // The ids that were looked up and a lookup that finds the given ids in the database
+        std::vector<std::set<id_t>> lookups;
+        ChangeCompactor::StoredLookup storedLookup(const std::set<id_t> &storedIds) {
+            return [this, storedIds](osmium::item_type, const std::set<id_t> &ids) {
+                lookups.push_back(ids);
+                std::set<id_t> stored;
+                for (const auto &id : ids) {
+                    if (storedIds.contains(id)) {
+                        stored.insert(id);
+                    }
+                }
+                return stored;
+            };
+        }
+
+    private:
+        ChangeFileReader _reader;
+    };
+
+    TEST_F(ChangeCompactorTest, netEffects) {
+        const auto versions = read(NODE_CHANGES);
+
+        const auto result = ChangeCompactor::compact(versions, storedLookup({}));
+        ASSERT_EQ(toStrings(result), std::vector<std::string>({"n2v2", "n3v5", "n4v3", "n5v1"}));
+        ASSERT_EQ(result.noOps, 1);
+        ASSERT_EQ(result.modifiesToCreates, 1);
+        ASSERT_EQ(result.unconfirmedCreates, 0);
+        // Only the objects that were created and changed again are looked up
+        ASSERT_EQ(lookups, std::vector<std::set<id_t>>({{1, 2}}));
+        ASSERT_EQ(result.created.nodes, std::set<id_t>({2, 5}));
+        ASSERT_TRUE(result.created.ways.empty());
+        ASSERT_TRUE(result.created.contains(osmium::item_type::node, 2));
+        ASSERT_FALSE(result.created.contains(osmium::item_type::way, 2));
+    }
+
+    TEST_F(ChangeCompactorTest, replayedWindow) {
+        // The window was already applied, so the database contains nodes 1 and 2. Node 1 has to
+        // be deleted and the old version of node 2 replaced.
+        const auto versions = read(NODE_CHANGES);
+
+        const auto result = ChangeCompactor::compact(versions, storedLookup({1, 2}));
+        ASSERT_EQ(toStrings(result),
+                  std::vector<std::string>({"n1v2", "n2v2", "n3v5", "n4v3", "n5v1"}));
+        ASSERT_TRUE(result.objects[0]->deleted());
+        ASSERT_EQ(result.noOps, 0);
+        ASSERT_EQ(result.modifiesToCreates, 0);
+        ASSERT_EQ(result.unconfirmedCreates, 2);
+        ASSERT_EQ(result.created.nodes, std::set<id_t>({5}));
+    }
+
+    TEST_F(ChangeCompactorTest, withoutLookup) {
+        // Without a lookup it is unknown whether the window was already applied
+        const auto versions = read(NODE_CHANGES);
+
+        const auto result = ChangeCompactor::compact(versions);
+        ASSERT_EQ(toStrings(result),
+                  std::vector<std::string>({"n1v2", "n2v2", "n3v5", "n4v3", "n5v1"}));
+        ASSERT_EQ(result.noOps, 0);
+        ASSERT_EQ(result.unconfirmedCreates, 2);
+        ASSERT_EQ(result.created.nodes, std::set<id_t>({5}));
+    }
+
+    TEST_F(ChangeCompactorTest, sameIdsOfDifferentTypes) {
+        const auto versions = read(
+            "<osmChange version=\"0.6\">"
+            "<create>"
+            "<node id=\"1\" version=\"1\" lat=\"1\" lon=\"1\"/>"
+            "<way id=\"1\" version=\"1\"><nd ref=\"1\"/></way>"
+            "<relation id=\"1\" version=\"1\"><member type=\"way\" ref=\"1\" role=\"\"/>"
+            "</relation>"
+            "</create>"
+            "<modify>"
+            "<way id=\"1\" version=\"2\"><nd ref=\"1\"/></way>"
+            "</modify>"
+            "<delete>"
+            "<relation id=\"1\" version=\"2\"/>"
+            "</delete>"
+            "</osmChange>");
+
+        const auto result = ChangeCompactor::compact(versions, storedLookup({}));
+        ASSERT_EQ(toStrings(result), std::vector<std::string>({"n1v1", "w1v2"}));
+        ASSERT_EQ(result.created.nodes, std::set<id_t>({1}));
+        ASSERT_EQ(result.created.ways, std::set<id_t>({1}));
+        ASSERT_TRUE(result.created.relations.empty());
+        ASSERT_EQ(result.noOps, 1);
+    }
+
+    TEST_F(ChangeCompactorTest, emptyWindow) {
+        const auto result = ChangeCompactor::compact({});
+        ASSERT_TRUE(result.objects.empty());
+        ASSERT_EQ(result.noOps, 0);
+    }
+}
@@ -0,0 +1,82 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OSM_LIVE_UPDATES_TESTS_CHANGEFILEREADER_H
+#define OSM_LIVE_UPDATES_TESTS_CHANGEFILEREADER_H
+
+#include "osm/ChangeCompactor.h"
+
+#include <string>
+#include <vector>
+#include <osmium/io/reader.hpp>
+#include <osmium/io/xml_input.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/object_pointer_collection.hpp>
+#include <osmium/visitor.hpp>
+
+namespace olu::osm {
+    /**
+     * Reads the objects of osm change files that are given as strings in the tests. The objects
+     * stay valid as long as the reader exists.
+     */
+    class ChangeFileReader {
+    public:
+        /**
+         * @return The objects of the change file in the order of the file
+         */
+        std::vector<const osmium::OSMObject*> read(const std::string &osc) {
+            return readCollection(osc);
+        }
+
+        /**
+         * @return The objects of the change file in the order `OsmUpdater::mergeChangeFiles`
+         * sorts them in
+         */
+        std::vector<const osmium::OSMObject*> readSorted(const std::string &osc) {
+            return readCollection(osc, true);
+        }
+
+        /**
+         * @return The type and id of the object, for example `n1`
+         */
+        static std::string toString(const osmium::OSMObject &object) {
+            return osmium::item_type_to_char(object.type()) + std::to_string(object.id());
+        }
+    private:
+        std::vector<osmium::memory::Buffer> _buffers;
+
+        std::vector<const osmium::OSMObject*> readCollection(const std::string &osc,
+                                                             const bool sorted = false) {
+            osmium::io::Reader reader{osmium::io::File(osc.data(), osc.size(), "osc")};
+            osmium::ObjectPointerCollection objects;
+            while (osmium::memory::Buffer buffer = reader.read()) {
+                osmium::apply(buffer, objects);
+                _buffers.push_back(std::move(buffer));
+            }
+            reader.close();
+
+            if (sorted) {
+                objects.sort(object_order_type_id_reverse_version_delete());
+            }
+            return {objects.ptr_begin(), objects.ptr_end()};
+        }
+    };
+}
+
+#endif //OSM_LIVE_UPDATES_TESTS_CHANGEFILEREADER_H
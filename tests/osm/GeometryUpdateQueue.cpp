@@ -0,0 +1,86 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/GeometryUpdateQueue.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace olu::osm {
+    TEST(GeometryUpdateQueue, saveAndLoad) {
+        const auto path = std::filesystem::temp_directory_path() / "olu_geometry_queue_test.txt";
+        std::filesystem::remove(path);
+
+        {
+            GeometryUpdateQueue queue(path);
+            queue.load();
+            ASSERT_EQ(queue.size(), 0);
+
+            queue.addWays({1, 2, 3});
+            queue.addWays({3, 4});
+            queue.addRelations({5});
+            ASSERT_EQ(queue.size(), 5);
+            queue.save();
+        }
+
+        {
+            GeometryUpdateQueue queue(path);
+            queue.load();
+            ASSERT_EQ(queue.getWays(), std::set<id_t>({1, 2, 3, 4}));
+            ASSERT_EQ(queue.getRelations(), std::set<id_t>({5}));
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    TEST(GeometryUpdateQueue, removeAndDrain) {
+        const auto path = std::filesystem::temp_directory_path() / "olu_geometry_queue_test.txt";
+        std::filesystem::remove(path);
+
+        GeometryUpdateQueue queue(path);
+        queue.load();
+        queue.addWays({1, 2, 3});
+        queue.addRelations({4, 5});
+        queue.removeWays({2, 10});
+        queue.removeRelations({5});
+
+        ASSERT_FALSE(queue.shouldDrain(10, 3600));
+        ASSERT_TRUE(queue.shouldDrain(3, 3600));
+        ASSERT_TRUE(queue.shouldDrain(10, 0));
+
+        std::set<id_t> ways{7};
+        std::set<id_t> relations;
+        queue.drain(ways, relations);
+        ASSERT_EQ(ways, std::set<id_t>({1, 3, 7}));
+        ASSERT_EQ(relations, std::set<id_t>({4}));
+        ASSERT_EQ(queue.size(), 0);
+    }
+
+    TEST(GeometryUpdateQueue, invalidFile) {
+        const auto path = std::filesystem::temp_directory_path() / "olu_geometry_queue_test.txt";
+        {
+            std::ofstream file(path);
+            file << "x 1" << std::endl;
+        }
+
+        GeometryUpdateQueue queue(path);
+        ASSERT_THROW(queue.load(), GeometryUpdateQueueException);
+        std::filesystem::remove(path);
+    }
+}
@@ -21,4 +21,16 @@ namespace olu::osm {
                       "<node id=\"1\" lat=\"42.7957187\" lon=\"13.5690032\"/>");
         }
     }
+
+    TEST(Node, writeNodeXml) {
+        {
+            // Nodes are appended to the buffer and coordinates always have seven decimals
+            std::string xml = "<osm>";
+            Node(1, "POINT(13.5 -42.7957187)").writeXml(xml);
+            Node(2, "POINT(0 0)").writeXml(xml);
+            ASSERT_EQ(xml, "<osm>"
+                           "<node id=\"1\" lat=\"-42.7957187\" lon=\"13.5000000\"/>"
+                           "<node id=\"2\" lat=\"0.0000000\" lon=\"0.0000000\"/>");
+        }
+    }
 }
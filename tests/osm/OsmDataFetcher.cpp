@@ -28,4 +28,44 @@ namespace olu {
 
         ASSERT_ANY_THROW(osmDataFetcher.fetchLatestDatabaseState());
     }
+
+    TEST(OsmDataFetcher, decodeWayMembers) {
+        {
+            const auto members = osm::OsmDataFetcher::decodeWayMembers(
+                "https://www.openstreetmap.org/node/3;https://www.openstreetmap.org/node/1;"
+                "https://www.openstreetmap.org/node/2", "2;0;1");
+            ASSERT_EQ(members, std::vector<id_t>({1, 2, 3}));
+        }
+        {
+            // Only the first node is kept for duplicate positions
+            const auto members = osm::OsmDataFetcher::decodeWayMembers(
+                "https://www.openstreetmap.org/node/1;https://www.openstreetmap.org/node/2;"
+                "https://www.openstreetmap.org/node/1", "0;1;0");
+            ASSERT_EQ(members, std::vector<id_t>({1, 2}));
+        }
+        {
+            ASSERT_TRUE(osm::OsmDataFetcher::decodeWayMembers("", "").empty());
+            ASSERT_THROW(osm::OsmDataFetcher::decodeWayMembers(
+                "https://www.openstreetmap.org/node/1", ""), osm::OsmDataFetcherException);
+            ASSERT_THROW(osm::OsmDataFetcher::decodeWayMembers(
+                "https://www.openstreetmap.org/node/1", "x"), osm::OsmDataFetcherException);
+        }
+    }
+
+    TEST(OsmDataFetcher, decodeRelationMembers) {
+        const auto members = osm::OsmDataFetcher::decodeRelationMembers(
+            "https://www.openstreetmap.org/way/5;https://www.openstreetmap.org/node/1;"
+            "https://www.openstreetmap.org/relation/7",
+            "outer;;subarea", "1;0;2");
+        ASSERT_EQ(members.size(), 3U);
+        ASSERT_EQ(members[0].id, 1);
+        ASSERT_EQ(members[0].type, osm::OsmObjectType::NODE);
+        ASSERT_EQ(members[0].role, "");
+        ASSERT_EQ(members[1].id, 5);
+        ASSERT_EQ(members[1].type, osm::OsmObjectType::WAY);
+        ASSERT_EQ(members[1].role, "outer");
+        ASSERT_EQ(members[2].id, 7);
+        ASSERT_EQ(members[2].type, osm::OsmObjectType::RELATION);
+        ASSERT_EQ(members[2].role, "subarea");
+    }
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#include "osm/RegionClipper.h"
+#include "gtest/gtest.h"
+
+#include "ChangeFileReader.h"
+
+#include <string>
+
+namespace olu::osm {
+    // Reads the objects of an osm change file and clips them to the square from 0 to 10
+    class RegionClipperTest : public ::testing::Test {
+    protected:
+        std::vector<Node> databaseNodes;
+        // Objects that are stored in the database, like `n1`
+        std::set<std::string> storedObjects;
+        std::vector<std::set<id_t>> lookups;
+        std::vector<std::set<id_t>> storedLookups;
+
+        std::vector<std::string> clip(const std::string &osc) {
+            const auto pointers = _reader.read(osc);
+            RegionClipper clipper(_region, [this](const std::set<id_t> &nodeIds) {
+                lookups.push_back(nodeIds);
+                std::vector<Node> nodes;
+                for (const auto &node : databaseNodes) {
+                    if (nodeIds.contains(node.getId())) {
+                        nodes.push_back(node);
+                    }
+                }
+                return nodes;
+            }, [this](const osmium::item_type type, const std::set<id_t> &ids) {
+                storedLookups.push_back(ids);
+                std::set<id_t> stored;
+                for (const auto &id : ids) {
+                    if (storedObjects.contains(osmium::item_type_to_char(type)
+                                               + std::to_string(id))) {
+                        stored.insert(id);
+                    }
+                }
+                return stored;
+            });
+
+            std::vector<std::string> kept;
+            for (const auto *object : clipper.clip(pointers)) {
+                kept.push_back(ChangeFileReader::toString(*object));
+            }
+            return kept;
+        }
+
+    private:
+        util::Region _region = util::Region::fromBbox("0,0,10,10");
+        ChangeFileReader _reader;
+    };
+
+    TEST_F(RegionClipperTest, nodes) {
+        const auto kept = clip(
+            "<osmChange version=\"0.6\"><modify>"
+            "<node id=\"1\" version=\"2\" lat=\"5\" lon=\"5\"/>"
+            "<node id=\"2\" version=\"2\" lat=\"5\" lon=\"15\"/>"
+            "</modify><delete>"
+            "<node id=\"3\" version=\"3\"/>"
+            "</delete></osmChange>");
+
+        ASSERT_EQ(kept, std::vector<std::string>({"n1", "n3"}));
+        ASSERT_TRUE(lookups.empty());
+    }
+
+    TEST_F(RegionClipperTest, waysAndTheirNodes) {
+        // Node 12 lies outside, but is kept because it is a node of way 1, which is inside.
+        // Way 2 references node 20 from the database, which is inside. Way 3 references a node
+        // from the database that is outside and a node that is not in the database.
+        databaseNodes.emplace_back(20, "POINT(3 3)");
+        databaseNodes.emplace_back(30, "POINT(30 30)");
+        const auto kept = clip(
+            "<osmChange version=\"0.6\"><modify>"
+            "<node id=\"11\" version=\"1\" lat=\"5\" lon=\"5\"/>"
+            "<node id=\"12\" version=\"1\" lat=\"5\" lon=\"15\"/>"
+            "<node id=\"13\" version=\"1\" lat=\"5\" lon=\"20\"/>"
+            "<way id=\"1\" version=\"1\"><nd ref=\"11\"/><nd ref=\"12\"/></way>"
+            "<way id=\"2\" version=\"1\"><nd ref=\"13\"/><nd ref=\"20\"/></way>"
+            "<way id=\"3\" version=\"1\"><nd ref=\"30\"/><nd ref=\"31\"/></way>"
+            "</modify></osmChange>");
+
+        ASSERT_EQ(kept, std::vector<std::string>({"n11", "n12", "n13", "w1", "w2"}));
+        ASSERT_EQ(lookups.size(), 1);
+        ASSERT_EQ(lookups[0], std::set<id_t>({20, 30, 31}));
+    }
+
+    TEST_F(RegionClipperTest, relations) {
+        // Relation 1 has a member inside, relation 2 only members outside, relation 3 has a
+        // way member that is not part of the change file and relation 4 is a member of relation
+        // 1. Way 2 is kept because it is a member of relation 1.
+        const auto kept = clip(
+            "<osmChange version=\"0.6\"><modify>"
+            "<node id=\"1\" version=\"1\" lat=\"5\" lon=\"5\"/>"
+            "<node id=\"2\" version=\"1\" lat=\"5\" lon=\"15\"/>"
+            "<node id=\"3\" version=\"1\" lat=\"5\" lon=\"16\"/>"
+            "<way id=\"2\" version=\"1\"><nd ref=\"2\"/><nd ref=\"3\"/></way>"
+            "<relation id=\"1\" version=\"1\">"
+            "<member type=\"node\" ref=\"1\" role=\"\"/>"
+            "<member type=\"way\" ref=\"2\" role=\"\"/>"
+            "<member type=\"relation\" ref=\"4\" role=\"\"/>"
+            "</relation>"
+            "<relation id=\"2\" version=\"1\">"
+            "<member type=\"node\" ref=\"2\" role=\"\"/>"
+            "</relation>"
+            "<relation id=\"3\" version=\"1\">"
+            "<member type=\"way\" ref=\"9\" role=\"\"/>"
+            "</relation>"
+            "<relation id=\"4\" version=\"1\">"
+            "<member type=\"node\" ref=\"3\" role=\"\"/>"
+            "</relation>"
+            "</modify></osmChange>");
+
+        ASSERT_EQ(kept, std::vector<std::string>({"n1", "n2", "n3", "w2", "r1", "r3", "r4"}));
+    }
+
+    TEST_F(RegionClipperTest, movedOutOfRegion) {
+        // Node 1 and way 1 were moved out of the region and are stored. Node 2 and way 2 were
+        // never inside and are not stored. Node 3 is new and can not be stored. Relation 1 only
+        // has members outside and is stored, which keeps relation 2 it is a member of.
+        storedObjects = {"n1", "n3", "w1", "r1"};
+        const auto kept = clip(
+            "<osmChange version=\"0.6\"><modify>"
+            "<node id=\"1\" version=\"2\" lat=\"5\" lon=\"15\"/>"
+            "<node id=\"2\" version=\"3\" lat=\"5\" lon=\"16\"/>"
+            "<node id=\"3\" version=\"1\" lat=\"5\" lon=\"17\"/>"
+            "<node id=\"4\" version=\"2\" lat=\"5\" lon=\"18\"/>"
+            "<way id=\"1\" version=\"4\"><nd ref=\"4\"/><nd ref=\"40\"/></way>"
+            "<way id=\"2\" version=\"2\"><nd ref=\"2\"/><nd ref=\"41\"/></way>"
+            "<relation id=\"1\" version=\"2\">"
+            "<member type=\"node\" ref=\"4\" role=\"\"/>"
+            "</relation>"
+            "<relation id=\"2\" version=\"1\">"
+            "<member type=\"relation\" ref=\"1\" role=\"\"/>"
+            "</relation>"
+            "</modify></osmChange>");
+
+        // Node 4 is kept as a node of way 1 and a member of relation 1
+        ASSERT_EQ(kept, std::vector<std::string>({"n1", "n4", "w1", "r1", "r2"}));
+        ASSERT_EQ(storedLookups, std::vector<std::set<id_t>>({{1, 2, 4}, {1, 2}, {1}}));
+    }
+}
@@ -14,9 +14,9 @@ namespace olu::osm {
 
     TEST(Relation, getRelationXml) { {
             Relation relation(1);
-            relation.addMember({1, "node", "member"});
-            relation.addMember({1, "way", "member"});
-            relation.addMember({1, "relation", "member"});
+            relation.addMember({1, OsmObjectType::NODE, "member"});
+            relation.addMember({1, OsmObjectType::WAY, "member"});
+            relation.addMember({1, OsmObjectType::RELATION, "member"});
             ASSERT_EQ(relation.getXml(),
                       "<relation id=\"1\">"
                       "<member type=\"node\" ref=\"1\" role=\"member\"/>"
@@ -36,9 +36,9 @@ namespace olu::osm {
             );
         } {
             Relation relation(1);
-            relation.addMember({1, "node", "member"});
-            relation.addMember({1, "way", "member"});
-            relation.addMember({1, "relation", "member"});
+            relation.addMember({1, OsmObjectType::NODE, "member"});
+            relation.addMember({1, OsmObjectType::WAY, "member"});
+            relation.addMember({1, OsmObjectType::RELATION, "member"});
             relation.addTag("key", "value");
             ASSERT_EQ(relation.getXml(),
                       "<relation id=\"1\">"
@@ -52,9 +52,9 @@ namespace olu::osm {
         } {
             Relation relation(1);
             relation.setTimestamp("2024-09-19T09:02:41");
-            relation.addMember({1, "node", "member"});
-            relation.addMember({1, "way", "member"});
-            relation.addMember({1, "relation", "member"});
+            relation.addMember({1, OsmObjectType::NODE, "member"});
+            relation.addMember({1, OsmObjectType::WAY, "member"});
+            relation.addMember({1, OsmObjectType::RELATION, "member"});
             relation.addTag("key", "value");
             ASSERT_EQ(relation.getXml(),
                       "<relation id=\"1\" timestamp=\"2024-09-19T09:02:41Z\">"
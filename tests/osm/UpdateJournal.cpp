@@ -0,0 +1,183 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "osm/UpdateJournal.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace olu::osm {
+    namespace {
+        UpdatePlan createPlan() {
+            UpdatePlan plan;
+            plan.deleteBatches.push_back({"osmnode", {-1, 1, 2}});
+            plan.deleteBatches.push_back({"osmway", {3}});
+            plan.insertBatches.push_back(
+                {{"osmnode:1 osmkey:name \"a\\nb\"", "osmway:3 ogc:sfContains [ osm2rdf:a b; ]"},
+                 3});
+            plan.insertBatches.push_back({{"osmnode:2 rdf:type osm:node"}, 4});
+            return plan;
+        }
+    }
+
+    TEST(UpdateJournal, writeAndResumePlan) {
+        const auto dir = std::filesystem::temp_directory_path() / "olu_update_journal_test";
+        std::filesystem::remove_all(dir);
+        const std::vector<std::string> targets{"http://a", "http://b"};
+
+        ASSERT_FALSE(UpdateJournal::hasPendingPlan(dir));
+        {
+            UpdateJournal journal(dir);
+            journal.begin(createPlan(), targets);
+            ASSERT_EQ(journal.getFirstPendingBatch(0), 0);
+        }
+        ASSERT_TRUE(UpdateJournal::hasPendingPlan(dir));
+
+        UpdateJournal journal(dir);
+        const auto plan = journal.resume(targets);
+        ASSERT_EQ(plan.getNumberOfBatches(), 4);
+        ASSERT_EQ(plan.getNumberOfDeletedObjects(), 4);
+        ASSERT_EQ(plan.getNumberOfInsertedTriples(), 4);
+        ASSERT_EQ(plan.deleteBatches[0].osmTag, "osmnode");
+        ASSERT_EQ(plan.deleteBatches[0].ids, std::set<id_t>({-1, 1, 2}));
+        ASSERT_EQ(plan.deleteBatches[1].osmTag, "osmway");
+        ASSERT_EQ(plan.insertBatches[0].triples, createPlan().insertBatches[0].triples);
+        ASSERT_EQ(plan.insertBatches[0].processedTriples, 3);
+        ASSERT_EQ(plan.insertBatches[1].triples,
+                  std::vector<std::string>({"osmnode:2 rdf:type osm:node"}));
+
+        journal.complete();
+        ASSERT_FALSE(UpdateJournal::hasPendingPlan(dir));
+        std::filesystem::remove_all(dir);
+    }
+
+    TEST(UpdateJournal, resumeAfterAcknowledgedBatches) {
+        const auto dir = std::filesystem::temp_directory_path() / "olu_update_journal_test";
+        std::filesystem::remove_all(dir);
+        const std::vector<std::string> targets{"http://a", "http://b"};
+
+        {
+            UpdateJournal journal(dir);
+            journal.begin(createPlan(), targets);
+            journal.acknowledge(0, 0);
+            journal.acknowledge(0, 1);
+            journal.acknowledge(0, 2);
+            journal.acknowledge(1, 0);
+            ASSERT_EQ(journal.getFirstPendingBatch(0), 3);
+        }
+
+        // Simulate a crash while the acknowledgement of a batch was written
+        {
+            std::ofstream file(dir / "acks", std::ios::app);
+            file << "1 1";
+        }
+
+        UpdateJournal journal(dir);
+        std::ignore = journal.resume(targets);
+        ASSERT_EQ(journal.getFirstPendingBatch(0), 3);
+        ASSERT_EQ(journal.getFirstPendingBatch(1), 1);
+        journal.complete();
+        std::filesystem::remove_all(dir);
+    }
+
+    TEST(UpdateJournal, acknowledgeAfterTornLine) {
+        const auto dir = std::filesystem::temp_directory_path() / "olu_update_journal_test";
+        std::filesystem::remove_all(dir);
+        const std::vector<std::string> targets{"http://a", "http://b"};
+
+        {
+            UpdateJournal journal(dir);
+            journal.begin(createPlan(), targets);
+            journal.acknowledge(0, 0);
+        }
+
+        {
+            std::ofstream file(dir / "acks", std::ios::app);
+            file << "0 1";
+        }
+
+        // The acknowledgement must not be appended to the torn line
+        {
+            UpdateJournal journal(dir);
+            std::ignore = journal.resume(targets);
+            ASSERT_EQ(journal.getFirstPendingBatch(0), 1);
+            journal.acknowledge(1, 2);
+        }
+
+        UpdateJournal journal(dir);
+        std::ignore = journal.resume(targets);
+        ASSERT_EQ(journal.getFirstPendingBatch(0), 1);
+        ASSERT_EQ(journal.getFirstPendingBatch(1), 3);
+        std::filesystem::remove_all(dir);
+    }
+
+    TEST(UpdateJournal, invalidAcknowledgements) {
+        const auto dir = std::filesystem::temp_directory_path() / "olu_update_journal_test";
+        const std::vector<std::string> targets{"http://a", "http://b"};
+
+        for (const auto &entry : {"0 11 2\n", "2 0\n", "0 4\n", "0 -1\n", "x\n"}) {
+            std::filesystem::remove_all(dir);
+            {
+                UpdateJournal journal(dir);
+                journal.begin(createPlan(), targets);
+            }
+            {
+                std::ofstream file(dir / "acks", std::ios::app);
+                file << entry;
+            }
+
+            UpdateJournal journal(dir);
+            ASSERT_THROW(std::ignore = journal.resume(targets), UpdateJournalException) << entry;
+        }
+
+        std::filesystem::remove_all(dir);
+    }
+
+    TEST(UpdateJournal, otherTargets) {
+        const auto dir = std::filesystem::temp_directory_path() / "olu_update_journal_test";
+        std::filesystem::remove_all(dir);
+
+        {
+            UpdateJournal journal(dir);
+            journal.begin(createPlan(), {"http://a"});
+        }
+
+        UpdateJournal journal(dir);
+        ASSERT_THROW(std::ignore = journal.resume({"http://b"}), UpdateJournalException);
+        std::filesystem::remove_all(dir);
+    }
+
+    TEST(UpdateJournal, beginReplacesAcknowledgements) {
+        const auto dir = std::filesystem::temp_directory_path() / "olu_update_journal_test";
+        std::filesystem::remove_all(dir);
+
+        {
+            UpdateJournal journal(dir);
+            journal.begin(createPlan(), {"http://a"});
+            journal.acknowledge(0, 0);
+            journal.begin(createPlan(), {"http://a"});
+        }
+
+        UpdateJournal journal(dir);
+        std::ignore = journal.resume({"http://a"});
+        ASSERT_EQ(journal.getFirstPendingBatch(0), 0);
+        std::filesystem::remove_all(dir);
+    }
+}
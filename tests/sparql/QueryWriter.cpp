@@ -186,4 +186,67 @@ namespace olu::sparql {
             );
         }
     }
+    TEST(QueryWriter, writeQueryForVersions) {
+        {
+            QueryWriter qw{config::Config()};
+            std::string query = qw.writeQueryForVersions({1, 2, 3}, "osmway");
+            ASSERT_EQ(
+                    "SELECT ?s ?version WHERE { "
+                    "VALUES ?s { osmway:1 osmway:2 osmway:3 } "
+                    "?s osmmeta:version ?version . }",
+                    query
+            );
+        }
+    }
+
+    TEST(QueryWriter, writeQueriesWithGraph) {
+        {
+            auto config = config::Config();
+            config.graphUri = "http://example.org/g";
+            QueryWriter qw{config};
+
+            ASSERT_EQ(
+                    "INSERT DATA { GRAPH <http://example.org/g> { "
+                    "osmnode:1 osmmeta:version 1 . "
+                    " } }",
+                    qw.writeInsertQuery({"osmnode:1 osmmeta:version 1"})
+            );
+            ASSERT_EQ(
+                    "DELETE { GRAPH <http://example.org/g> { ?s ?p1 ?o1 . ?o1 ?p2 ?o2 .  } } "
+                    "WHERE { VALUES ?s { osmway:1 osmway:2 } "
+                    "GRAPH <http://example.org/g> { ?s ?p1 ?o1 . OPTIONAL { ?o1 ?p2 ?o2. } }  }",
+                    qw.writeDeleteQuery({1, 2}, "osmway")
+            );
+            ASSERT_EQ(
+                    "SELECT ?s FROM <http://example.org/g> WHERE { "
+                    "VALUES ?rel { osmrel:1 osmrel:2 } "
+                    "?s osmrel:member ?o . "
+                    "?o osm2rdfmember:id ?rel . "
+                    "} GROUP BY ?s",
+                    qw.writeQueryForRelationsReferencingRelations({1, 2})
+            );
+            ASSERT_EQ(
+                    "SELECT ?key ?value ?time FROM <http://example.org/g> WHERE { { "
+                    "osmway:1 ?key ?value . "
+                    "FILTER regex(str(?key), \"https://www.openstreetmap.org/wiki/Key:\") } "
+                    "UNION { osmway:1 osmmeta:timestamp ?time } }",
+                    qw.writeQueryForTagsAndTimestamp("osmway:1")
+            );
+        }
+    }
+
+    TEST(QueryWriter, writeQueryForTagsAndTimestamp) {
+        {
+            auto config = config::Config();
+            QueryWriter qw{config};
+
+            ASSERT_EQ(
+                    "SELECT ?key ?value ?time WHERE { { "
+                    "osmrel:1 ?key ?value . "
+                    "FILTER regex(str(?key), \"https://www.openstreetmap.org/wiki/Key:\") } "
+                    "UNION { osmrel:1 osmmeta:timestamp ?time } }",
+                    qw.writeQueryForTagsAndTimestamp("osmrel:1")
+            );
+        }
+    }
 }
@@ -20,6 +20,12 @@
 #include "gtest/gtest.h"
 #include "config/Config.h"
 #include "sparql/SparqlWrapper.h"
+#include "util/ReplayServer.h"
+#include "util/URLHelper.h"
+
+#include <future>
+#include <string>
+#include <vector>
 
 namespace cnst = olu::config::constants;
 
@@ -29,16 +35,85 @@ namespace olu::sparql {
         config.sparqlEndpointUri = "https://qlever.cs.uni-freiburg.de/api/osm-planet";
         auto sparqlWrapper((olu::sparql::SparqlWrapper(config)));
 
-        ASSERT_THROW(sparqlWrapper.runQuery(), olu::sparql::SparqlWrapperException);
+        ASSERT_THROW(sparqlWrapper.runQuery(SparqlRequest{}), olu::sparql::SparqlWrapperException);
     }
 
     TEST(SparqlWrapper, nonEmptyResponseFromEndpoint) {
         auto config((olu::config::Config()));
         config.sparqlEndpointUri = "https://qlever.cs.uni-freiburg.de/api/osm-planet";
         auto sparqlWrapper((olu::sparql::SparqlWrapper(config)));
-        sparqlWrapper.setPrefixes({"PREFIX osmnode: <https://www.openstreetmap.org/node/>"});
-        sparqlWrapper.setQuery("SELECT * WHERE { osmnode:1 ?p ?o }");
+        const std::vector<std::string> prefixes{
+            "PREFIX osmnode: <https://www.openstreetmap.org/node/>"};
+
+        ASSERT_FALSE(sparqlWrapper.runQuery({"SELECT * WHERE { osmnode:1 ?p ?o }", prefixes})
+                .empty());
+    }
+
+    TEST(SparqlWrapper, concurrentRequests) {
+        auto config((olu::config::Config()));
+        config.sparqlEndpointUri = "https://qlever.cs.uni-freiburg.de/api/osm-planet";
+        const auto sparqlWrapper((olu::sparql::SparqlWrapper(config)));
+        const std::vector<std::string> prefixes{
+            "PREFIX osmnode: <https://www.openstreetmap.org/node/>"};
+
+        // Requests that are sent at the same time must not see each others query
+        std::vector<std::future<bool>> results;
+        for (int i = 1; i <= 4; ++i) {
+            results.emplace_back(std::async(std::launch::async, [&sparqlWrapper, &prefixes, i] {
+                const auto query = "SELECT * WHERE { osmnode:" + std::to_string(i) + " ?p ?o }";
+                return !sparqlWrapper.runQuery({query, prefixes, "concurrent", 1}).empty();
+            }));
+        }
+
+        for (auto &result : results) {
+            ASSERT_TRUE(result.get());
+        }
+    }
+
+    TEST(SparqlWrapper, encodedPrefixesMatchTheirList) {
+        const std::string query = "SELECT * WHERE { ?s ?p ?o }";
+        const std::string nodePrefix = "PREFIX osmnode: <https://www.openstreetmap.org/node/>";
+        const std::string wayPrefix = "PREFIX osmway: <https://www.openstreetmap.org/way/>";
+        const std::string oneResult =
+            "<?xml version=\"1.0\"?>"
+            "<sparql xmlns=\"http://www.w3.org/2005/sparql-results#\">"
+            "<head></head><results><result></result></results></sparql>";
+        const std::string twoResults =
+            "<?xml version=\"1.0\"?>"
+            "<sparql xmlns=\"http://www.w3.org/2005/sparql-results#\">"
+            "<head></head><results><result></result><result></result></results></sparql>";
+
+        util::ReplayServer server({
+            {"query=" + util::URLHelper::encodeForUrlQuery(nodePrefix + " " + query), oneResult},
+            {"query=" + util::URLHelper::encodeForUrlQuery(wayPrefix + " " + query), twoResults}});
+        server.start();
+
+        config::Config config;
+        config.sparqlEndpointUri = server.getUri();
+        const SparqlWrapper sparqlWrapper(config);
+
+        // The second request uses the cached encoding of the list
+        std::vector<std::string> prefixes{nodePrefix};
+        for (int i = 0; i < 2; ++i) {
+            const auto response = sparqlWrapper.runQuery({query, prefixes});
+            ASSERT_EQ(response.get_child("sparql.results").size(), 1);
+        }
+
+        // The list keeps its address, but holds a different prefix now
+        prefixes[0] = wayPrefix;
+        const auto response = sparqlWrapper.runQuery({query, prefixes});
+        ASSERT_EQ(response.get_child("sparql.results").size(), 2);
+
+        server.stop();
+    }
 
-        ASSERT_FALSE(sparqlWrapper.runQuery().empty());
+    TEST(SparqlWrapper, getServerTime) {
+        ASSERT_EQ(SparqlWrapper::getServerTime(
+                R"({"status": "OK", "time": {"total": "12ms", "computeResult": "10ms"}})"),
+                  10);
+        ASSERT_EQ(SparqlWrapper::getServerTime(R"({"time": {"total": 25}})"), 25);
+        ASSERT_FALSE(SparqlWrapper::getServerTime(R"({"status": "OK"})").has_value());
+        ASSERT_FALSE(SparqlWrapper::getServerTime("<?xml version=\"1.0\"?><sparql/>").has_value());
+        ASSERT_FALSE(SparqlWrapper::getServerTime("").has_value());
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,116 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ChangeFileGenerator.h"
+#include "util/Decompressor.h"
+#include "util/XmlReader.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <set>
+#include <boost/property_tree/ptree.hpp>
+
+namespace olu::util {
+    TEST(ChangeFileGenerator, generatesRequestedNumberOfObjects) {
+        ChangeFileGenerator generator(1000);
+        const auto content = generator.generate();
+
+        boost::property_tree::ptree tree;
+        XmlReader::populatePTreeFromString(content, tree);
+
+        std::size_t objects = 0;
+        std::set<id_t> modifiedNodes;
+        std::set<id_t> referencedNodes;
+        for (const auto &[changesetTag, changeset] : tree.get_child("osmChange")) {
+            if (changesetTag == "<xmlattr>") { continue; }
+            ASSERT_TRUE(changesetTag == "modify" || changesetTag == "delete");
+
+            for (const auto &[elementTag, element] : changeset) {
+                ++objects;
+                const auto id = element.get<id_t>("<xmlattr>.id");
+                if (changesetTag == "modify" && elementTag == "node") {
+                    modifiedNodes.insert(id);
+                }
+
+                if (elementTag == "way") {
+                    for (const auto &[tag, child] : element) {
+                        if (tag == "nd") {
+                            referencedNodes.insert(child.get<id_t>("<xmlattr>.ref"));
+                        }
+                    }
+                }
+            }
+        }
+
+        // A single edit can add multiple objects, so the number can be slightly larger
+        ASSERT_GE(objects, 1000);
+        ASSERT_LT(objects, 1100);
+
+        // All referenced nodes are contained in the change file
+        for (const auto &nodeId : referencedNodes) {
+            ASSERT_TRUE(modifiedNodes.contains(nodeId));
+        }
+    }
+
+    TEST(ChangeFileGenerator, multipolygonsHaveDistinctMembers) {
+        ChangeFileGenerator generator(2000);
+        const auto content = generator.generate();
+
+        boost::property_tree::ptree tree;
+        XmlReader::populatePTreeFromString(content, tree);
+
+        std::size_t relations = 0;
+        for (const auto &[changesetTag, changeset] : tree.get_child("osmChange")) {
+            if (changesetTag != "modify") { continue; }
+
+            for (const auto &[elementTag, element] : changeset) {
+                if (elementTag != "relation") { continue; }
+
+                ++relations;
+                std::set<id_t> members;
+                for (const auto &[tag, child] : element) {
+                    if (tag == "member") {
+                        ASSERT_TRUE(members.insert(child.get<id_t>("<xmlattr>.ref")).second);
+                    }
+                }
+            }
+        }
+        ASSERT_GT(relations, 0);
+    }
+
+    TEST(ChangeFileGenerator, deterministicForSeed) {
+        ChangeFileGenerator first(500, {}, 7);
+        ChangeFileGenerator second(500, {}, 7);
+        ChangeFileGenerator third(500, {}, 8);
+
+        const auto content = first.generate();
+        ASSERT_EQ(content, second.generate());
+        ASSERT_NE(content, third.generate());
+    }
+
+    TEST(ChangeFileGenerator, writeGzip) {
+        const auto path = std::filesystem::temp_directory_path() / "olu_generated.osc.gz";
+        ChangeFileGenerator generator(100);
+        const auto content = generator.generate();
+
+        ChangeFileGenerator::write(content, path);
+        ASSERT_EQ(Decompressor::readGzip(path), content);
+
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ChromeTrace.h"
+#include "util/RunReport.h"
+#include "gtest/gtest.h"
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <filesystem>
+#include <thread>
+
+namespace olu::util {
+    TEST(ChromeTrace, writeSpansOfAllThreads) {
+        const auto path = std::filesystem::temp_directory_path() / "olu_chrome_trace_test.json";
+
+        ChromeTrace::open(path);
+        {
+            RunReport::Phase phase("parse");
+            ChromeTrace::Span span("writeInsertQuery", "update");
+            span.addArg("batchSize", 1024);
+            span.addArg("url", "http://localhost/\"quoted\"");
+
+            std::thread thread([] { ChromeTrace::Span threadSpan("GET", "http"); });
+            thread.join();
+        }
+        ChromeTrace::close();
+
+        // Spans that end after the trace was closed are not written
+        { ChromeTrace::Span span("ignored", "http"); }
+
+        boost::property_tree::ptree trace;
+        boost::property_tree::read_json(path.string(), trace);
+        std::vector<boost::property_tree::ptree> events;
+        for (const auto &[_, event] : trace) {
+            events.push_back(event);
+        }
+
+        ASSERT_EQ(events.size(), 4);
+        ASSERT_EQ(events[0].get<std::string>("ph"), "M");
+
+        // Spans are written when they end, so the innermost span comes first
+        ASSERT_EQ(events[1].get<std::string>("name"), "GET");
+        ASSERT_EQ(events[2].get<std::string>("name"), "writeInsertQuery");
+        ASSERT_EQ(events[2].get<std::string>("ph"), "X");
+        ASSERT_EQ(events[2].get<int>("args.batchSize"), 1024);
+        ASSERT_EQ(events[2].get<std::string>("args.url"), "http://localhost/\"quoted\"");
+        ASSERT_EQ(events[3].get<std::string>("name"), "parse");
+        ASSERT_EQ(events[3].get<std::string>("cat"), "phase");
+
+        ASSERT_NE(events[1].get<int>("tid"), events[2].get<int>("tid"));
+        ASSERT_EQ(events[2].get<int>("tid"), events[3].get<int>("tid"));
+        ASSERT_LE(events[3].get<long>("ts"), events[2].get<long>("ts"));
+        ASSERT_GE(events[3].get<long>("dur"), events[2].get<long>("dur"));
+
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,37 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/JsonHelper.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace olu::util {
+
+// _________________________________________________________________________________________________
+TEST(JsonHelper, escape) {
+    ASSERT_EQ(JsonHelper::escape(""), "");
+    ASSERT_EQ(JsonHelper::escape("http://localhost:7001/?a=b"), "http://localhost:7001/?a=b");
+    ASSERT_EQ(JsonHelper::escape("a\"b\\c"), "a\\\"b\\\\c");
+    ASSERT_EQ(JsonHelper::escape("\b\f\n\r\t"), "\\b\\f\\n\\r\\t");
+    ASSERT_EQ(JsonHelper::escape(std::string("\0\x01\x1f", 3)), "\\u0000\\u0001\\u001f");
+    // Bytes of multibyte characters are kept
+    ASSERT_EQ(JsonHelper::escape("Stra\xc3\x9f" "e"), "Stra\xc3\x9f" "e");
+}
+
+} // namespace olu::util
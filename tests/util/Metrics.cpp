@@ -0,0 +1,79 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/Metrics.h"
+#include "util/MetricsServer.h"
+#include "util/HttpRequest.h"
+#include "gtest/gtest.h"
+
+namespace olu::util {
+    TEST(Metrics, renderGaugesAndCounters) {
+        Metrics::set(Metrics::STAGE_QUEUE_DEPTH, 5, "stage=\"delete\"");
+        Metrics::add(Metrics::SPARQL_REQUESTS_TOTAL, 2);
+        {
+            Metrics::InFlight inFlight(Metrics::SPARQL_IN_FLIGHT);
+            ASSERT_EQ(Metrics::get(Metrics::SPARQL_IN_FLIGHT), 1);
+        }
+        ASSERT_EQ(Metrics::get(Metrics::SPARQL_IN_FLIGHT), 0);
+
+        const auto text = Metrics::render();
+        ASSERT_NE(text.find("# TYPE olu_stage_queue_depth gauge\n"), std::string::npos);
+        ASSERT_NE(text.find("olu_stage_queue_depth{stage=\"delete\"} 5\n"), std::string::npos);
+        ASSERT_NE(text.find("# TYPE olu_sparql_requests_total counter\n"), std::string::npos);
+        ASSERT_NE(text.find("olu_sparql_requests_total "), std::string::npos);
+    }
+
+    TEST(Metrics, replicationLag) {
+        // Timestamp as it appears in a replication state file
+        Metrics::setReplicationTimestamp(R"(2024-08-02T10\:00\:33Z)");
+        ASSERT_EQ(Metrics::get(Metrics::REPLICATION_TIMESTAMP), 1722592833);
+
+        Metrics::render();
+        ASSERT_GT(Metrics::get(Metrics::REPLICATION_LAG), 0);
+    }
+
+    TEST(Metrics, scrapeEndpoint) {
+        Metrics::set(Metrics::SEQUENCE_NUMBER, 6177383);
+
+        MetricsServer server(0);
+        server.start();
+
+        HttpRequest request(GET, "http://127.0.0.1:" + std::to_string(server.getPort()) + "/metrics");
+        const auto response = request.perform();
+        server.stop();
+
+        ASSERT_EQ(request.getResponseCode(), 200);
+        ASSERT_NE(response.find("olu_sequence_number 6177383\n"), std::string::npos);
+    }
+
+    TEST(Metrics, scrapeWithIdleClient) {
+        MetricsServer server(0);
+        server.start();
+
+        // A client that connects and never sends a request must not block other scrapes
+        boost::asio::io_context ioContext;
+        boost::asio::ip::tcp::socket idleClient(ioContext);
+        idleClient.connect({boost::asio::ip::address_v4::loopback(), server.getPort()});
+
+        HttpRequest request(GET, "http://127.0.0.1:" + std::to_string(server.getPort()) + "/metrics");
+        request.perform();
+        ASSERT_EQ(request.getResponseCode(), 200);
+
+        server.stop();
+    }
+}
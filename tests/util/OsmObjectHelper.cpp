@@ -18,3 +18,38 @@
 
 #include "util/OsmObjectHelper.h"
 #include "gtest/gtest.h"
+
+namespace olu::osm {
+    TEST(OsmObjectHelper, getIdFromUri) {
+        {
+            ASSERT_EQ(OsmObjectHelper::getIdFromUri("https://www.openstreetmap.org/node/1787"),
+                      1787);
+            ASSERT_EQ(OsmObjectHelper::getIdFromUri(
+                          "https://www.openstreetmap.org/relation/9223372036854775807"),
+                      9223372036854775807);
+            ASSERT_EQ(OsmObjectHelper::getIdFromUri("42"), 42);
+        }
+        {
+            ASSERT_THROW(OsmObjectHelper::getIdFromUri("https://www.openstreetmap.org/node/"),
+                         OsmObjectHelperException);
+            ASSERT_THROW(OsmObjectHelper::getIdFromUri(""), OsmObjectHelperException);
+            ASSERT_THROW(OsmObjectHelper::getIdFromUri(
+                             "https://www.openstreetmap.org/node/99999999999999999999"),
+                         OsmObjectHelperException);
+        }
+    }
+
+    TEST(OsmObjectHelper, getIdsFromUris) {
+        boost::property_tree::ptree results;
+        for (const auto *uri : {"https://www.openstreetmap.org/way/1",
+                                "https://www.openstreetmap.org/way/2"}) {
+            boost::property_tree::ptree result;
+            result.put("binding.uri", uri);
+            results.add_child("result", result);
+        }
+
+        std::vector<id_t> ids{5};
+        OsmObjectHelper::getIdsFromUris(results, "binding.uri", ids);
+        ASSERT_EQ(ids, std::vector<id_t>({5, 1, 2}));
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#include "util/Region.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace olu::util {
+    TEST(Region, bbox) {
+        const auto region = Region::fromBbox("7.5,47.9,8.0,48.1");
+        ASSERT_TRUE(region.contains(osmium::Location(7.85, 47.99)));
+        ASSERT_TRUE(region.contains(osmium::Location(7.5, 47.9)));
+        ASSERT_TRUE(region.contains(osmium::Location(8.0, 48.1)));
+        ASSERT_FALSE(region.contains(osmium::Location(8.1, 47.99)));
+        ASSERT_FALSE(region.contains(osmium::Location(7.85, 47.8)));
+        ASSERT_FALSE(region.contains(osmium::Location()));
+
+        ASSERT_NO_THROW(Region::fromBbox(" -10.5, -3e1, +20, 40 "));
+    }
+
+    TEST(Region, invalidBbox) {
+        ASSERT_THROW(Region::fromBbox(""), RegionException);
+        ASSERT_THROW(Region::fromBbox("7.5,47.9,8.0"), RegionException);
+        ASSERT_THROW(Region::fromBbox("7.5,47.9,8.0,48.1,1"), RegionException);
+        ASSERT_THROW(Region::fromBbox("7.5,47.9,a,48.1"), RegionException);
+        ASSERT_THROW(Region::fromBbox("8.0,47.9,7.5,48.1"), RegionException);
+        ASSERT_THROW(Region::fromBbox("7.5,47.9,8.0,91"), RegionException);
+    }
+
+    TEST(Region, polygonWithHole) {
+        // A square from 0 to 10 with a hole from 4 to 6 and a triangle to the east of it
+        const auto region = Region::fromPolygon(
+            "test\n"
+            "outer\n"
+            "   0.0E+00   0.0E+00\n"
+            "   1.0E+01   0.0E+00\n"
+            "   1.0E+01   1.0E+01\n"
+            "   0.0E+00   1.0E+01\n"
+            "   0.0E+00   0.0E+00\n"
+            "END\n"
+            "!hole\n"
+            "   4 4\n"
+            "   6 4\n"
+            "   6 6\n"
+            "   4 6\n"
+            "END\n"
+            "triangle\n"
+            "   20 0\n"
+            "   30 0\n"
+            "   20 10\n"
+            "END\n"
+            "END\n");
+
+        ASSERT_EQ(region.getNumberOfEdges(), 11U);
+        ASSERT_TRUE(region.contains(osmium::Location(1.0, 1.0)));
+        ASSERT_TRUE(region.contains(osmium::Location(9.0, 5.0)));
+        ASSERT_FALSE(region.contains(osmium::Location(5.0, 5.0)));
+        ASSERT_FALSE(region.contains(osmium::Location(15.0, 5.0)));
+        ASSERT_TRUE(region.contains(osmium::Location(21.0, 1.0)));
+        ASSERT_FALSE(region.contains(osmium::Location(29.0, 9.0)));
+        ASSERT_FALSE(region.contains(osmium::Location(5.0, 11.0)));
+    }
+
+    TEST(Region, manyEdges) {
+        // A circle approximated by many edges, so that the edges are spread over many bands
+        std::string polygon = "circle\n1\n";
+        constexpr int numberOfPoints = 10000;
+        for (int i = 0; i < numberOfPoints; ++i) {
+            const double angle = 2 * M_PI * i / numberOfPoints;
+            polygon += std::to_string(10 * std::cos(angle)) + " "
+                       + std::to_string(10 * std::sin(angle)) + "\n";
+        }
+        polygon += "END\nEND\n";
+
+        const auto region = Region::fromPolygon(polygon);
+        ASSERT_EQ(region.getNumberOfEdges(), numberOfPoints);
+        for (double lat = -9.5; lat <= 9.5; lat += 0.5) {
+            const double lon = std::sqrt(100 - lat * lat);
+            ASSERT_TRUE(region.contains(osmium::Location(lon - 0.01, lat)));
+            ASSERT_FALSE(region.contains(osmium::Location(lon + 0.01, lat)));
+            ASSERT_TRUE(region.contains(osmium::Location(0.01 - lon, lat)));
+            ASSERT_FALSE(region.contains(osmium::Location(-0.01 - lon, lat)));
+        }
+        ASSERT_TRUE(region.contains(osmium::Location(7.0, 7.0)));
+        ASSERT_FALSE(region.contains(osmium::Location(7.1, 7.1)));
+    }
+
+    TEST(Region, invalidPolygon) {
+        ASSERT_THROW(Region::fromPolygon(""), RegionException);
+        ASSERT_THROW(Region::fromPolygon("test\nEND\n"), RegionException);
+        ASSERT_THROW(Region::fromPolygon("test\n1\n0 0\n1 1\nEND\nEND\n"), RegionException);
+        ASSERT_THROW(Region::fromPolygon("test\n1\n0 0\n1 0\n1 1\nEND\n"), RegionException);
+        ASSERT_THROW(Region::fromPolygon("test\n1\n0 0\n1 x\n1 1\nEND\nEND\n"),
+                     RegionException);
+    }
+
+    TEST(Region, polygonFile) {
+        const std::filesystem::path path = "/tmp/olu-region-test.poly";
+        {
+            std::ofstream file(path);
+            file << "test\n1\n0 0\n2 0\n0 2\nEND\nEND\n";
+        }
+
+        const auto region = Region::fromPolygonFile(path);
+        ASSERT_TRUE(region.contains(osmium::Location(0.5, 0.5)));
+        ASSERT_FALSE(region.contains(osmium::Location(1.5, 1.5)));
+        std::filesystem::remove(path);
+
+        ASSERT_THROW(Region::fromPolygonFile(path), RegionException);
+    }
+}
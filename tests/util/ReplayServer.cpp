@@ -0,0 +1,143 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ReplayServer.h"
+#include "util/RequestRecording.h"
+#include "util/HttpRequest.h"
+#include "sparql/SparqlWrapper.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace olu::util {
+    TEST(ReplayServer, appendAndLoadRecording) {
+        const auto path = std::filesystem::temp_directory_path() / "olu_recording_test.txt";
+        std::filesystem::remove(path);
+
+        RequestRecording::append(path, "query=a", "response\nwith newline");
+        RequestRecording::append(path, "update=b", "");
+
+        const auto exchanges = RequestRecording::load(path);
+        ASSERT_EQ(exchanges.size(), 2);
+        ASSERT_EQ(exchanges[0].request, "query=a");
+        ASSERT_EQ(exchanges[0].response, "response\nwith newline");
+        ASSERT_EQ(exchanges[1].request, "update=b");
+        ASSERT_EQ(exchanges[1].response, "");
+
+        std::filesystem::remove(path);
+    }
+
+    TEST(ReplayServer, replayRecordedResponses) {
+        ReplayServer server({{"query=a", "first"}, {"query=a", "second"}});
+        server.start();
+
+        auto send = [&server](const std::string &body) {
+            HttpRequest request(POST, server.getUri());
+            request.addHeader("Expect", "");
+            request.addBody(body);
+            return request.perform();
+        };
+
+        ASSERT_EQ(send("query=a"), "first");
+        ASSERT_EQ(send("query=a&access-token=secret"), "second");
+        ASSERT_EQ(send("query=a"), "second");
+        ASSERT_EQ(send("query=unknown"), ReplayServer::EMPTY_QUERY_RESPONSE);
+        ASSERT_EQ(send("update=unknown"), ReplayServer::UPDATE_RESPONSE);
+        ASSERT_EQ(server.getRequestCount(), 5);
+
+        server.stop();
+    }
+
+    TEST(ReplayServer, closedConnectionsAreReleased) {
+        ReplayServer server({});
+        server.start();
+
+        // Each request opens its own connection, which is closed when the request is destroyed
+        for (int i = 0; i < 50; ++i) {
+            HttpRequest request(POST, server.getUri());
+            request.addHeader("Expect", "");
+            request.addBody("query=a");
+            ASSERT_EQ(request.perform(), ReplayServer::EMPTY_QUERY_RESPONSE);
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (server.getOpenConnections() > 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(server.getOpenConnections(), 0);
+        ASSERT_EQ(server.getRequestCount(), 50);
+
+        server.stop();
+    }
+
+    TEST(ReplayServer, streamResponseIntoSink) {
+        const std::string body(100000, 'x');
+        ReplayServer server({RecordedExchange{"query=a", body}});
+        server.start();
+
+        HttpRequest request(POST, server.getUri());
+        request.addHeader("Expect", "");
+        request.addBody("query=a");
+
+        std::string streamed;
+        std::size_t chunks = 0;
+        request.setResponseSink([&streamed, &chunks](const std::string_view chunk) {
+            streamed.append(chunk);
+            ++chunks;
+        });
+
+        ASSERT_EQ(request.perform(), "");
+        ASSERT_EQ(streamed, body);
+        ASSERT_GE(chunks, 1);
+        ASSERT_EQ(request.getResponseSize(), body.size());
+
+        server.stop();
+    }
+
+    TEST(ReplayServer, exceptionInSinkAbortsRequest) {
+        ReplayServer server({RecordedExchange{"query=a", "response"}});
+        server.start();
+
+        HttpRequest request(POST, server.getUri());
+        request.addHeader("Expect", "");
+        request.addBody("query=a");
+        request.setResponseSink([](std::string_view) {
+            throw std::runtime_error("sink failed");
+        });
+
+        ASSERT_THROW(request.perform(), std::runtime_error);
+
+        server.stop();
+    }
+
+    TEST(ReplayServer, sparqlWrapperAgainstReplayServer) {
+        ReplayServer server({});
+        server.start();
+
+        config::Config config;
+        config.sparqlEndpointUri = server.getUri();
+        sparql::SparqlWrapper sparqlWrapper(config);
+        const auto response = sparqlWrapper.runQuery({"SELECT * WHERE { ?s ?p ?o }"});
+        ASSERT_EQ(response.get_child("sparql.results").size(), 0);
+    }
+}
@@ -0,0 +1,180 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "util/ReplicaPool.h"
+#include "util/ReplayServer.h"
+#include "util/HttpRequest.h"
+#include "util/Metrics.h"
+#include "config/Config.h"
+#include "sparql/SparqlWrapper.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+namespace olu::util {
+    TEST(ReplicaPool, selectReplicaWithFewestOutstandingRequests) {
+        ReplicaPool pool({"http://a", "http://b", "http://c"});
+
+        // Without outstanding requests the replicas are chosen in turn
+        ASSERT_EQ(pool.select(), 0);
+        ASSERT_EQ(pool.select(), 1);
+        ASSERT_EQ(pool.select(), 2);
+        ASSERT_EQ(pool.select(), 0);
+
+        pool.begin(0);
+        pool.begin(0);
+        pool.begin(1);
+        ASSERT_EQ(pool.select(), 2);
+        pool.begin(2);
+        ASSERT_EQ(pool.select(), 1);
+        ASSERT_EQ(pool.select(1), 2);
+
+        pool.end(0, std::nullopt);
+        pool.end(0, std::nullopt);
+        ASSERT_EQ(pool.getOutstanding(0), 0);
+        ASSERT_EQ(pool.select(), 0);
+    }
+
+    TEST(ReplicaPool, excludeSingleReplica) {
+        ReplicaPool pool({"http://a"});
+        ASSERT_EQ(pool.select(0), 0);
+    }
+
+    TEST(ReplicaPool, hedgeDelayIs95thPercentile) {
+        ReplicaPool pool({"http://a", "http://b"});
+        for (int i = 1; i < static_cast<int>(ReplicaPool::MIN_LATENCY_SAMPLES); ++i) {
+            pool.begin(0);
+            pool.end(0, i);
+        }
+        ASSERT_FALSE(pool.getHedgeDelay().has_value());
+
+        // Failed requests do not count
+        pool.begin(0);
+        pool.end(0, std::nullopt);
+        ASSERT_FALSE(pool.getHedgeDelay().has_value());
+
+        for (int i = static_cast<int>(ReplicaPool::MIN_LATENCY_SAMPLES); i <= 100; ++i) {
+            pool.begin(1);
+            pool.end(1, i);
+        }
+        ASSERT_EQ(pool.getHedgeDelay(), std::chrono::milliseconds(95));
+    }
+
+    TEST(ReplicaPool, hedgedRequestIsAnsweredByFasterServer) {
+        ReplayServer slow({}, std::chrono::milliseconds(1000));
+        ReplayServer fast({});
+        slow.start();
+        fast.start();
+
+        HttpRequest primary(POST, slow.getUri());
+        primary.addHeader("Expect", "");
+        primary.addBody("query=a");
+        HttpRequest hedge(POST, fast.getUri());
+        hedge.addHeader("Expect", "");
+        hedge.addBody("query=a");
+
+        bool hedged = false;
+        const auto start = std::chrono::steady_clock::now();
+        auto &winner = HttpRequest::performHedged(primary, std::chrono::milliseconds(20),
+            [&hedged, &hedge]() -> HttpRequest& {
+                hedged = true;
+                return hedge;
+            });
+        ASSERT_EQ(&winner, &hedge);
+        ASSERT_TRUE(hedged);
+        ASSERT_EQ(winner.finish(), ReplayServer::EMPTY_QUERY_RESPONSE);
+        ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+        fast.stop();
+        slow.stop();
+    }
+
+    TEST(ReplicaPool, fastRequestIsNotHedged) {
+        ReplayServer server({});
+        ReplayServer unused({});
+        server.start();
+        unused.start();
+
+        HttpRequest primary(POST, server.getUri());
+        primary.addHeader("Expect", "");
+        primary.addBody("query=a");
+        HttpRequest hedge(POST, unused.getUri());
+
+        bool hedged = false;
+        auto &winner = HttpRequest::performHedged(primary, std::chrono::milliseconds(5000),
+            [&hedged, &hedge]() -> HttpRequest& {
+                hedged = true;
+                return hedge;
+            });
+        ASSERT_EQ(&winner, &primary);
+        ASSERT_FALSE(hedged);
+        ASSERT_EQ(winner.finish(), ReplayServer::EMPTY_QUERY_RESPONSE);
+        ASSERT_EQ(unused.getRequestCount(), 0);
+
+        unused.stop();
+        server.stop();
+    }
+
+    TEST(ReplicaPool, errorStatusDoesNotWinWhileHedgeIsRunning) {
+        ReplayServer failing({}, std::chrono::milliseconds(100));
+        ReplayServer slow({}, std::chrono::milliseconds(300));
+        failing.setStatus("503 Service Unavailable");
+        failing.start();
+        slow.start();
+
+        HttpRequest primary(POST, failing.getUri());
+        primary.addHeader("Expect", "");
+        primary.addBody("query=a");
+        HttpRequest hedge(POST, slow.getUri());
+        hedge.addHeader("Expect", "");
+        hedge.addBody("query=a");
+
+        // The primary fails after the hedge was sent, so the hedge decides the result
+        auto &winner = HttpRequest::performHedged(primary, std::chrono::milliseconds(20),
+            [&hedge]() -> HttpRequest& { return hedge; });
+        ASSERT_EQ(&winner, &hedge);
+        ASSERT_EQ(winner.getResponseCode(), 200);
+        ASSERT_EQ(winner.finish(), ReplayServer::EMPTY_QUERY_RESPONSE);
+
+        slow.stop();
+        failing.stop();
+    }
+
+    TEST(ReplicaPool, sparqlWrapperBalancesQueriesAcrossReplicas) {
+        ReplayServer main({});
+        ReplayServer replica({});
+        main.start();
+        replica.start();
+
+        config::Config config;
+        config.sparqlEndpointUri = main.getUri();
+        config.sparqlReadReplicaUris = {replica.getUri()};
+        const sparql::SparqlWrapper sparqlWrapper(config);
+
+        for (int i = 0; i < 4; ++i) {
+            const auto response = sparqlWrapper.runQuery({"SELECT * WHERE { ?s ?p ?o }"});
+            ASSERT_EQ(response.get_child("sparql.results").size(), 0);
+        }
+        ASSERT_EQ(main.getRequestCount(), 2);
+        ASSERT_EQ(replica.getRequestCount(), 2);
+
+        replica.stop();
+        main.stop();
+    }
+}
@@ -0,0 +1,77 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/RunReport.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace olu::util {
+    TEST(RunReport, phaseRecordsCounters) {
+        const auto phasesBefore = RunReport::getPhases().size();
+
+        {
+            RunReport::Phase phase("testPhase");
+            RunReport::countSparqlRequest();
+            RunReport::countSparqlRequest();
+            RunReport::countBytes(100, 2000);
+            RunReport::countRows(42);
+        }
+
+        const auto phases = RunReport::getPhases();
+        ASSERT_EQ(phases.size(), phasesBefore + 1);
+
+        const auto &phase = phases.back();
+        ASSERT_EQ(phase.name, "testPhase");
+        ASSERT_EQ(phase.sparqlRequests, 2);
+        ASSERT_EQ(phase.bytesSent, 100);
+        ASSERT_EQ(phase.bytesReceived, 2000);
+        ASSERT_EQ(phase.rowsReturned, 42);
+        ASSERT_GE(phase.wallTime, 0);
+        ASSERT_GE(phase.cpuTime, 0);
+        ASSERT_GT(phase.peakRss, 0);
+
+        const auto total = RunReport::getTotal();
+        ASSERT_GE(total.sparqlRequests, 2);
+        ASSERT_GE(total.rowsReturned, 42);
+    }
+
+    TEST(RunReport, writeJson) {
+        {
+            RunReport::Phase phase("jsonPhase");
+        }
+        RunReport::setCounter("nodesCreated", 7);
+
+        const auto path = std::filesystem::temp_directory_path() / "olu_run_report_test.json";
+        RunReport::write(path);
+
+        std::ifstream file(path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const auto json = buffer.str();
+
+        ASSERT_NE(json.find("\"total\": {"), std::string::npos);
+        ASSERT_NE(json.find("\"name\": \"jsonPhase\""), std::string::npos);
+        ASSERT_NE(json.find("\"nodesCreated\": 7"), std::string::npos);
+        ASSERT_NE(json.find("\"peakRssKb\""), std::string::npos);
+
+        std::filesystem::remove(path);
+    }
+}
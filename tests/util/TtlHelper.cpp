@@ -0,0 +1,54 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "util/TtlHelper.h"
+#include "config/Constants.h"
+#include "gtest/gtest.h"
+
+namespace cnst = olu::config::constants;
+
+namespace olu::util {
+    TEST(TtlHelper, getIdFromSubject) {
+        {
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osmnode:1787", cnst::NODE_TAG), 1787);
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osm2rdfgeom:osm_node_1787", cnst::NODE_TAG),
+                      1787);
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osm2rdfgeom:osm_node_centroid_1787",
+                                                  cnst::NODE_TAG), 1787);
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osmway:98765432", cnst::WAY_TAG), 98765432);
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osm2rdfgeom:osm_wayarea_98765432",
+                                                  cnst::WAY_TAG), 98765432);
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osmrel:1234567", cnst::RELATION_TAG), 1234567);
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osm2rdfgeom:osm_relarea_1234567",
+                                                  cnst::RELATION_TAG), 1234567);
+        }
+        {
+            // The id ends at the first non digit
+            ASSERT_EQ(TtlHelper::getIdFromSubject("osmway:12_geometry", cnst::WAY_TAG), 12);
+        }
+        {
+            ASSERT_THROW(TtlHelper::getIdFromSubject("osmway:12", cnst::NODE_TAG),
+                         TtlHelperException);
+            ASSERT_THROW(TtlHelper::getIdFromSubject("osmnode:", cnst::NODE_TAG),
+                         TtlHelperException);
+            ASSERT_THROW(TtlHelper::getIdFromSubject("osmnode:1", "changeset"),
+                         TtlHelperException);
+        }
+    }
+}
@@ -20,6 +20,7 @@
 #include "config/Constants.h"
 #include "gtest/gtest.h"
 
+#include <cctype>
 #include <stdexcept>
 
 namespace constants = olu::config::constants;
@@ -76,6 +77,44 @@ TEST(URLHelper, buildUrl) {
     }
 }
 
+// _________________________________________________________________________________________________
+TEST(URLHelper, encodeForUrlQuery) {
+    {
+        ASSERT_EQ(URLHelper::encodeForUrlQuery(""), "");
+        ASSERT_EQ(URLHelper::encodeForUrlQuery("abc-XYZ_019.~"), "abc-XYZ_019.~");
+        ASSERT_EQ(URLHelper::encodeForUrlQuery("a b&c=d"), "a%20b%26c%3dd");
+        ASSERT_EQ(URLHelper::encodeForUrlQuery("\xC3\xA4\n"), "%c3%a4%0a");
+    }
+    {
+        // Longer than one vector, with reserved characters in the chunks and the tail
+        const std::string wkt = "POINT(7.8494005 47.9960901) LINESTRING(7.8494005 47.9960901,"
+                                "7.8494006 47.9960902)";
+        const std::string expected = "POINT%287.8494005%2047.9960901%29%20LINESTRING%287.8494005"
+                                     "%2047.9960901%2c7.8494006%2047.9960902%29";
+        ASSERT_EQ(URLHelper::encodeForUrlQuery(wkt), expected);
+    }
+    {
+        // Every byte value, at every offset relative to the vector width
+        std::string value;
+        std::string expected;
+        for (int i = 0; i < 256; ++i) {
+            const auto c = static_cast<char>(i);
+            value.push_back(c);
+            if (std::isalnum(i) != 0 || c == '-' || c == '_' || c == '.' || c == '~') {
+                expected.push_back(c);
+            } else {
+                constexpr char hex[] = "0123456789abcdef";
+                expected += {'%', hex[i >> 4], hex[i & 0x0F]};
+            }
+        }
+        for (std::size_t offset = 0; offset < 32; ++offset) {
+            const auto prefixLength = URLHelper::encodeForUrlQuery(value.substr(0, offset)).size();
+            std::string output = "query=";
+            URLHelper::encodeForUrlQuery(std::string_view(value).substr(offset), output);
+            ASSERT_EQ(output, "query=" + expected.substr(prefixLength));
+        }
+    }
+}
 
 } // namespace olu::util
 
@@ -0,0 +1,55 @@
+// Copyright 2024, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "util/WktHelper.h"
+#include "gtest/gtest.h"
+
+namespace olu::util {
+
+// _________________________________________________________________________________________________
+TEST(WktHelper, parsePoint) {
+    {
+        osmium::Location location;
+        ASSERT_TRUE(WktHelper::parsePoint("POINT(13.5690032 42.7957187)", location));
+        ASSERT_EQ(location, osmium::Location(13.5690032, 42.7957187));
+    }
+    {
+        osmium::Location location;
+        ASSERT_TRUE(WktHelper::parsePoint(" point ( -13.5690032\t+42.7957187 ) ", location));
+        ASSERT_EQ(location, osmium::Location(-13.5690032, 42.7957187));
+    }
+    {
+        osmium::Location location;
+        ASSERT_TRUE(WktHelper::parsePoint("POINT(1E1 -0.5e-1)", location));
+        ASSERT_EQ(location, osmium::Location(10.0, -0.05));
+    }
+    {
+        osmium::Location location(1.0, 2.0);
+        ASSERT_FALSE(WktHelper::parsePoint("POINT(13.5690032)", location));
+        ASSERT_FALSE(WktHelper::parsePoint("POINT(13.5690032 42.7957187", location));
+        ASSERT_FALSE(WktHelper::parsePoint("POINT(13.5690032,42.7957187)", location));
+        ASSERT_FALSE(WktHelper::parsePoint("POINT(13.5690032 42.7957187) x", location));
+        ASSERT_FALSE(WktHelper::parsePoint("LINESTRING(13.5690032 42.7957187)", location));
+        ASSERT_FALSE(WktHelper::parsePoint("POINT(a b)", location));
+        ASSERT_FALSE(WktHelper::parsePoint("", location));
+        ASSERT_EQ(location, osmium::Location(1.0, 2.0));
+    }
+}
+
+} // namespace olu::util
@@ -88,4 +88,54 @@ TEST(XmlReader, readTagOfChildren) {
 
         tree.clear();
     }
-}
\ No newline at end of file
+}
+TEST(XmlReader, xmlEncode) {
+    {
+        ASSERT_EQ(olu::util::XmlReader::xmlEncode("Zum Löwen"), "Zum Löwen");
+        ASSERT_EQ(olu::util::XmlReader::xmlEncode("a&b\"c'd<e>f\ng\rh\ti"),
+                  "a&amp;b&quot;c&apos;d&lt;e&gt;f&#xA;g&#xD;h&#x9;i");
+    }
+    {
+        // Special characters before, inside and after the blocks that are scanned at once
+        for (const std::size_t length : {15, 16, 17, 31, 32, 33, 64}) {
+            const std::string input = "<" + std::string(length, 'a') + "&" + std::string(length, 'b')
+                                      + ">";
+            ASSERT_EQ(olu::util::XmlReader::xmlEncode(input),
+                      "&lt;" + std::string(length, 'a') + "&amp;" + std::string(length, 'b')
+                      + "&gt;");
+        }
+    }
+    {
+        std::string buffer = "prefix ";
+        olu::util::XmlReader::xmlEncode("<b>", buffer);
+        ASSERT_EQ(buffer, "prefix &lt;b&gt;");
+    }
+}
+
+TEST(XmlReader, xmlDecode) {
+    {
+        ASSERT_EQ(olu::util::XmlReader::xmlDecode("Zum Löwen"), "Zum Löwen");
+        ASSERT_EQ(olu::util::XmlReader::xmlDecode("a&amp;b&quot;c&apos;d&lt;e&gt;f&#xA;g&#xD;h&#x9;i"),
+                  "a&b\\\"c\\'d<e>f\ng\rh\ti");
+        ASSERT_EQ(olu::util::XmlReader::xmlDecode("Tom & Jerry &amp"), "Tom & Jerry &amp");
+    }
+    {
+        std::string value = "&lt;" + std::string(40, 'a') + "&amp;&quot;x &unknown;";
+        olu::util::XmlReader::xmlDecodeInPlace(value);
+        ASSERT_EQ(value, "<" + std::string(40, 'a') + "&\\\"x &unknown;");
+
+        std::string plain = "Zum Löwen";
+        olu::util::XmlReader::xmlDecodeInPlace(plain);
+        ASSERT_EQ(plain, "Zum Löwen");
+    }
+}
+
+TEST(XmlReader, isXmlEncoded) {
+    {
+        ASSERT_TRUE(olu::util::XmlReader::isXmlEncoded("Tom &amp; Jerry"));
+        ASSERT_TRUE(olu::util::XmlReader::isXmlEncoded("& &#x9;"));
+        ASSERT_FALSE(olu::util::XmlReader::isXmlEncoded("Tom & Jerry"));
+        ASSERT_FALSE(olu::util::XmlReader::isXmlEncoded("&amp"));
+        ASSERT_FALSE(olu::util::XmlReader::isXmlEncoded(""));
+    }
+}